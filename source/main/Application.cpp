@@ -40,6 +40,7 @@
 #include "OverlayWrapper.h"
 #include "MumbleIntegration.h"
 #include "Network.h"
+#include "Profiler.h"
 #include "ScriptEngine.h"
 #include "SoundScriptManager.h"
 #include "ThreadPool.h"
@@ -71,6 +72,7 @@ static Network          g_network;
 static GameContext      g_game_context;
 static OutGauge         g_out_gauge;
 static DiscordRpc       g_discord_rpc;
+static Profiler         g_profiler;
 
 // App
 CVar* app_state;
@@ -97,12 +99,17 @@ CVar* app_config_long_names;
  CVar* sim_replay_enabled;
  CVar* sim_replay_length;
  CVar* sim_replay_stepping;
+CVar* sim_replay_spill;
  CVar* sim_realistic_commands;
  CVar* sim_races_enabled;
  CVar* sim_no_collisions;
  CVar* sim_no_self_collisions;
  CVar* sim_gearbox_mode;
  CVar* sim_soft_reset_mode;
+ CVar* sim_collision_cache;
+ CVar* sim_object_paging;
+ CVar* sim_object_page_radius;
+ CVar* sim_object_page_budget;
 
 // Multiplayer
 CVar* mp_state;
@@ -146,6 +153,7 @@ CVar* diag_hide_wheels;
 CVar* diag_hide_nodes;
 CVar* diag_physics_dt;
 CVar* diag_terrn_log_roads;
+CVar* diag_profiler;
 
 // System
 CVar* sys_process_dir;
@@ -226,9 +234,14 @@ CVar* gfx_fps_limit;
 CVar* gfx_speedo_digital;
 CVar* gfx_speedo_imperial;
 CVar* gfx_flexbody_cache;
+CVar* gfx_flexbody_lod;
+CVar* gfx_flexbody_lod_near;
+CVar* gfx_flexbody_lod_far;
+CVar* gfx_flexbody_lod_max_skip;
 CVar* gfx_reduce_shadows;
 CVar* gfx_enable_rtshaders;
 CVar* gfx_classic_shaders;
+CVar* gfx_object_batching;
 
 // Instance management
 void SetSimTerrain     (TerrainManager* obj)          { g_sim_terrain = obj;}
@@ -254,6 +267,7 @@ Network*               GetNetwork            () { return &g_network; }
 GameContext*           GetGameContext        () { return &g_game_context; }
 OutGauge*              GetOutGauge           () { return &g_out_gauge; }
 DiscordRpc*            GetDiscordRpc         () { return &g_discord_rpc; }
+Profiler*              GetProfiler           () { return &g_profiler; }
 
 // Factories
 void CreateOverlayWrapper()
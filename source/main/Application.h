@@ -267,12 +267,17 @@ extern CVar* sim_spawn_running;
 extern CVar* sim_replay_enabled;
 extern CVar* sim_replay_length;
 extern CVar* sim_replay_stepping;
+extern CVar* sim_replay_spill;
 extern CVar* sim_realistic_commands;
 extern CVar* sim_races_enabled;
 extern CVar* sim_no_collisions;
 extern CVar* sim_no_self_collisions;
 extern CVar* sim_gearbox_mode;
 extern CVar* sim_soft_reset_mode;
+extern CVar* sim_collision_cache;
+extern CVar* sim_object_paging;
+extern CVar* sim_object_page_radius;
+extern CVar* sim_object_page_budget;
 
 // Multiplayer
 extern CVar* mp_state;
@@ -317,6 +322,7 @@ extern CVar* diag_hide_wheels;
 extern CVar* diag_hide_nodes;
 extern CVar* diag_physics_dt;
 extern CVar* diag_terrn_log_roads;
+extern CVar* diag_profiler;
 
 // System
 extern CVar* sys_process_dir;
@@ -397,9 +403,14 @@ extern CVar* gfx_fps_limit;
 extern CVar* gfx_speedo_digital;
 extern CVar* gfx_speedo_imperial;
 extern CVar* gfx_flexbody_cache;
+extern CVar* gfx_flexbody_lod;
+extern CVar* gfx_flexbody_lod_near;
+extern CVar* gfx_flexbody_lod_far;
+extern CVar* gfx_flexbody_lod_max_skip;
 extern CVar* gfx_reduce_shadows;
 extern CVar* gfx_enable_rtshaders;
 extern CVar* gfx_classic_shaders;
+extern CVar* gfx_object_batching;
 
 // ------------------------------------------------------------------------------------------------
 // Global objects
@@ -425,6 +436,7 @@ Network*             GetNetwork();
 GameContext*         GetGameContext();
 OutGauge*            GetOutGauge();
 DiscordRpc*          GetDiscordRpc();
+Profiler*            GetProfiler();
 
 // Factories
 void CreateOverlayWrapper();
@@ -83,6 +83,7 @@ namespace RoR
     class  OgreSubsystem;
     struct PlatformUtils;
     class  PointColDetector;
+    class  Profiler;
     struct Prop;
     struct PropAnim;
     class  RailGroup;
@@ -93,6 +94,7 @@ namespace RoR
     class  ScriptEngine;
     class  ShadowManager;
     class  Skidmark;
+    class  SkidmarkBatch;
     class  SkidmarkConfig;
     struct SkinDef;
     class  SkinManager;
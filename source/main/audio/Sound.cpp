@@ -39,37 +39,46 @@ Sound::Sound(ALuint buffer, SoundManager* soundManager, int sourceIndex) :
     , loop(false)
     , should_play(false)
     , hardware_index(-1)
+    , pending_changes(0)
+    , play_state(0)
 {
+    al.gain = gain;
+    al.pitch = pitch;
+    al.loop = loop;
+    al.enabled = enabled;
+    al.should_play = should_play;
+    al.position = position;
+    al.velocity = velocity;
 }
 
 void Sound::computeAudibility(Vector3 pos)
 {
     // disable sound?
-    if (!enabled)
+    if (!al.enabled)
     {
         audibility = 0.0f;
         return;
     }
 
     // first check if the sound is finished!
-    if (!loop && should_play && hardware_index != -1)
+    if (!al.loop && al.should_play && hardware_index != -1)
     {
         int value = 0;
         alGetSourcei((ALuint)sound_manager->getHardwareSource(hardware_index), AL_SOURCE_STATE, &value);
         if (value != AL_PLAYING)
         {
-            should_play = false;
+            al.should_play = false;
         }
     }
 
     // should it play at all?
-    if (!should_play || gain == 0.0f)
+    if (!al.should_play || al.gain == 0.0f)
     {
         audibility = 0.0f;
         return;
     }
 
-    float distance = (pos - position).length();
+    float distance = (pos - al.position).length();
 
     if (distance > sound_manager->MAX_DISTANCE)
     {
@@ -77,23 +86,46 @@ void Sound::computeAudibility(Vector3 pos)
     }
     else if (distance < sound_manager->REFERENCE_DISTANCE)
     {
-        audibility = gain;
+        audibility = al.gain;
     }
     else
     {
-        audibility = gain * (sound_manager->REFERENCE_DISTANCE / (sound_manager->REFERENCE_DISTANCE + (sound_manager->ROLLOFF_FACTOR * (distance - sound_manager->REFERENCE_DISTANCE))));
+        audibility = al.gain * (sound_manager->REFERENCE_DISTANCE / (sound_manager->REFERENCE_DISTANCE + (sound_manager->ROLLOFF_FACTOR * (distance - sound_manager->REFERENCE_DISTANCE))));
+    }
+}
+
+void Sound::queueChange(int reason)
+{
+    // Only the first change since the last update queues the sound; later ones just overwrite the values.
+    if (pending_changes.fetch_or(reason, std::memory_order_acq_rel) == 0)
+    {
+        sound_manager->queueSource(source_index);
     }
 }
 
 bool Sound::isPlaying()
 {
-    if (hardware_index != -1)
+    return (play_state.load(std::memory_order_relaxed) & 1u) != 0;
+}
+
+void Sound::commandPlaying(bool value)
+{
+    // Called after the change was queued, see `publishPlaying()`
+    uint32_t state = play_state.load(std::memory_order_relaxed);
+    while (!play_state.compare_exchange_weak(state, ((state + 2u) & ~1u) | (value ? 1u : 0u), std::memory_order_acq_rel))
     {
-        int value = 0;
-        alGetSourcei((ALuint)sound_manager->getHardwareSource(hardware_index), AL_SOURCE_STATE, &value);
-        return (value == AL_PLAYING);
     }
-    return false;
+}
+
+void Sound::publishPlaying(bool value)
+{
+    // A command counted after `state` was read makes the exchange fail.
+    // A command counted before was queued before that, so it shows in `pending_changes`;
+    // the update which applies it publishes again.
+    uint32_t state = play_state.load(std::memory_order_acquire);
+    if (pending_changes.load(std::memory_order_acquire) != 0)
+        return;
+    play_state.compare_exchange_strong(state, (state & ~1u) | (value ? 1u : 0u), std::memory_order_acq_rel);
 }
 
 void Sound::setEnabled(bool e)
@@ -102,7 +134,8 @@ void Sound::setEnabled(bool e)
         return;
 
     this->enabled = e;
-    sound_manager->recomputeSource(source_index, REASON_PLAY, 0.0f, NULL);
+    cmd_enabled.store(e, std::memory_order_relaxed);
+    this->queueChange(REASON_ENBL);
 }
 
 bool Sound::getEnabled()
@@ -113,13 +146,17 @@ bool Sound::getEnabled()
 void Sound::play()
 {
     should_play = true;
-    sound_manager->recomputeSource(source_index, REASON_PLAY, 0.0f, NULL);
+    cmd_should_play.store(true, std::memory_order_relaxed);
+    this->queueChange(REASON_PLAY);
+    this->commandPlaying(true);
 }
 
 void Sound::stop()
 {
     should_play = false;
-    sound_manager->recomputeSource(source_index, REASON_STOP, 0.0f, NULL);
+    cmd_should_play.store(false, std::memory_order_relaxed);
+    this->queueChange(REASON_PLAY);
+    this->commandPlaying(false);
 }
 
 void Sound::setGain(float gain)
@@ -128,7 +165,8 @@ void Sound::setGain(float gain)
         return;
 
     this->gain = gain;
-    sound_manager->recomputeSource(source_index, REASON_GAIN, gain, NULL);
+    cmd_gain.store(gain, std::memory_order_relaxed);
+    this->queueChange(REASON_GAIN);
 }
 
 void Sound::setLoop(bool loop)
@@ -137,7 +175,8 @@ void Sound::setLoop(bool loop)
         return;
 
     this->loop = loop;
-    sound_manager->recomputeSource(source_index, REASON_LOOP, (loop) ? 1.0f : 0.0f, NULL);
+    cmd_loop.store(loop, std::memory_order_relaxed);
+    this->queueChange(REASON_LOOP);
 }
 
 void Sound::setPitch(float pitch)
@@ -146,7 +185,8 @@ void Sound::setPitch(float pitch)
         return;
 
     this->pitch = pitch;
-    sound_manager->recomputeSource(source_index, REASON_PTCH, pitch, NULL);
+    cmd_pitch.store(pitch, std::memory_order_relaxed);
+    this->queueChange(REASON_PTCH);
 }
 
 void Sound::setPosition(Ogre::Vector3 pos)
@@ -155,7 +195,10 @@ void Sound::setPosition(Ogre::Vector3 pos)
         return;
 
     this->position = pos;
-    sound_manager->recomputeSource(source_index, REASON_POSN, 0.0f, &pos);
+    cmd_position[0].store(pos.x, std::memory_order_relaxed);
+    cmd_position[1].store(pos.y, std::memory_order_relaxed);
+    cmd_position[2].store(pos.z, std::memory_order_relaxed);
+    this->queueChange(REASON_POSN);
 }
 
 void Sound::setVelocity(Ogre::Vector3 vel)
@@ -164,7 +207,10 @@ void Sound::setVelocity(Ogre::Vector3 vel)
         return;
 
     this->velocity = vel;
-    sound_manager->recomputeSource(source_index, REASON_VLCT, 0.0f, &vel);
+    cmd_velocity[0].store(vel.x, std::memory_order_relaxed);
+    cmd_velocity[1].store(vel.y, std::memory_order_relaxed);
+    cmd_velocity[2].store(vel.z, std::memory_order_relaxed);
+    this->queueChange(REASON_VLCT);
 }
 
 #endif // USE_OPENAL
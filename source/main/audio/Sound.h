@@ -24,6 +24,9 @@
 
 #include "Application.h"
 
+#include <atomic>
+#include <cstdint>
+
 #ifdef __APPLE__
 #   include <OpenAL/al.h>
 #else
@@ -32,6 +35,9 @@
 
 namespace RoR {
 
+/// Game-side handle of one sound. Setters don't call OpenAL - they record the new value
+/// and queue the sound for the audio thread (see `SoundManager`), which applies the latest values.
+/// Setters of one sound must not be called from multiple threads at once.
 class Sound : public ZeroedMemoryAllocator
 {
     friend class SoundManager;
@@ -49,36 +55,65 @@ public:
     void stop();
 
     bool getEnabled();
-    bool isPlaying();
+    bool isPlaying(); //!< As of the last audio thread update; `play()`/`stop()` take effect immediately.
 
+    /// Pending changes, bit flags
     enum RecomputeSource
     {
-        REASON_PLAY,
-        REASON_STOP,
-        REASON_GAIN,
-        REASON_LOOP,
-        REASON_PTCH,
-        REASON_POSN,
-        REASON_VLCT
+        REASON_PLAY = BITMASK(1), //!< Play/stop, see `should_play`
+        REASON_GAIN = BITMASK(2),
+        REASON_LOOP = BITMASK(3),
+        REASON_PTCH = BITMASK(4),
+        REASON_POSN = BITMASK(5),
+        REASON_VLCT = BITMASK(6),
+        REASON_ENBL = BITMASK(7)
     };
 
 private:
-    void computeAudibility(Ogre::Vector3 pos);
+    void queueChange(int reason);
+    void commandPlaying(bool value);  //!< Game side of `play()`/`stop()`
+    void publishPlaying(bool value);  //!< Audio thread; loses against `play()`/`stop()` issued meanwhile
 
-    float audibility;
+    // Game-side state, used to skip redundant changes
     float gain;
     float pitch;
     bool loop;
     bool enabled;
     bool should_play;
+    Ogre::Vector3 position;
+    Ogre::Vector3 velocity;
+
+    // Command buffer: latest values, read by the audio thread when `pending_changes` says so.
+    std::atomic<float> cmd_gain;
+    std::atomic<float> cmd_pitch;
+    std::atomic<bool> cmd_loop;
+    std::atomic<bool> cmd_enabled;
+    std::atomic<bool> cmd_should_play;
+    std::atomic<float> cmd_position[3];
+    std::atomic<float> cmd_velocity[3];
+    std::atomic<int> pending_changes; //!< RecomputeSource flags; sound is in the queue while nonzero
+    std::atomic<uint32_t> play_state; //!< Bit 0 = playing, published by the audio thread; the other bits count `play()`/`stop()` calls
+
+    // Audio thread state - mirrors the game-side state as of the last update
+    struct AlState
+    {
+        float gain;
+        float pitch;
+        bool loop;
+        bool enabled;
+        bool should_play;
+        Ogre::Vector3 position;
+        Ogre::Vector3 velocity;
+    };
+    AlState al;
+    void computeAudibility(Ogre::Vector3 pos);
+
+    float audibility;
 
     // this value is changed dynamically, depending on whether the input is played or not.
     int hardware_index;
     ALuint buffer;
 
-    Ogre::Vector3 position;
-    Ogre::Vector3 velocity;
-
     SoundManager* sound_manager;
     // must not be changed during the lifetime of this object
     int source_index;
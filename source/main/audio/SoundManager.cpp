@@ -28,6 +28,9 @@
 
 #include <OgreResourceGroupManager.h>
 
+#include <chrono>
+#include <cstdint>
+
 #define LOGSTREAM Ogre::LogManager::getSingleton().stream() << "[RoR|Audio] "
 
 bool _checkALErrors(const char* filename, int linenum)
@@ -58,7 +61,17 @@ SoundManager::SoundManager() :
     , hardware_sources_num(0)
     , sound_context(NULL)
     , audio_device(NULL)
+    , source_queue_tail(0)
+    , source_queue_head(0)
+    , update_requested(false)
+    , thread_exit(false)
+    , master_volume(1.f)
 {
+    for (size_t i = 0; i < MAX_AUDIO_BUFFERS; i++)
+    {
+        source_queue[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
     if (App::audio_device_name->GetStr() == "")
     {
         LOGSTREAM << "No audio device configured, opening default.";
@@ -120,10 +133,25 @@ SoundManager::SoundManager() :
     {
         hardware_sources_map[i] = -1;
     }
+
+    listener.gain = 1.f;
+    listener.master_volume = App::audio_master_volume->GetFloat();
+    master_volume = listener.master_volume;
+    audio_thread = std::thread(&SoundManager::audioThreadMain, this);
 }
 
 SoundManager::~SoundManager()
 {
+    if (audio_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(thread_mutex);
+            thread_exit = true;
+        }
+        thread_cv.notify_one();
+        audio_thread.join();
+    }
+
     // delete the sources and buffers
     alDeleteSources(MAX_HARDWARE_SOURCES, hardware_sources);
     alDeleteBuffers(MAX_AUDIO_BUFFERS, audio_buffers);
@@ -144,22 +172,131 @@ void SoundManager::setCamera(Ogre::Vector3 position, Ogre::Vector3 direction, Og
 {
     if (!audio_device)
         return;
-    camera_position = position;
-    recomputeAllSources();
-
-    float orientation[6];
-    // direction
-    orientation[0] = direction.x;
-    orientation[1] = direction.y;
-    orientation[2] = direction.z;
-    // up
-    orientation[3] = up.x;
-    orientation[4] = up.y;
-    orientation[5] = up.z;
-
-    alListener3f(AL_POSITION, position.x, position.y, position.z);
-    alListener3f(AL_VELOCITY, velocity.x, velocity.y, velocity.z);
-    alListenerfv(AL_ORIENTATION, orientation);
+
+    std::lock_guard<std::mutex> lock(thread_mutex);
+    listener.position = position;
+    listener.velocity = velocity;
+    listener.direction = direction;
+    listener.up = up;
+    listener.master_volume = App::audio_master_volume->GetFloat();
+    listener.camera_changed = true;
+    this->requestUpdate();
+}
+
+void SoundManager::requestUpdate()
+{
+    update_requested = true;
+    thread_cv.notify_one();
+}
+
+void SoundManager::queueSource(int source_index)
+{
+    // Bounded MPMC queue by Dmitry Vyukov, with a single consumer
+    size_t pos = source_queue_tail.load(std::memory_order_relaxed);
+    SourceQueueSlot* slot = nullptr;
+    for (;;)
+    {
+        slot = &source_queue[pos & (MAX_AUDIO_BUFFERS - 1)];
+        const size_t seq = slot->sequence.load(std::memory_order_acquire);
+        const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0)
+        {
+            if (source_queue_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            // Cannot happen - every source is queued at most once and there are MAX_AUDIO_BUFFERS sources at most.
+            LOGSTREAM << "Sound queue overflow, change of source " << source_index << " lost";
+            return;
+        }
+        else
+        {
+            pos = source_queue_tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->source_index = source_index;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+bool SoundManager::dequeueSource(int& source_index)
+{
+    SourceQueueSlot& slot = source_queue[source_queue_head & (MAX_AUDIO_BUFFERS - 1)];
+    const size_t seq = slot.sequence.load(std::memory_order_acquire);
+    if ((intptr_t)seq - (intptr_t)(source_queue_head + 1) < 0)
+        return false; // Empty
+
+    source_index = slot.source_index;
+    slot.sequence.store(source_queue_head + MAX_AUDIO_BUFFERS, std::memory_order_release);
+    source_queue_head++;
+    return true;
+}
+
+void SoundManager::audioThreadMain()
+{
+    std::unique_lock<std::mutex> lock(thread_mutex);
+    for (;;)
+    {
+        thread_cv.wait_for(lock, std::chrono::milliseconds(UPDATE_TIMEOUT_MS), [this] { return update_requested || thread_exit; });
+        if (thread_exit)
+            break;
+
+        update_requested = false;
+        const ListenerState state = listener;
+        listener.camera_changed = false;
+        listener.gain_changed = false;
+        lock.unlock();
+
+        {
+            std::lock_guard<std::mutex> al_lock(al_mutex);
+
+            master_volume = state.master_volume;
+            if (state.gain_changed)
+            {
+                alListenerf(AL_GAIN, state.gain);
+            }
+            if (state.camera_changed)
+            {
+                camera_position = state.position;
+                recomputeAllSources();
+
+                float orientation[6];
+                // direction
+                orientation[0] = state.direction.x;
+                orientation[1] = state.direction.y;
+                orientation[2] = state.direction.z;
+                // up
+                orientation[3] = state.up.x;
+                orientation[4] = state.up.y;
+                orientation[5] = state.up.z;
+
+                alListener3f(AL_POSITION, state.position.x, state.position.y, state.position.z);
+                alListener3f(AL_VELOCITY, state.velocity.x, state.velocity.y, state.velocity.z);
+                alListenerfv(AL_ORIENTATION, orientation);
+            }
+
+            // Apply the latest values of all changed sources
+            int source_index = -1;
+            while (this->dequeueSource(source_index))
+            {
+                this->recomputeSource(source_index);
+            }
+
+            // Publish the playback state
+            for (int i = 0; i < hardware_sources_num; i++)
+            {
+                if (hardware_sources_map[i] != -1)
+                {
+                    int value = 0;
+                    alGetSourcei(hardware_sources[i], AL_SOURCE_STATE, &value);
+                    audio_sources[hardware_sources_map[i]]->publishPlaying(value == AL_PLAYING);
+                }
+            }
+        }
+
+        lock.lock();
+    }
 }
 
 bool compareByAudibility(std::pair<int, float> a, std::pair<int, float> b)
@@ -210,10 +347,33 @@ void SoundManager::recomputeAllSources()
 #endif
 }
 
-void SoundManager::recomputeSource(int source_index, int reason, float vfl, Vector3* vvec)
+void SoundManager::recomputeSource(int source_index)
 {
     if (!audio_device)
         return;
+
+    // Pick up the latest values; changes made from now on will queue the source again.
+    Sound* sound = audio_sources[source_index];
+    const int reason = sound->pending_changes.exchange(0, std::memory_order_acq_rel);
+    if (reason & Sound::REASON_PLAY)
+        sound->al.should_play = sound->cmd_should_play.load(std::memory_order_relaxed);
+    if (reason & Sound::REASON_ENBL)
+        sound->al.enabled = sound->cmd_enabled.load(std::memory_order_relaxed);
+    if (reason & Sound::REASON_GAIN)
+        sound->al.gain = sound->cmd_gain.load(std::memory_order_relaxed);
+    if (reason & Sound::REASON_LOOP)
+        sound->al.loop = sound->cmd_loop.load(std::memory_order_relaxed);
+    if (reason & Sound::REASON_PTCH)
+        sound->al.pitch = sound->cmd_pitch.load(std::memory_order_relaxed);
+    if (reason & Sound::REASON_POSN)
+        sound->al.position = Vector3(sound->cmd_position[0].load(std::memory_order_relaxed),
+                                     sound->cmd_position[1].load(std::memory_order_relaxed),
+                                     sound->cmd_position[2].load(std::memory_order_relaxed));
+    if (reason & Sound::REASON_VLCT)
+        sound->al.velocity = Vector3(sound->cmd_velocity[0].load(std::memory_order_relaxed),
+                                     sound->cmd_velocity[1].load(std::memory_order_relaxed),
+                                     sound->cmd_velocity[2].load(std::memory_order_relaxed));
+
     audio_sources[source_index]->computeAudibility(camera_position);
 
     if (audio_sources[source_index]->audibility == 0.0f)
@@ -232,23 +392,23 @@ void SoundManager::recomputeSource(int source_index, int reason, float vfl, Vect
             ALuint hw_source = hardware_sources[audio_sources[source_index]->hardware_index];
             // m_audio_sources[source_index] already playing
             // update the AL settings
-            switch (reason)
+            if (reason & Sound::REASON_GAIN)
+                alSourcef(hw_source, AL_GAIN, sound->al.gain * master_volume);
+            if (reason & Sound::REASON_LOOP)
+                alSourcei(hw_source, AL_LOOPING, (sound->al.loop) ? AL_TRUE : AL_FALSE);
+            if (reason & Sound::REASON_PTCH)
+                alSourcef(hw_source, AL_PITCH, sound->al.pitch);
+            if (reason & Sound::REASON_POSN)
+                alSource3f(hw_source, AL_POSITION, sound->al.position.x, sound->al.position.y, sound->al.position.z);
+            if (reason & Sound::REASON_VLCT)
+                alSource3f(hw_source, AL_VELOCITY, sound->al.velocity.x, sound->al.velocity.y, sound->al.velocity.z);
+            if (reason & (Sound::REASON_PLAY | Sound::REASON_ENBL))
             {
-            case Sound::REASON_PLAY: alSourcePlay(hw_source);
-                break;
-            case Sound::REASON_STOP: alSourceStop(hw_source);
-                break;
-            case Sound::REASON_GAIN: alSourcef(hw_source, AL_GAIN, vfl * App::audio_master_volume->GetFloat());
-                break;
-            case Sound::REASON_LOOP: alSourcei(hw_source, AL_LOOPING, (vfl > 0.5) ? AL_TRUE : AL_FALSE);
-                break;
-            case Sound::REASON_PTCH: alSourcef(hw_source, AL_PITCH, vfl);
-                break;
-            case Sound::REASON_POSN: alSource3f(hw_source, AL_POSITION, vvec->x, vvec->y, vvec->z);
-                break;
-            case Sound::REASON_VLCT: alSource3f(hw_source, AL_VELOCITY, vvec->x, vvec->y, vvec->z);
-                break;
-            default: break;
+                // Playing again restarts the sound, like before
+                if (sound->al.should_play)
+                    alSourcePlay(hw_source);
+                else
+                    alSourceStop(hw_source);
             }
         }
         else
@@ -291,6 +451,11 @@ void SoundManager::recomputeSource(int source_index, int reason, float vfl, Vect
             }
         }
     }
+
+    if (sound->hardware_index == -1)
+    {
+        sound->publishPlaying(false);
+    }
 }
 
 void SoundManager::assign(int source_index, int hardware_index)
@@ -305,13 +470,13 @@ void SoundManager::assign(int source_index, int hardware_index)
 
     // the hardware source is supposed to be stopped!
     alSourcei(hw_source, AL_BUFFER, audio_source->buffer);
-    alSourcef(hw_source, AL_GAIN, audio_source->gain * App::audio_master_volume->GetFloat());
-    alSourcei(hw_source, AL_LOOPING, (audio_source->loop) ? AL_TRUE : AL_FALSE);
-    alSourcef(hw_source, AL_PITCH, audio_source->pitch);
-    alSource3f(hw_source, AL_POSITION, audio_source->position.x, audio_source->position.y, audio_source->position.z);
-    alSource3f(hw_source, AL_VELOCITY, audio_source->velocity.x, audio_source->velocity.y, audio_source->velocity.z);
+    alSourcef(hw_source, AL_GAIN, audio_source->al.gain * master_volume);
+    alSourcei(hw_source, AL_LOOPING, (audio_source->al.loop) ? AL_TRUE : AL_FALSE);
+    alSourcef(hw_source, AL_PITCH, audio_source->al.pitch);
+    alSource3f(hw_source, AL_POSITION, audio_source->al.position.x, audio_source->al.position.y, audio_source->al.position.z);
+    alSource3f(hw_source, AL_VELOCITY, audio_source->al.velocity.x, audio_source->al.velocity.y, audio_source->al.velocity.z);
 
-    if (audio_source->should_play)
+    if (audio_source->al.should_play)
     {
         alSourcePlay(hw_source);
     }
@@ -328,6 +493,7 @@ void SoundManager::retire(int source_index)
     alSourceStop(hardware_sources[audio_sources[source_index]->hardware_index]);
     hardware_sources_map[audio_sources[source_index]->hardware_index] = -1;
     audio_sources[source_index]->hardware_index = -1;
+    audio_sources[source_index]->publishPlaying(false);
     hardware_sources_in_use_count--;
 }
 
@@ -335,25 +501,32 @@ void SoundManager::pauseAllSounds()
 {
     if (!audio_device)
         return;
-    // no mutex needed
-    alListenerf(AL_GAIN, 0.0f);
+    std::lock_guard<std::mutex> lock(thread_mutex);
+    listener.gain = 0.0f;
+    listener.gain_changed = true;
+    this->requestUpdate();
 }
 
 void SoundManager::resumeAllSounds()
 {
     if (!audio_device)
         return;
-    // no mutex needed
-    alListenerf(AL_GAIN, App::audio_master_volume->GetFloat());
+    std::lock_guard<std::mutex> lock(thread_mutex);
+    listener.gain = App::audio_master_volume->GetFloat();
+    listener.gain_changed = true;
+    this->requestUpdate();
 }
 
 void SoundManager::setMasterVolume(float v)
 {
     if (!audio_device)
         return;
-    // no mutex needed
     App::audio_master_volume->SetVal(v); // TODO: Use 'pending' mechanism and set externally, only 'apply' here.
-    alListenerf(AL_GAIN, v);
+    std::lock_guard<std::mutex> lock(thread_mutex);
+    listener.gain = v;
+    listener.master_volume = v;
+    listener.gain_changed = true;
+    this->requestUpdate();
 }
 
 Sound* SoundManager::createSound(String filename)
@@ -367,6 +540,8 @@ Sound* SoundManager::createSound(String filename)
         return NULL;
     }
 
+    std::lock_guard<std::mutex> al_lock(al_mutex); // Audio thread must not touch AL meanwhile
+
     ALuint buffer = 0;
 
     // is the file already loaded?
@@ -28,6 +28,11 @@
 #include <OgreVector3.h>
 #include <OgreString.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #ifdef __APPLE__
   #include <OpenAL/al.h>
   #include <OpenAL/alc.h>
@@ -38,6 +43,9 @@
 
 namespace RoR {
 
+/// Owns the OpenAL device, buffers and hardware sources.
+/// All source and listener calls are made by a dedicated audio thread: sounds queue their changes
+/// (see `Sound`), the thread applies the latest values once per update - requested every frame by `setCamera()`.
 class SoundManager : public ZeroedMemoryAllocator
 {
     friend class Sound;
@@ -61,11 +69,19 @@ public:
     static const float ROLLOFF_FACTOR;
     static const float REFERENCE_DISTANCE;
     static const unsigned int MAX_HARDWARE_SOURCES = 32;
-    static const unsigned int MAX_AUDIO_BUFFERS = 8192;
+    static const unsigned int MAX_AUDIO_BUFFERS = 8192; //!< Must be a power of 2 (size of the source queue)
+    static const int UPDATE_TIMEOUT_MS = 50;             //!< Audio thread updates at least this often, even without `setCamera()`
 
 private:
+    // Game threads
+    void queueSource(int source_index); //!< Lock-free, called by `Sound` on the first change since the last update
+    void requestUpdate();               //!< Caller must hold `thread_mutex`
+
+    // Audio thread
+    void audioThreadMain();
+    bool dequeueSource(int& source_index);
     void recomputeAllSources();
-    void recomputeSource(int source_index, int reason, float vfl, Ogre::Vector3 *vvec);
+    void recomputeSource(int source_index);
     ALuint getHardwareSource(int hardware_index) { return hardware_sources[hardware_index]; };
 
     void assign(int source_index, int hardware_index);
@@ -73,6 +89,38 @@ private:
 
     bool loadWAVFile(Ogre::String filename, ALuint buffer);
 
+    struct ListenerState
+    {
+        Ogre::Vector3 position;
+        Ogre::Vector3 velocity;
+        Ogre::Vector3 direction;
+        Ogre::Vector3 up;
+        float         gain;
+        float         master_volume;
+        bool          camera_changed;
+        bool          gain_changed;
+    };
+
+    struct SourceQueueSlot
+    {
+        std::atomic<size_t> sequence;
+        int                 source_index;
+    };
+
+    // Sources with pending changes; bounded MPSC queue, a source is never queued twice.
+    SourceQueueSlot         source_queue[MAX_AUDIO_BUFFERS];
+    std::atomic<size_t>     source_queue_tail; // Game threads
+    size_t                  source_queue_head; // Audio thread
+
+    std::thread             audio_thread;
+    std::mutex              thread_mutex;      // Protects `listener` and the flags below
+    std::condition_variable thread_cv;
+    ListenerState           listener;
+    bool                    update_requested;
+    bool                    thread_exit;
+    std::mutex              al_mutex;          // Serializes buffer loading (game thread) with audio thread updates
+    float                   master_volume;     // Audio thread copy
+
     // active audio sources (hardware sources)
     int    hardware_sources_num;                       // total number of available hardware sources < MAX_HARDWARE_SOURCES
     int    hardware_sources_in_use_count;
@@ -89,7 +137,7 @@ private:
     ALuint       audio_buffers[MAX_AUDIO_BUFFERS];
     Ogre::String audio_buffer_file_name[MAX_AUDIO_BUFFERS];
 
-    Ogre::Vector3 camera_position;
+    Ogre::Vector3 camera_position; // Audio thread copy
     ALCdevice*    audio_device;
     ALCcontext*   sound_context;
 };
@@ -24,6 +24,7 @@
 
 #include "Actor.h"
 #include "CameraManager.h"
+#include "Profiler.h"
 #include "Sound.h"
 #include "SoundManager.h"
 #include "Utils.h"
@@ -45,29 +46,6 @@ SoundScriptManager::SoundScriptManager() :
     , reference_distance(7.5f)
     , sound_manager(nullptr)
 {
-    for (int i = 0; i < SS_MAX_TRIG; i++)
-    {
-        free_trigs[i] = 0;
-    }
-
-    for (int i = 0; i < SS_MAX_MOD; i++)
-    {
-        free_pitches[i] = 0;
-        free_gains[i] = 0;
-    }
-
-    // TODO: there is a memory corruption going on here, need to fix
-    for (int i = 0; i < SS_MAX_TRIG * MAX_INSTANCES_PER_GROUP; i++)
-    {
-        trigs[i] = 0;
-    }
-
-    for (int i = 0; i < SS_MAX_MOD * MAX_INSTANCES_PER_GROUP; i++)
-    {
-        pitches[i] = 0;
-        gains[i] = 0;
-    }
-
     // reset all states
     state_map.clear();
 
@@ -114,12 +92,13 @@ void SoundScriptManager::trigOnce(int actor_id, int trig, int linkType, int link
     if (disabled)
         return;
 
-    for (int i = 0; i < free_trigs[trig]; i++)
-    {
-        // cycle through all instance groups
-        SoundScriptInstance* inst = trigs[trig + i * SS_MAX_TRIG];
+    SoundScriptActorRouting* routing = this->getActorRouting(actor_id);
+    if (!routing)
+        return;
 
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+    for (SoundScriptInstance* inst : routing->trigs[trig])
+    {
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             inst->runOnce();
         }
@@ -146,11 +125,13 @@ void SoundScriptManager::trigStart(int actor_id, int trig, int linkType, int lin
 
     state_map[linkType][linkItemID][actor_id][trig] = true;
 
-    for (int i = 0; i < free_trigs[trig]; i++)
-    {
-        SoundScriptInstance* inst = trigs[trig + i * SS_MAX_TRIG];
+    SoundScriptActorRouting* routing = this->getActorRouting(actor_id);
+    if (!routing)
+        return;
 
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+    for (SoundScriptInstance* inst : routing->trigs[trig])
+    {
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             inst->start();
         }
@@ -176,11 +157,13 @@ void SoundScriptManager::trigStop(int actor_id, int trig, int linkType, int link
         return;
 
     state_map[linkType][linkItemID][actor_id][trig] = false;
-    for (int i = 0; i < free_trigs[trig]; i++)
-    {
-        SoundScriptInstance* inst = trigs[trig + i * SS_MAX_TRIG];
+    SoundScriptActorRouting* routing = this->getActorRouting(actor_id);
+    if (!routing)
+        return;
 
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+    for (SoundScriptInstance* inst : routing->trigs[trig])
+    {
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             inst->stop();
         }
@@ -206,11 +189,13 @@ void SoundScriptManager::trigKill(int actor_id, int trig, int linkType, int link
         return;
 
     state_map[linkType][linkItemID][actor_id][trig] = false;
-    for (int i = 0; i < free_trigs[trig]; i++)
-    {
-        SoundScriptInstance* inst = trigs[trig + i * SS_MAX_TRIG];
+    SoundScriptActorRouting* routing = this->getActorRouting(actor_id);
+    if (!routing)
+        return;
 
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+    for (SoundScriptInstance* inst : routing->trigs[trig])
+    {
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             inst->kill();
         }
@@ -277,10 +262,13 @@ void SoundScriptManager::modulate(int actor_id, int mod, float value, int linkTy
     if (mod >= SS_MAX_MOD)
         return;
 
-    for (int i = 0; i < free_gains[mod]; i++)
+    SoundScriptActorRouting* routing = this->getActorRouting(actor_id);
+    if (!routing)
+        return;
+
+    for (SoundScriptInstance* inst : routing->gains[mod])
     {
-        SoundScriptInstance* inst = gains[mod + i * SS_MAX_MOD];
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             // this one requires modulation
             float gain = value * value * inst->templ->gain_square + value * inst->templ->gain_multiplier + inst->templ->gain_offset;
@@ -290,10 +278,9 @@ void SoundScriptManager::modulate(int actor_id, int mod, float value, int linkTy
         }
     }
 
-    for (int i = 0; i < free_pitches[mod]; i++)
+    for (SoundScriptInstance* inst : routing->pitches[mod])
     {
-        SoundScriptInstance* inst = pitches[mod + i * SS_MAX_MOD];
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        if (inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
         {
             // this one requires modulation
             float pitch = value * value * inst->templ->pitch_square + value * inst->templ->pitch_multiplier + inst->templ->pitch_offset;
@@ -303,8 +290,20 @@ void SoundScriptManager::modulate(int actor_id, int mod, float value, int linkTy
     }
 }
 
+SoundScriptActorRouting* SoundScriptManager::getActorRouting(int actor_id)
+{
+    auto itor = actor_routing.find(actor_id);
+    return (itor != actor_routing.end()) ? &itor->second : nullptr;
+}
+
+void SoundScriptManager::removeActorRouting(int actor_id)
+{
+    actor_routing.erase(actor_id);
+}
+
 void SoundScriptManager::update(float dt_sec)
 {
+    ROR_PROFILE_ZONE("Audio");
     if (App::sim_state->GetEnum<SimState>() == SimState::RUNNING ||
         App::sim_state->GetEnum<SimState>() == SimState::EDITOR_MODE)
     {
@@ -368,9 +367,10 @@ SoundScriptInstance* SoundScriptManager::createInstance(Ogre::String templatenam
         return NULL; // invalid template!
     }
 
-    if (free_trigs[templ->trigger_source] >= MAX_INSTANCES_PER_GROUP
-        || (free_gains[templ->trigger_source] >= MAX_INSTANCES_PER_GROUP && templ->gain_source != SS_MOD_NONE)
-        || (free_pitches[templ->trigger_source] >= MAX_INSTANCES_PER_GROUP && templ->pitch_source != SS_MOD_NONE))
+    SoundScriptActorRouting& routing = actor_routing[actor_id];
+    if (routing.trigs[templ->trigger_source].size() >= (size_t)MAX_INSTANCES_PER_GROUP
+        || (templ->gain_source != SS_MOD_NONE && routing.gains[templ->gain_source].size() >= (size_t)MAX_INSTANCES_PER_GROUP)
+        || (templ->pitch_source != SS_MOD_NONE && routing.pitches[templ->pitch_source].size() >= (size_t)MAX_INSTANCES_PER_GROUP))
     {
         LOG("SoundScriptManager: Reached MAX_INSTANCES_PER_GROUP limit (" + TOSTRING(MAX_INSTANCES_PER_GROUP) + ")");
         return NULL; // reached limit!
@@ -380,18 +380,15 @@ SoundScriptInstance* SoundScriptManager::createInstance(Ogre::String templatenam
     instance_counter++;
 
     // register to lookup tables
-    trigs[templ->trigger_source + free_trigs[templ->trigger_source] * SS_MAX_TRIG] = inst;
-    free_trigs[templ->trigger_source]++;
+    routing.trigs[templ->trigger_source].push_back(inst);
 
     if (templ->gain_source != SS_MOD_NONE)
     {
-        gains[templ->gain_source + free_gains[templ->gain_source] * SS_MAX_MOD] = inst;
-        free_gains[templ->gain_source]++;
+        routing.gains[templ->gain_source].push_back(inst);
     }
     if (templ->pitch_source != SS_MOD_NONE)
     {
-        pitches[templ->pitch_source + free_pitches[templ->pitch_source] * SS_MAX_MOD] = inst;
-        free_pitches[templ->pitch_source]++;
+        routing.pitches[templ->pitch_source].push_back(inst);
     }
 
     // SoundTrigger: SS_TRIG_ALWAYSON
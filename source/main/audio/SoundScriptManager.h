@@ -27,6 +27,9 @@
 
 #include <OgreScriptLoader.h>
 
+#include <unordered_map>
+#include <vector>
+
 #define SOUND_PLAY_ONCE(_ACTOR_, _TRIG_)        App::GetSoundScriptManager()->trigOnce    ( (_ACTOR_), (_TRIG_) )
 #define SOUND_START(_ACTOR_, _TRIG_)            App::GetSoundScriptManager()->trigStart   ( (_ACTOR_), (_TRIG_) )
 #define SOUND_STOP(_ACTOR_, _TRIG_)             App::GetSoundScriptManager()->trigStop    ( (_ACTOR_), (_TRIG_) )
@@ -247,6 +250,15 @@ private:
     int sound_link_item_id; // holds the item number this is for
 };
 
+/// Sound instances of one actor, grouped by trigger/modulation source at creation time,
+/// so that `trig*()` and `modulate()` only visit the instances they affect.
+struct SoundScriptActorRouting
+{
+    std::vector<SoundScriptInstance*> trigs[SS_MAX_TRIG];
+    std::vector<SoundScriptInstance*> gains[SS_MAX_MOD];
+    std::vector<SoundScriptInstance*> pitches[SS_MAX_MOD];
+};
+
 class SoundScriptManager : public Ogre::ScriptLoader, public ZeroedMemoryAllocator
 {
 public:
@@ -260,6 +272,7 @@ public:
     Ogre::Real getLoadingOrder(void) const;
 
     SoundScriptInstance* createInstance(Ogre::String templatename, int actor_id, Ogre::SceneNode *toAttach=NULL, int soundLinkType=SL_DEFAULT, int soundLinkItemId=-1);
+    void removeActorRouting(int actor_id); //!< Forgets the actor's instances; call when the actor is deleted.
 
     // functions
     void trigOnce    (int actor_id, int trig, int linkType = SL_DEFAULT, int linkItemID=-1);
@@ -291,6 +304,7 @@ private:
     SoundScriptTemplate* createTemplate(Ogre::String name, Ogre::String groupname, Ogre::String filename);
     void skipToNextCloseBrace(Ogre::DataStreamPtr& chunk);
     void skipToNextOpenBrace(Ogre::DataStreamPtr& chunk);
+    SoundScriptActorRouting* getActorRouting(int actor_id); //!< Returns nullptr if the actor has no sounds
 
     bool disabled;
     bool loading_base;
@@ -302,15 +316,8 @@ private:
 
     std::map <Ogre::String, SoundScriptTemplate*> templates;
 
-    // instances lookup tables
-    int free_trigs[SS_MAX_TRIG];
-    SoundScriptInstance *trigs[SS_MAX_TRIG * MAX_INSTANCES_PER_GROUP];
-
-    int free_pitches[SS_MAX_MOD];
-    SoundScriptInstance *pitches[SS_MAX_MOD * MAX_INSTANCES_PER_GROUP];
-    
-    int free_gains[SS_MAX_MOD];
-    SoundScriptInstance *gains[SS_MAX_MOD * MAX_INSTANCES_PER_GROUP];
+    // instances lookup tables, by actor ID; only modified when spawning or deleting actors (physics is halted)
+    std::unordered_map<int, SoundScriptActorRouting> actor_routing;
 
     // state map
     // soundLinks, soundItems, actor_ids, triggers
@@ -222,7 +222,7 @@ void Character::update(float dt)
 
         if (App::GetSimTerrain()->getWater())
         {
-            wheight = App::GetSimTerrain()->getWater()->CalcWavesHeight(position);
+            wheight = App::GetSimTerrain()->getWater()->CalcWavesHeight(position, IWater::GetWavesClock());
             if (position.y < wheight - 1.8f)
             {
                 position.y = wheight - 1.8f;
@@ -27,14 +27,20 @@
 #include "TerrainManager.h"
 #include "PropertyMaps.h"
 #include "PagedGeometry.h"
+#include "ThreadPool.h"
 
 #include <OgreConfigFile.h>
 
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
 using namespace Ogre;
 using namespace RoR;
 
 Landusemap::Landusemap(String configFilename) :
-    data(0)
+    m_width(0)
+    , m_depth(0)
     , default_ground_model(nullptr)
     , mapsize(App::GetSimTerrain()->getMaxTerrainSize())
 {
@@ -43,20 +49,6 @@ Landusemap::Landusemap(String configFilename) :
 
 Landusemap::~Landusemap()
 {
-    if (data != nullptr)
-        delete[] data;
-}
-
-ground_model_t* Landusemap::getGroundModelAt(int x, int z)
-{
-    if (!data)
-        return nullptr;
-
-    // we return the default ground model if we are not anymore in this map
-    if (x < 0 || x >= mapsize.x || z < 0 || z >= mapsize.z)
-        return default_ground_model;
-
-    return data[x + z * (int)mapsize.x];
 }
 
 int Landusemap::loadConfig(const Ogre::String& filename)
@@ -145,32 +137,60 @@ int Landusemap::loadConfig(const Ogre::String& filename)
 
         Ogre::TRect<Ogre::Real> bounds = Forests::TBounds(0, 0, mapsize.x, mapsize.z);
 
-        // now allocate the data buffer to hold pointers to ground models
-        data = new ground_model_t*[(int)(mapsize.x * mapsize.z)];
-        ground_model_t** ptr = data;
-        //std::map < String, int > counters;
-        for (int z = 0; z < mapsize.z; z++)
+        // build the ground model palette; colors not listed in 'use-map' get index 0
+        std::unordered_map<unsigned int, uint8_t> color_indices;
+        std::map<String, uint8_t> use_indices;
+        m_palette.clear();
+        m_palette.push_back(App::GetSimTerrain()->GetCollisions()->getGroundModelByString(""));
+        use_indices[""] = 0;
+        for (auto& entry : usemap)
         {
-            for (int x = 0; x < mapsize.x; x++)
+            auto found = use_indices.find(entry.second);
+            if (found == use_indices.end())
             {
-                unsigned int col = colourMap->getColorAt(x, z, bounds);
-                if (bgr)
+                if (m_palette.size() == MAX_PALETTE_SIZE)
                 {
-                    // Swap red and blue values
-                    unsigned int cols = col & 0xFF00FF00;
-                    cols |= (col & 0xFF) << 16;
-                    cols |= (col & 0xFF0000) >> 16;
-                    col = cols;
+                    LOG("too many ground models in landuse config " + filename + ", ignoring: " + entry.second);
+                    continue;
                 }
-                String use = usemap[col];
-                //if (use!="")
-                //	counters[use]++;
-
-                // store the pointer to the ground model in the data slot
-                *ptr = App::GetSimTerrain()->GetCollisions()->getGroundModelByString(use);
-                ptr++;
+                found = use_indices.insert(std::make_pair(entry.second, (uint8_t)m_palette.size())).first;
+                m_palette.push_back(App::GetSimTerrain()->GetCollisions()->getGroundModelByString(entry.second));
             }
+            color_indices[entry.first] = found->second;
+        }
+
+        // now fill the index buffer, rows are split between worker threads
+        m_width = (int)mapsize.x;
+        m_depth = (int)mapsize.z;
+        m_data.resize((size_t)m_width * m_depth);
+
+        const int num_tasks = std::max(1, App::app_num_workers->GetInt() + 1);
+        std::vector<std::function<void()>> tasks;
+        for (int t = 0; t < num_tasks; t++)
+        {
+            tasks.push_back([this, t, num_tasks, bgr, &bounds, &color_indices, colourMap]()
+                {
+                    for (int z = t; z < m_depth; z += num_tasks)
+                    {
+                        uint8_t* ptr = &m_data[(size_t)z * m_width];
+                        for (int x = 0; x < m_width; x++)
+                        {
+                            unsigned int col = colourMap->getColorAt(x, z, bounds);
+                            if (bgr)
+                            {
+                                // Swap red and blue values
+                                unsigned int cols = col & 0xFF00FF00;
+                                cols |= (col & 0xFF) << 16;
+                                cols |= (col & 0xFF0000) >> 16;
+                                col = cols;
+                            }
+                            auto found = color_indices.find(col);
+                            ptr[x] = (found != color_indices.end()) ? found->second : 0;
+                        }
+                    }
+                });
         }
+        App::GetThreadPool()->Parallelize(tasks);
     }
     catch (Ogre::Exception& oex)
     {
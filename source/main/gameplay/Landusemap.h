@@ -25,6 +25,8 @@
 #include "Application.h"
 #include "SimData.h"
 
+#include <vector>
+
 namespace RoR {
 
 class Landusemap : public ZeroedMemoryAllocator
@@ -34,12 +36,28 @@ public:
     Landusemap(Ogre::String cfgfilename);
     ~Landusemap();
 
-    ground_model_t* getGroundModelAt(int x, int z);
+    inline ground_model_t* getGroundModelAt(int x, int z) const
+    {
+        if (m_data.empty())
+            return nullptr;
+
+        // we return the default ground model if we are not anymore in this map
+        if (x < 0 || x >= m_width || z < 0 || z >= m_depth)
+            return default_ground_model;
+
+        return m_palette[m_data[x + z * m_width]];
+    }
+
     int loadConfig(const Ogre::String& filename);
 
 protected:
 
-    ground_model_t** data;
+    static const size_t MAX_PALETTE_SIZE = 256;
+
+    std::vector<uint8_t> m_data;              //!< One index into `m_palette` per landuse texel
+    std::vector<ground_model_t*> m_palette;   //!< Index 0 = color not listed in 'use-map'
+    int m_width;
+    int m_depth;
     ground_model_t* default_ground_model;
 
     Ogre::Vector3 mapsize;
@@ -22,6 +22,9 @@
 
 #include "Application.h"
 #include "Road2.h"
+#include "ThreadPool.h"
+
+#include <functional>
 
 using namespace Ogre;
 using namespace RoR;
@@ -49,19 +52,27 @@ int ProceduralManager::updateObject(ProceduralObject& po)
 {
     if (po.road)
         deleteObject(po);
+    this->createRoad(po, (int)pObjects.size());
+    this->generateRoad(po);
+    po.road->commit();
+    return 0;
+}
+
+void ProceduralManager::createRoad(ProceduralObject& po, int id)
+{
     // create new road2 object
-    po.road = new Road2((int)pObjects.size());
+    po.road = new Road2(id);
     // In diagnostic mode, disable collisions (speeds up terrain loading)
     po.road->setCollisionEnabled(!App::diag_terrn_log_roads->GetBool());
+}
 
-    std::vector<ProceduralPoint>::iterator it;
-    for (it = po.points.begin(); it != po.points.end(); it++)
+void ProceduralManager::generateRoad(ProceduralObject& po)
+{
+    for (ProceduralPoint const& pp : po.points)
     {
-        ProceduralPoint pp = *it;
         po.road->addBlock(pp.position, pp.rotation, pp.type, pp.width, pp.bwidth, pp.bheight, pp.pillartype);
     }
     po.road->finish();
-    return 0;
 }
 
 int ProceduralManager::addObject(ProceduralObject& po)
@@ -71,6 +82,30 @@ int ProceduralManager::addObject(ProceduralObject& po)
     return 0;
 }
 
+void ProceduralManager::addObjects(std::vector<ProceduralObject> const& objects)
+{
+    // Roads only fill their own buffers and read terrain heights while generating,
+    // scene and collision changes wait for the commit on main thread.
+    const size_t first = pObjects.size();
+    for (ProceduralObject const& po : objects)
+    {
+        pObjects.push_back(po);
+        this->createRoad(pObjects.back(), (int)pObjects.size() - 1);
+    }
+
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = first; i < pObjects.size(); i++)
+    {
+        tasks.push_back([this, i]() { this->generateRoad(pObjects[i]); });
+    }
+    App::GetThreadPool()->Parallelize(tasks);
+
+    for (size_t i = first; i < pObjects.size(); i++)
+    {
+        pObjects[i].road->commit();
+    }
+}
+
 void ProceduralManager::logDiagnostics()
 {
     Log("[RoR] Procedural road diagnostic.\n"
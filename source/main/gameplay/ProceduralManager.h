@@ -50,12 +50,16 @@ public:
 
     int  addObject(ProceduralObject& po);
 
+    void addObjects(std::vector<ProceduralObject> const& objects); //!< Generates the roads in parallel.
+
     int  deleteObject(ProceduralObject& po);
 
     void logDiagnostics();
 
 private:
     int updateObject(ProceduralObject& po);
+    void createRoad(ProceduralObject& po, int id);
+    void generateRoad(ProceduralObject& po);
 
     std::vector<ProceduralObject> pObjects;
 };
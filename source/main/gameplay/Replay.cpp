@@ -27,11 +27,98 @@
 #include "GUIManager.h"
 #include "InputEngine.h"
 #include "Language.h"
+#include "PlatformUtils.h"
 #include "Utils.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
 using namespace Ogre;
 using namespace RoR;
 
+const float Replay::POS_QUANT_STEP = 1.f / 1024.f;
+const float Replay::VELO_QUANT_STEP = 1.f / 256.f;
+
+namespace {
+
+const uint8_t BEAM_BROKEN   = 1 << 0;
+const uint8_t BEAM_DISABLED = 1 << 1;
+
+// Keeps the linear prediction `2*q - q_prev` well inside int64 and the stored values inside int32
+const int32_t QUANT_LIMIT = 1 << 29;
+
+// Checks the exponent bits; unlike `std::isfinite()` this can't be optimized away by -ffast-math
+inline bool IsFiniteFloat(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x7f800000u) != 0x7f800000u;
+}
+
+inline int32_t Quantize(float value, float step)
+{
+    if (!IsFiniteFloat(value))
+        return 0;
+    const float q = std::floor(value / step + 0.5f);
+    if (q > (float)QUANT_LIMIT)
+        return QUANT_LIMIT;
+    if (q < (float)-QUANT_LIMIT)
+        return -QUANT_LIMIT;
+    return (int32_t)q;
+}
+
+inline uint8_t GetBeamState(beam_t const& beam)
+{
+    return (beam.bm_broken ? BEAM_BROKEN : 0) | (beam.bm_disabled ? BEAM_DISABLED : 0);
+}
+
+inline void PutVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+inline uint64_t GetVarint(const uint8_t* data, size_t& cursor)
+{
+    uint64_t value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do
+    {
+        byte = data[cursor++];
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+inline uint64_t ZigZag(int64_t value)
+{
+    return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+inline int64_t UnZigZag(uint64_t value)
+{
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+inline int SeekFile(FILE* file, uint64_t offset)
+{
+#ifdef _WIN32
+    return _fseeki64(file, (__int64)offset, SEEK_SET);
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+} // namespace
+
 Replay::Replay(Actor* actor, int _numFrames)
 {
     m_actor = actor;
@@ -41,18 +128,11 @@ Replay::Replay(Actor* actor, int _numFrames)
 
     replayTimer = new Timer();
 
-    // DO NOT get memory here, get memory when we use it first time!
-    nodes = 0;
-    beams = 0;
-    times = 0;
-
+    // Memory is allocated chunk by chunk as the recording goes
     outOfMemory = false;
 
-    unsigned long bsize = (actor->ar_num_nodes * numFrames * sizeof(node_simple_t) + actor->ar_num_beams * numFrames * sizeof(beam_simple_t) + numFrames * sizeof(unsigned long)) / 1024.0f;
-    LOG("replay buffer size: " + TOSTRING(bsize) + " kB");
-
-    writeIndex = 0;
-    firstRun = 1;
+    LOG("replay: " + TOSTRING(numFrames) + " frames, keyframe every " + TOSTRING(CHUNK_FRAMES) + " frames"
+        + (App::sim_replay_spill->GetBool() ? ", spilling to disk" : ""));
 
     int steps = App::sim_replay_stepping->GetInt();
 
@@ -60,117 +140,346 @@ Replay::Replay(Actor* actor, int _numFrames)
         this->ar_replay_precision = 0.0f;
     else
         this->ar_replay_precision = 1.0f / ((float)steps);
-
-    // windowing
-    int width = 300;
-    int height = 60;
-    int x = (MyGUI::RenderManager::getInstance().getViewSize().width - width) / 2;
-    int y = 0;
 }
 
 Replay::~Replay()
 {
-    if (nodes)
+    if (m_spill_file)
     {
-        free(nodes);
-        nodes = 0;
-        free(beams);
-        beams = 0;
-        free(times);
-        times = 0;
+        fclose(m_spill_file);
+        std::remove(m_spill_path.c_str());
     }
     delete replayTimer;
 }
 
-void* Replay::getWriteBuffer(int type)
+void Replay::WriteFrame()
 {
-    if (outOfMemory)
-        return 0;
-    if (!nodes)
+    const int num_nodes = m_actor->ar_num_nodes;
+    const int num_beams = m_actor->ar_num_beams;
+
+    if (m_num_frames_total % CHUNK_FRAMES == 0)
     {
-        // get memory
-        nodes = (node_simple_t*)calloc(m_actor->ar_num_nodes * numFrames, sizeof(node_simple_t));
-        if (!nodes)
+        // Seal the previous chunk and start a new one with a keyframe
+        if (!m_chunks.empty())
         {
-            outOfMemory = true;
-            return 0;
+            m_chunks.back().rc_data.shrink_to_fit();
+            if (App::sim_replay_spill->GetBool() && !m_spill_disabled)
+                this->SpillChunk(m_chunks.back());
         }
-        beams = (beam_simple_t*)calloc(m_actor->ar_num_beams * numFrames, sizeof(beam_simple_t));
-        if (!beams)
+
+        m_chunks.emplace_back();
+        ReplayChunk& chunk = m_chunks.back();
+        chunk.rc_times.reserve(CHUNK_FRAMES);
+        chunk.rc_key_qpos.resize(num_nodes * 3);
+        chunk.rc_key_qvelo.resize(num_nodes * 3);
+        chunk.rc_key_beams.resize(num_beams);
+
+        m_enc_qpos.resize(num_nodes * 3);
+        m_enc_beams.resize(num_beams);
+        for (int i = 0; i < num_nodes; i++)
         {
-            free(nodes);
-            nodes = 0;
-            outOfMemory = true;
-            return 0;
+            const node_t& n = m_actor->ar_nodes[i];
+            for (int k = 0; k < 3; k++)
+            {
+                m_enc_qpos[i * 3 + k] = Quantize(n.AbsPosition[k], POS_QUANT_STEP);
+                chunk.rc_key_qvelo[i * 3 + k] = Quantize(n.Velocity[k], VELO_QUANT_STEP);
+            }
         }
-        times = (unsigned long*)calloc(numFrames, sizeof(unsigned long));
-        if (!times)
+        for (int i = 0; i < num_beams; i++)
         {
-            free(nodes);
-            nodes = 0;
-            free(beams);
-            beams = 0;
-            outOfMemory = true;
-            return 0;
+            m_enc_beams[i] = GetBeamState(m_actor->ar_beams[i]);
         }
+        m_enc_qpos_prev = m_enc_qpos;
+
+        chunk.rc_key_qpos = m_enc_qpos;
+        chunk.rc_key_beams = m_enc_beams;
+    }
+    else
+    {
+        // Delta frame: per node, residuals against a linear position prediction.
+        // Runs of nodes with all-zero residuals (resting or uniformly moving) are coded as a single count.
+        // Velocities are left out - their residuals are hardly ever zero, and playback can derive them.
+        std::vector<uint8_t>& out = m_chunks.back().rc_data;
+        uint64_t zero_run = 0;
+        for (int i = 0; i < num_nodes; i++)
+        {
+            const node_t& n = m_actor->ar_nodes[i];
+            int64_t residual[3];
+            bool changed = false;
+            for (int k = 0; k < 3; k++)
+            {
+                const int j = i * 3 + k;
+                const int32_t qpos = Quantize(n.AbsPosition[k], POS_QUANT_STEP);
+                const int64_t predicted = 2 * (int64_t)m_enc_qpos[j] - (int64_t)m_enc_qpos_prev[j];
+                residual[k] = (int64_t)qpos - predicted;
+                changed |= (residual[k] != 0);
+
+                m_enc_qpos_prev[j] = m_enc_qpos[j];
+                m_enc_qpos[j] = qpos;
+            }
+
+            if (changed)
+            {
+                PutVarint(out, zero_run);
+                zero_run = 0;
+                for (int k = 0; k < 3; k++)
+                    PutVarint(out, ZigZag(residual[k]));
+            }
+            else
+            {
+                zero_run++;
+            }
+        }
+        if (zero_run > 0)
+            PutVarint(out, zero_run);
+
+        // Beams: list of changed states
+        uint64_t num_changed = 0;
+        for (int i = 0; i < num_beams; i++)
+        {
+            if (GetBeamState(m_actor->ar_beams[i]) != m_enc_beams[i])
+                num_changed++;
+        }
+        PutVarint(out, num_changed);
+        int last_index = 0;
+        for (int i = 0; i < num_beams && num_changed > 0; i++)
+        {
+            const uint8_t state = GetBeamState(m_actor->ar_beams[i]);
+            if (state != m_enc_beams[i])
+            {
+                PutVarint(out, (uint64_t)(i - last_index));
+                out.push_back(state);
+                m_enc_beams[i] = state;
+                last_index = i;
+                num_changed--;
+            }
+        }
+    }
+
+    m_chunks.back().rc_times.push_back(replayTimer->getMicroseconds());
+    m_num_frames_total++;
+
+    // Drop the oldest chunk once the rest of the recording covers the requested length
+    while (m_num_frames_total - m_first_frame - CHUNK_FRAMES >= numFrames)
+    {
+        this->ReleaseChunkSpill(m_chunks.front());
+        m_chunks.pop_front();
+        m_first_frame += CHUNK_FRAMES;
+    }
+}
+
+bool Replay::ReadFrame(int frame)
+{
+    const int num_nodes = m_actor->ar_num_nodes;
+    const int num_beams = m_actor->ar_num_beams;
+    const int chunk_abs = frame / CHUNK_FRAMES;
+    const int local = frame % CHUNK_FRAMES;
+    ReplayChunk& chunk = m_chunks[chunk_abs - m_first_frame / CHUNK_FRAMES];
+
+    int start_local;
+    if (m_dec_frame >= 0 && m_dec_frame / CHUNK_FRAMES == chunk_abs && m_dec_frame <= frame)
+    {
+        // Continue from the previously decoded frame
+        start_local = m_dec_frame % CHUNK_FRAMES;
     }
-    void* ptr = 0;
-    times[writeIndex] = replayTimer->getMicroseconds();
-    if (type == 0)
+    else
     {
-        // nodes
-        ptr = (void *)(nodes + (writeIndex * m_actor->ar_num_nodes));
+        // Seek to keyframe
+        m_dec_qpos = chunk.rc_key_qpos;
+        m_dec_qpos_prev = chunk.rc_key_qpos;
+        m_dec_beams = chunk.rc_key_beams;
+        m_dec_cursor = 0;
+        start_local = 0;
     }
-    else if (type == 1)
+
+    if (local > start_local)
     {
-        // beams
-        ptr = (void *)(beams + (writeIndex * m_actor->ar_num_beams));
+        const uint8_t* data = this->FetchChunkData(chunk_abs);
+        if (!data)
+        {
+            m_dec_frame = -1;
+            return false;
+        }
+
+        for (int f = start_local + 1; f <= local; f++)
+        {
+            int i = 0;
+            while (i < num_nodes)
+            {
+                // Nodes without residuals follow the prediction
+                const int run_end = i + (int)GetVarint(data, m_dec_cursor);
+                for (; i < run_end; i++)
+                {
+                    for (int k = 0; k < 3; k++)
+                    {
+                        const int j = i * 3 + k;
+                        const int32_t qpos = (int32_t)(2 * (int64_t)m_dec_qpos[j] - (int64_t)m_dec_qpos_prev[j]);
+                        m_dec_qpos_prev[j] = m_dec_qpos[j];
+                        m_dec_qpos[j] = qpos;
+                    }
+                }
+                if (i < num_nodes)
+                {
+                    for (int k = 0; k < 3; k++)
+                    {
+                        const int j = i * 3 + k;
+                        const int64_t residual = UnZigZag(GetVarint(data, m_dec_cursor));
+                        const int64_t predicted = 2 * (int64_t)m_dec_qpos[j] - (int64_t)m_dec_qpos_prev[j];
+                        m_dec_qpos_prev[j] = m_dec_qpos[j];
+                        m_dec_qpos[j] = (int32_t)(predicted + residual);
+                    }
+                    i++;
+                }
+            }
+
+            uint64_t num_changed = GetVarint(data, m_dec_cursor);
+            int index = 0;
+            while (num_changed-- > 0)
+            {
+                index += (int)GetVarint(data, m_dec_cursor);
+                const uint8_t state = data[m_dec_cursor++];
+                if (index < num_beams)
+                    m_dec_beams[index] = state;
+            }
+        }
     }
-    return ptr;
+
+    // Velocities: stored in the keyframe, otherwise the position change since the previous frame
+    m_dec_velo.resize(num_nodes * 3);
+    const float dt = (local > 0) ? (chunk.rc_times[local] - chunk.rc_times[local - 1]) * 0.000001f : 0.f;
+    for (int j = 0; j < num_nodes * 3; j++)
+    {
+        if (local == 0)
+            m_dec_velo[j] = chunk.rc_key_qvelo[j] * VELO_QUANT_STEP;
+        else if (dt > 0.f)
+            m_dec_velo[j] = (m_dec_qpos[j] - m_dec_qpos_prev[j]) * POS_QUANT_STEP / dt;
+        else
+            m_dec_velo[j] = 0.f;
+    }
+
+    m_dec_frame = frame;
+    curFrameTime = chunk.rc_times[local];
+    return true;
 }
 
-void Replay::writeDone()
+void Replay::SpillChunk(ReplayChunk& chunk)
 {
-    if (outOfMemory)
+    if (chunk.rc_data.empty())
+        return;
+
+    if (!m_spill_file)
+    {
+        m_spill_path = PathCombine(App::sys_cache_dir->GetStr(), "replay_" + TOSTRING(m_actor->ar_instance_id) + ".tmp");
+        m_spill_file = fopen(m_spill_path.c_str(), "w+b");
+        if (!m_spill_file)
+        {
+            LOG("replay: cannot open spill file '" + m_spill_path + "', keeping recording in memory");
+            m_spill_disabled = true;
+            return;
+        }
+    }
+
+    // Reuse the smallest free range that fits, otherwise append
+    const size_t size = chunk.rc_data.size();
+    auto best = m_spill_free.end();
+    for (auto itor = m_spill_free.begin(); itor != m_spill_free.end(); ++itor)
+    {
+        if (itor->sr_size >= size && (best == m_spill_free.end() || itor->sr_size < best->sr_size))
+            best = itor;
+    }
+    const uint64_t offset = (best != m_spill_free.end()) ? best->sr_offset : m_spill_end;
+
+    if (SeekFile(m_spill_file, offset) != 0 || fwrite(chunk.rc_data.data(), size, 1, m_spill_file) != 1)
+    {
+        LOG("replay: failed to write spill file '" + m_spill_path + "', keeping chunk in memory");
         return;
-    writeIndex++;
-    if (writeIndex == numFrames)
+    }
+
+    if (best != m_spill_free.end())
+    {
+        best->sr_offset += size;
+        best->sr_size -= size;
+        if (best->sr_size == 0)
+            m_spill_free.erase(best);
+    }
+    else
     {
-        firstRun = 0;
-        writeIndex = 0;
+        m_spill_end += size;
     }
+
+    chunk.rc_spill_offset = offset;
+    chunk.rc_spill_size = size;
+    chunk.rc_spilled = true;
+    m_num_spilled++;
+    std::vector<uint8_t>().swap(chunk.rc_data);
 }
 
-//we take negative offsets only
-void* Replay::getReadBuffer(int offset, int type, unsigned long& time)
+void Replay::ReleaseChunkSpill(ReplayChunk& chunk)
 {
-    if (offset >= 0)
-        offset = -1;
-    if (offset <= -numFrames)
-        offset = -numFrames + 1;
-
-    int delta = writeIndex + offset;
-    if (delta < 0)
-        if (firstRun && type == 0)
-            return (void *)(nodes);
-        else if (firstRun && type == 1)
-            return (void *)(beams);
-        else
-            delta += numFrames;
+    if (!chunk.rc_spilled)
+        return;
 
-    // set the time
-    time = times[delta];
-    curFrameTime = time;
+    chunk.rc_spilled = false;
+    m_num_spilled--;
+    if (m_num_spilled == 0)
+    {
+        // Nothing left in the file - truncate it
+        fclose(m_spill_file);
+        m_spill_file = fopen(m_spill_path.c_str(), "w+b");
+        if (!m_spill_file)
+        {
+            LOG("replay: cannot reopen spill file '" + m_spill_path + "', keeping recording in memory");
+            m_spill_disabled = true;
+        }
+        m_spill_free.clear();
+        m_spill_end = 0;
+        m_spill_buf_chunk = -1;
+        return;
+    }
 
-    if (outOfMemory)
-        return 0;
+    // Insert the range sorted by offset and merge it with its neighbours
+    SpillRange range = { chunk.rc_spill_offset, chunk.rc_spill_size };
+    auto itor = std::lower_bound(m_spill_free.begin(), m_spill_free.end(), range,
+        [](SpillRange const& a, SpillRange const& b) { return a.sr_offset < b.sr_offset; });
+    itor = m_spill_free.insert(itor, range);
+    if (itor + 1 != m_spill_free.end() && itor->sr_offset + itor->sr_size == (itor + 1)->sr_offset)
+    {
+        itor->sr_size += (itor + 1)->sr_size;
+        m_spill_free.erase(itor + 1);
+    }
+    if (itor != m_spill_free.begin() && (itor - 1)->sr_offset + (itor - 1)->sr_size == itor->sr_offset)
+    {
+        (itor - 1)->sr_size += itor->sr_size;
+        itor = m_spill_free.erase(itor) - 1;
+    }
 
-    // return buffer pointer
-    if (type == 0)
-        return (void *)(nodes + delta * m_actor->ar_num_nodes);
-    else if (type == 1)
-        return (void *)(beams + delta * m_actor->ar_num_beams);
-    return 0;
+    // A free range at the end of the file just moves the end back
+    if (itor->sr_offset + itor->sr_size == m_spill_end)
+    {
+        m_spill_end = itor->sr_offset;
+        m_spill_free.erase(itor);
+    }
+}
+
+const uint8_t* Replay::FetchChunkData(int chunk_abs)
+{
+    ReplayChunk& chunk = m_chunks[chunk_abs - m_first_frame / CHUNK_FRAMES];
+    if (!chunk.rc_spilled)
+        return chunk.rc_data.data();
+
+    if (m_spill_buf_chunk != chunk_abs)
+    {
+        m_spill_buf.resize(chunk.rc_spill_size);
+        if (SeekFile(m_spill_file, chunk.rc_spill_offset) != 0 ||
+            fread(m_spill_buf.data(), chunk.rc_spill_size, 1, m_spill_file) != 1)
+        {
+            LOG("replay: failed to read spill file '" + m_spill_path + "'");
+            m_spill_buf_chunk = -1;
+            return nullptr;
+        }
+        m_spill_buf_chunk = chunk_abs;
+    }
+    return m_spill_buf.data();
 }
 
 unsigned long Replay::getLastReadTime()
@@ -183,63 +492,58 @@ void Replay::onPhysicsStep()
     m_replay_timer += PHYSICS_DT;
     if (m_replay_timer >= ar_replay_precision)
     {
-        // store nodes
-        node_simple_t* nbuff = (node_simple_t *)this->getWriteBuffer(0);
-        if (nbuff)
+        try
         {
-            for (int i = 0; i < m_actor->ar_num_nodes; i++)
-            {
-                nbuff[i].position = m_actor->ar_nodes[i].AbsPosition;
-                nbuff[i].velocity = m_actor->ar_nodes[i].Velocity;
-            }
+            this->WriteFrame();
         }
-
-        // store beams
-        beam_simple_t* bbuff = (beam_simple_t *)this->getWriteBuffer(1);
-        if (bbuff)
+        catch (std::bad_alloc&)
         {
-            for (int i = 0; i < m_actor->ar_num_beams; i++)
-            {
-                bbuff[i].broken = m_actor->ar_beams[i].bm_broken;
-                bbuff[i].disabled = m_actor->ar_beams[i].bm_disabled;
-            }
+            LOG("replay: out of memory, recording stopped");
+            for (ReplayChunk& chunk : m_chunks)
+                this->ReleaseChunkSpill(chunk);
+            m_chunks.clear();
+            outOfMemory = true;
         }
-
-        this->writeDone();
         m_replay_timer = 0.0f;
     }
 }
 
 void Replay::replayStepActor()
 {
-    if (ar_replay_pos != m_replay_pos_prev)
+    if (ar_replay_pos != m_replay_pos_prev && m_num_frames_total > 0)
     {
-        unsigned long time = 0;
-
-        node_simple_t* nbuff = (node_simple_t *)this->getReadBuffer(ar_replay_pos, 0, time);
-        if (nbuff)
+        // we take negative offsets only
+        int offset = ar_replay_pos;
+        if (offset >= 0)
+            offset = -1;
+        if (offset <= -numFrames)
+            offset = -numFrames + 1;
+        const int frame = std::max(m_num_frames_total + offset, m_first_frame);
+
+        if (this->ReadFrame(frame))
         {
             for (int i = 0; i < m_actor->ar_num_nodes; i++)
             {
-                m_actor->ar_nodes[i].AbsPosition = nbuff[i].position;
-                m_actor->ar_nodes[i].RelPosition = nbuff[i].position - m_actor->ar_origin;
-
-                m_actor->ar_nodes[i].Velocity = nbuff[i].velocity;
+                const Vector3 pos(m_dec_qpos[i * 3 + 0] * POS_QUANT_STEP,
+                                  m_dec_qpos[i * 3 + 1] * POS_QUANT_STEP,
+                                  m_dec_qpos[i * 3 + 2] * POS_QUANT_STEP);
+                m_actor->ar_nodes[i].AbsPosition = pos;
+                m_actor->ar_nodes[i].RelPosition = pos - m_actor->ar_origin;
+
+                m_actor->ar_nodes[i].Velocity = Vector3(m_dec_velo[i * 3 + 0],
+                                                        m_dec_velo[i * 3 + 1],
+                                                        m_dec_velo[i * 3 + 2]);
                 m_actor->ar_nodes[i].Forces = Vector3::ZERO;
             }
 
             m_actor->updateSlideNodePositions();
             m_actor->UpdateBoundingBoxes();
             m_actor->calculateAveragePosition();
-        }
 
-        beam_simple_t* bbuff = (beam_simple_t *)this->getReadBuffer(ar_replay_pos, 1, time);
-        if (bbuff)
-        {
             for (int i = 0; i < m_actor->ar_num_beams; i++)
             {
-                m_actor->ar_beams[i].bm_broken = bbuff[i].broken;
-                m_actor->ar_beams[i].bm_disabled = bbuff[i].disabled;
+                m_actor->ar_beams[i].bm_broken = (m_dec_beams[i] & BEAM_BROKEN) != 0;
+                m_actor->ar_beams[i].bm_disabled = (m_dec_beams[i] & BEAM_DISABLED) != 0;
             }
         }
         m_replay_pos_prev = ar_replay_pos;
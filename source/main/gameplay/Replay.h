@@ -22,30 +22,25 @@
 
 #include "Application.h"
 
-namespace RoR {
-
-struct node_simple_t
-{
-    Ogre::Vector3 position;
-    Ogre::Vector3 velocity;
-};
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <vector>
 
-struct beam_simple_t
-{
-    bool broken:1;
-    bool disabled:1;
-};
+namespace RoR {
 
-class Replay : public ZeroedMemoryAllocator
+/// Recording of actor N/B state for replay mode.
+/// Frames are stored in chunks; each chunk starts with a keyframe (quantized absolute node state)
+/// followed by delta frames (position prediction residuals, zero-run + varint coded). Seeking decodes from the keyframe.
+/// Delta frames carry no velocities; on playback they are derived from the positions of consecutive frames.
+/// Optionally, sealed chunks are spilled to a file in the cache directory (cvar 'sim_replay_spill').
+class Replay
 {
 public:
     Replay(Actor* b, int nframes);
     ~Replay();
 
-    void*               getWriteBuffer(int type);
-    void*               getReadBuffer(int offset, int type, unsigned long& time);
     unsigned long       getLastReadTime();
-    void                writeDone();
     void                onPhysicsStep();
     void                replayStepActor();
     float               getPrecision() const { return ar_replay_precision; }
@@ -55,23 +50,72 @@ public:
     bool                isValid() { return numFrames && !outOfMemory; };
     void                UpdateInputEvents();
 
+    static const int    CHUNK_FRAMES = 32;       //!< Keyframe interval
+    static const float  POS_QUANT_STEP;          //!< Meters
+    static const float  VELO_QUANT_STEP;         //!< Meters per second
+
 protected:
+
+    struct ReplayChunk
+    {
+        std::vector<unsigned long> rc_times;      //!< One per frame
+        std::vector<int32_t>       rc_key_qpos;   //!< Keyframe; 3 per node
+        std::vector<int32_t>       rc_key_qvelo;  //!< Keyframe only; 3 per node
+        std::vector<uint8_t>       rc_key_beams;  //!< Keyframe; 1 per beam, see `BEAM_*` flags in Replay.cpp
+        std::vector<uint8_t>       rc_data;       //!< Delta frames, back to back
+        bool                       rc_spilled = false;
+        uint64_t                   rc_spill_offset = 0;
+        size_t                     rc_spill_size = 0;
+    };
+
+    struct SpillRange
+    {
+        uint64_t                   sr_offset;
+        size_t                     sr_size;
+    };
+
+    void                WriteFrame();
+    bool                ReadFrame(int frame); //!< Decodes absolute frame into `m_dec_*`
+    void                SpillChunk(ReplayChunk& chunk);
+    void                ReleaseChunkSpill(ReplayChunk& chunk); //!< Call before dropping a chunk
+    const uint8_t*      FetchChunkData(int chunk_abs);
+
     Actor*              m_actor = nullptr;
     float               m_replay_timer = 0.f;
     float               ar_replay_precision = 1.f;
     int                 ar_replay_pos = 0;
     int                 m_replay_pos_prev = 0;
-    Ogre::Timer*        replayTimer;
-    int                 numFrames;
-    bool                outOfMemory;
-    int                 writeIndex;
-    int                 firstRun;
-    unsigned long       curFrameTime;
-
-    // malloc'ed
-    node_simple_t*      nodes;
-    beam_simple_t*      beams;
-    unsigned long*      times;
+    Ogre::Timer*        replayTimer = nullptr;
+    int                 numFrames = 0;
+    bool                outOfMemory = false;
+    unsigned long       curFrameTime = 0;
+
+    std::deque<ReplayChunk> m_chunks;
+    int                 m_first_frame = 0;     //!< Absolute index of the first frame in `m_chunks`
+    int                 m_num_frames_total = 0; //!< Absolute index of the next frame to write
+
+    // Encoder state - last written frame, quantized
+    std::vector<int32_t> m_enc_qpos;
+    std::vector<int32_t> m_enc_qpos_prev;
+    std::vector<uint8_t> m_enc_beams;
+
+    // Decoder state - last read frame, quantized
+    std::vector<int32_t> m_dec_qpos;
+    std::vector<int32_t> m_dec_qpos_prev;
+    std::vector<float>   m_dec_velo;           //!< Not quantized, see `ReadFrame()`
+    std::vector<uint8_t> m_dec_beams;
+    int                 m_dec_frame = -1;
+    size_t              m_dec_cursor = 0;      //!< Read offset in chunk data after `m_dec_frame`
+
+    // Disk spill
+    FILE*               m_spill_file = nullptr;
+    std::string         m_spill_path;
+    bool                m_spill_disabled = false; //!< Spill file couldn't be opened
+    uint64_t            m_spill_end = 0;        //!< End of used space in the spill file
+    int                 m_num_spilled = 0;      //!< Chunks currently stored in the spill file
+    std::vector<SpillRange> m_spill_free;       //!< Ranges of dropped chunks, reused by `SpillChunk()`; sorted by offset
+    std::vector<uint8_t> m_spill_buf;
+    int                 m_spill_buf_chunk = -1; //!< Absolute index of the chunk loaded in `m_spill_buf`
 };
 
 } // namespace RoR
@@ -36,6 +36,9 @@ Road2::Road2(int id) :
     , vertexcount(0)
 {
     msh.setNull();
+    // Resolved here, `addBlock()` may run on a worker thread
+    m_gm_concrete = App::GetSimTerrain()->GetCollisions()->getGroundModelByString("concrete");
+    m_gm_asphalt = App::GetSimTerrain()->GetCollisions()->getGroundModelByString("asphalt");
 }
 
 Road2::~Road2()
@@ -62,13 +65,23 @@ void Road2::finish()
     addQuad(pts[7], pts[6], pts[5], pts[4], TEXFIT_NONE, lastpos, lastpos, lastwidth);
     addQuad(pts[7], pts[4], pts[3], pts[0], TEXFIT_NONE, lastpos, lastpos, lastwidth);
     addQuad(pts[3], pts[2], pts[1], pts[0], TEXFIT_NONE, lastpos, lastpos, lastwidth);
+}
 
+void Road2::commit()
+{
     createMesh();
     String entity_name = String("RoadSystem_Instance-").append(StringConverter::toString(mid));
     String mesh_name = String("RoadSystem-").append(StringConverter::toString(mid));
     Entity* ec = App::GetGfxScene()->GetSceneManager()->createEntity(entity_name, mesh_name);
     snode = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
     snode->attachObject(ec);
+
+    if (!m_coll_tris.empty())
+    {
+        App::GetSimTerrain()->GetCollisions()->addCollisionTris(m_coll_tris, registeredCollTris);
+        m_coll_tris.clear();
+        m_coll_tris.shrink_to_fit();
+    }
 }
 
 void Road2::addBlock(Vector3 pos, Quaternion rot, int type, float width, float bwidth, float bheight, int pillartype)
@@ -177,15 +190,14 @@ void Road2::addBlock(Vector3 pos, Quaternion rot, int type, float width, float b
                     sidefactor = 0.2;
             }
 
-            static int pillarcounter = 0;
-            pillarcounter++;
+            m_pillar_counter++;
 
             if (pillartype == 2)
             {
                 // always in the middle
                 sidefactor = 0.5;
                 // only build every fifth pillar
-                if (pillarcounter % 5)
+                if (m_pillar_counter % 5)
                     builtpillars = false;
             }
 
@@ -384,9 +396,9 @@ void Road2::addQuad(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, int texfit,
     }
     if (collision)
     {
-        ground_model_t* gm = App::GetSimTerrain()->GetCollisions()->getGroundModelByString("concrete");
+        ground_model_t* gm = m_gm_concrete;
         if (texfit == TEXFIT_ROAD || texfit == TEXFIT_ROADS1 || texfit == TEXFIT_ROADS2 || texfit == TEXFIT_ROADS3 || texfit == TEXFIT_ROADS4)
-            gm = App::GetSimTerrain()->GetCollisions()->getGroundModelByString("asphalt");
+            gm = m_gm_asphalt;
         addCollisionQuad(p1, p2, p3, p4, gm, flip);
     }
     tricount += 2;
@@ -530,26 +542,18 @@ void Road2::textureFit(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, int texfi
 
 void Road2::addCollisionQuad(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, ground_model_t* gm, bool flip)
 {
-    int triID = 0;
+    // Registered in bulk by `commit()`
+    m_coll_tris.resize(m_coll_tris.size() + 2);
+    Collisions::collision_tri_t* tri = &m_coll_tris[m_coll_tris.size() - 2];
     if (flip)
     {
-        triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(p1, p2, p4, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
-
-        triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(p4, p2, p3, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
+        Collisions::buildCollisionTri(p1, p2, p4, gm, tri[0]);
+        Collisions::buildCollisionTri(p4, p2, p3, gm, tri[1]);
     }
     else
     {
-        triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(p1, p2, p3, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
-
-        triID = App::GetSimTerrain()->GetCollisions()->addCollisionTri(p1, p3, p4, gm);
-        if (triID >= 0)
-            registeredCollTris.push_back(triID);
+        Collisions::buildCollisionTri(p1, p2, p3, gm, tri[0]);
+        Collisions::buildCollisionTri(p1, p3, p4, gm, tri[1]);
     }
 }
 
@@ -23,10 +23,13 @@
 #include <Ogre.h>
 
 #include "Application.h"
+#include "Collisions.h"
 
 namespace RoR {
 
 // dynamic roads
+/// Geometry and collision tris are generated by `addBlock()` and `finish()` into the road's own buffers,
+/// so different roads can be generated in parallel; `commit()` then creates the mesh and registers collisions.
 class Road2 : public ZeroedMemoryAllocator
 {
 public:
@@ -42,7 +45,8 @@ public:
     void addQuad(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, int texfit, Ogre::Vector3 pos, Ogre::Vector3 lastpos, float width, bool flip = false);
     void addCollisionQuad(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, ground_model_t* gm, bool flip = false);
     void createMesh();
-    void finish();
+    void finish(); //!< Closes the road strip.
+    void commit(); //!< Creates the mesh and registers collision tris - main thread only.
     void setCollisionEnabled(bool v) { collision = v; }
 
     static const unsigned int MAX_VERTEX = 50000;
@@ -106,6 +110,10 @@ private:
     int lasttype;
     int mid;
     bool collision; //!< Register collision triangles?
+    ground_model_t* m_gm_concrete;
+    ground_model_t* m_gm_asphalt;
+    int m_pillar_counter;
+    std::vector<Collisions::collision_tri_t> m_coll_tris; //!< Waiting for `commit()`
     std::vector<int> registeredCollTris;
 };
 
@@ -29,6 +29,9 @@
 using namespace Ogre;
 using namespace RoR;
 
+/// Max distance of a source from where the slot's last-frame source should be now, to be considered the same source.
+static const float SAME_SOURCE_MAX_DIST = 0.5f;
+
 #ifndef _WIN32
 // This definitions is needed because the variable is declared but not defined in DustPool
   const int DustPool::MAX_DUSTS;
@@ -37,23 +40,32 @@ using namespace RoR;
 DustPool::DustPool(Ogre::SceneManager* sm, const char* dname, int dsize):
 	allocated(0),
 	size(std::min(dsize, static_cast<int>(MAX_DUSTS))),
+	m_psys(nullptr),
+	m_snode(nullptr),
+	m_emitter(nullptr),
 	m_is_discarded(false)
 {
-    for (int i = 0; i < size; i++)
+    char dename[256];
+    sprintf(dename, "Dust %s", dname);
+    m_snode = sm->getRootSceneNode()->createChildSceneNode();
+    m_psys = sm->createParticleSystem(dename, dname);
+    if (m_psys)
     {
-        char dename[256];
-        sprintf(dename, "Dust %s %i", dname, i);
-        sns[i] = sm->getRootSceneNode()->createChildSceneNode();
-        pss[i] = sm->createParticleSystem(dename, dname);
-        if (pss[i])
+        m_snode->attachObject(m_psys);
+        m_psys->setCastShadows(false);
+        m_psys->setVisibilityFlags(RoR::DEPTHMAP_DISABLED);
+        // The template quota was meant for a single source
+        m_psys->setParticleQuota(m_psys->getParticleQuota() * size);
+        if (m_psys->getNumEmitters() > 0)
         {
-            sns[i]->attachObject(pss[i]);
-            pss[i]->setCastShadows(false);
-            pss[i]->setVisibilityFlags(RoR::DEPTHMAP_DISABLED);
-            if (pss[i]->getNumEmitters() > 0)
-            {
-                pss[i]->getEmitter(0)->setEnabled(false);
-            }
+            m_emitter = m_psys->getEmitter(0);
+            m_emitter->setEnabled(false);
+            m_default_dir = m_emitter->getDirection();
+            m_default_speed_min = m_emitter->getMinParticleVelocity();
+            m_default_speed_max = m_emitter->getMaxParticleVelocity();
+            m_default_ttl_min = m_emitter->getMinTimeToLive();
+            m_default_ttl_max = m_emitter->getMaxTimeToLive();
+            m_default_rate = m_emitter->getEmissionRate();
         }
     }
 }
@@ -65,26 +77,24 @@ DustPool::~DustPool()
 
 void DustPool::Discard(Ogre::SceneManager* sm)
 {
-	for (int i = 0; i < size; i++)
+	m_snode->removeAndDestroyAllChildren();
+	sm->destroySceneNode(m_snode);
+	m_snode = nullptr;
+
+	if (m_psys)
 	{
-		sns[i]->removeAndDestroyAllChildren();
-		sm->destroySceneNode(sns[i]);
-		sns[i] = nullptr;
-
-		if (pss[i])
-		{
-			sm->destroyParticleSystem(pss[i]);
-			pss[i] = nullptr;
-		}
+		sm->destroyParticleSystem(m_psys);
+		m_psys = nullptr;
+		m_emitter = nullptr;
 	}
 	m_is_discarded = true;
 }
 
 void DustPool::setVisible(bool s)
 {
-    for (int i = 0; i < size; i++)
+    if (m_psys)
     {
-        pss[i]->setVisible(s);
+        m_psys->setVisible(s);
     }
 }
 
@@ -187,11 +197,10 @@ void DustPool::allocRipple(Vector3 pos, Vector3 vel)
     }
 }
 
-void DustPool::update()
+void DustPool::computeEmission()
 {
     for (int i = 0; i < allocated; i++)
     {
-        ParticleEmitter* emit = pss[i]->getEmitter(0);
         Vector3 ndir = velocities[i];
         Real vel = ndir.length();
         ColourValue col = colours[i];
@@ -200,42 +209,28 @@ void DustPool::update()
             vel += 0.0001;
         ndir = ndir / vel;
 
-        emit->setEnabled(true);
-
-        if (types[i] != DUST_RIPPLE)
-        {
-            emit->setDirection(ndir);
-            emit->setParticleVelocity(vel);
-            sns[i]->setPosition(positions[i]);
-        }
+        m_emit_dir[i] = ndir;
+        m_emit_speed[i] = vel;
+        m_emit_ttl[i] = -1.f;
+        m_emit_rate[i] = m_default_rate;
 
         if (types[i] == DUST_NORMAL)
         {
-            ndir.y = 0;
-            ndir = ndir / 2.0;
-
             col.a = vel * 0.05;
-            emit->setTimeToLive(vel * 0.05 / 0.1);
+            m_emit_ttl[i] = vel * 0.05 / 0.1;
         }
         else if (types[i] == DUST_CLUMP)
         {
-            ndir = ndir / 2.0;
-            if (ndir.y < 0)
-                ndir.y = -ndir.y;
-
             col.a = 1.0;
         }
         else if (types[i] == DUST_RUBBER)
         {
-            ndir.y = 0;
-            ndir = ndir / 4.0;
-
             col.a = sqrt(vel) * 0.1;
             col.b = 0.9;
             col.g = 0.9;
             col.r = 0.9;
 
-            emit->setTimeToLive(vel * 0.025 / 0.1);
+            m_emit_ttl[i] = vel * 0.025 / 0.1;
         }
         else if (types[i] == DUST_SPARKS)
         {
@@ -243,51 +238,120 @@ void DustPool::update()
         }
         else if (types[i] == DUST_VAPOUR)
         {
-            emit->setParticleVelocity(vel / 2.0);
+            m_emit_speed[i] = vel / 2.0;
 
             col.a = rates[i] * 0.03;
             col.b = 0.9;
             col.g = 0.9;
             col.r = 0.9;
 
-            emit->setTimeToLive(rates[i] * 0.03 / 0.1);
+            m_emit_ttl[i] = rates[i] * 0.03 / 0.1;
         }
         else if (types[i] == DUST_DRIP)
         {
-            emit->setEmissionRate(rates[i]);
+            m_emit_rate[i] = rates[i];
         }
         else if (types[i] == DUST_SPLASH)
         {
             if (ndir.y < 0)
                 ndir.y = -ndir.y / 2.0;
-
-            emit->setDirection(ndir);
+            m_emit_dir[i] = ndir;
 
             col.a = sqrt(vel) * 0.04;
             col.b = 0.9;
             col.g = 0.9;
             col.r = 0.9;
 
-            emit->setTimeToLive(vel * 0.025 / 0.1);
+            m_emit_ttl[i] = vel * 0.025 / 0.1;
         }
         else if (types[i] == DUST_RIPPLE)
         {
+            // Ripples keep the template's direction and speed, and float on the water
             positions[i].y = RoR::App::GetSimTerrain()->getWater()->GetStaticWaterHeight() - 0.02;
-            sns[i]->setPosition(positions[i]);
+            m_emit_dir[i] = m_default_dir;
+            m_emit_speed[i] = -1.f;
 
             col.a = vel * 0.04;
             col.b = 0.9;
             col.g = 0.9;
             col.r = 0.9;
 
-            emit->setTimeToLive(vel * 0.04 / 0.1);
+            m_emit_ttl[i] = vel * 0.04 / 0.1;
+        }
+
+        m_emit_colour[i] = col;
+    }
+}
+
+void DustPool::emitParticles(int i, float dt)
+{
+    const float wanted = m_emit_rate[i] * dt + m_emit_remainder[i];
+    const int count = static_cast<int>(wanted);
+    m_emit_remainder[i] = wanted - count;
+    if (count <= 0)
+        return;
+
+    m_emitter->setPosition(positions[i]);
+    m_emitter->setDirection(m_emit_dir[i]);
+    m_emitter->setColour(m_emit_colour[i]);
+    if (m_emit_speed[i] < 0.f)
+        m_emitter->setParticleVelocity(m_default_speed_min, m_default_speed_max);
+    else
+        m_emitter->setParticleVelocity(m_emit_speed[i]);
+    if (m_emit_ttl[i] < 0.f)
+        m_emitter->setTimeToLive(m_default_ttl_min, m_default_ttl_max);
+    else
+        m_emitter->setTimeToLive(m_emit_ttl[i]);
+
+    // Same as `ParticleSystem::_executeTriggerEmitters()`, the node sits at origin so no transform is needed
+    const size_t num_affectors = m_psys->getNumAffectors();
+    const float time_inc = dt / count;
+    float time_point = 0.f;
+    for (int k = 0; k < count; k++)
+    {
+        Particle* p = m_psys->createParticle();
+        if (!p)
+            return; // Quota reached
+
+        p->resetDimensions();
+        m_emitter->_initParticle(p);
+        p->mPosition += p->mDirection * time_point;
+        for (size_t a = 0; a < num_affectors; a++)
+        {
+            m_psys->getAffector(a)->_initParticle(p);
+        }
+        m_psys->getRenderer()->_notifyParticleEmitted(p);
+        time_point += time_inc;
+    }
+}
+
+void DustPool::update(float dt)
+{
+    if (!m_emitter)
+    {
+        allocated = 0;
+        return;
+    }
+
+    this->computeEmission();
+    for (int i = 0; i < allocated; i++)
+    {
+        // Carry the fractional particles over only if the slot still holds the same source
+        const Vector3 predicted_pos = m_prev_positions[i] + m_prev_velocities[i] * dt;
+        if (types[i] != m_prev_types[i] ||
+            positions[i].squaredDistance(predicted_pos) > SAME_SOURCE_MAX_DIST * SAME_SOURCE_MAX_DIST)
+        {
+            m_emit_remainder[i] = 0.f;
         }
+        m_prev_positions[i] = positions[i];
+        m_prev_velocities[i] = velocities[i];
+        m_prev_types[i] = types[i];
 
-        emit->setColour(col);
+        this->emitParticles(i, dt);
     }
     for (int i = allocated; i < size; i++)
     {
-        pss[i]->getEmitter(0)->setEnabled(false);
+        m_emit_remainder[i] = 0.f;
     }
     allocated = 0;
 }
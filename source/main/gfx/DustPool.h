@@ -54,10 +54,16 @@ public:
 
     void allocRipple(Ogre::Vector3 pos, Ogre::Vector3 vel);
 
-    void update();
+    void update(float dt);
 
 protected:
 
+    /// Fills the emission arrays for all sources allocated this frame, in one pass.
+    void computeEmission();
+    /// Spawns the particles of one source by re-targeting the shared emitter.
+    void emitParticles(int i, float dt);
+
+
     static const int MAX_DUSTS = 100;
 
     enum DustTypes
@@ -72,15 +78,38 @@ protected:
         DUST_CLUMP
     };
 
+    // Sources allocated this frame
     Ogre::ColourValue colours[MAX_DUSTS];
-    Ogre::ParticleSystem* pss[MAX_DUSTS];
-    Ogre::SceneNode* sns[MAX_DUSTS];
     Ogre::Vector3 positions[MAX_DUSTS];
     Ogre::Vector3 velocities[MAX_DUSTS];
     float rates[MAX_DUSTS];
+    int types[MAX_DUSTS];
     int allocated;
     int size;
-    int types[MAX_DUSTS];
+
+    // Emission parameters, computed from the sources by `computeEmission()`
+    Ogre::Vector3 m_emit_dir[MAX_DUSTS];
+    Ogre::ColourValue m_emit_colour[MAX_DUSTS];
+    float m_emit_speed[MAX_DUSTS];
+    float m_emit_ttl[MAX_DUSTS];       //!< Negative means template default.
+    float m_emit_rate[MAX_DUSTS];
+    float m_emit_remainder[MAX_DUSTS]; //!< Fractional particles carried over to next frame, see `update()`.
+
+    // Source which used the slot last frame - slots are handed out in allocation order, so the source may differ.
+    Ogre::Vector3 m_prev_positions[MAX_DUSTS];
+    Ogre::Vector3 m_prev_velocities[MAX_DUSTS];
+    int m_prev_types[MAX_DUSTS];
+
+    // One particle system for all sources; its emitter is disabled and only used to initialize particles.
+    Ogre::ParticleSystem* m_psys;
+    Ogre::SceneNode* m_snode;
+    Ogre::ParticleEmitter* m_emitter;
+    Ogre::Vector3 m_default_dir;
+    float m_default_speed_min;
+    float m_default_speed_max;
+    float m_default_ttl_min;
+    float m_default_ttl_max;
+    float m_default_rate;
     bool m_is_discarded;
 };
 
@@ -66,6 +66,7 @@ RoR::GfxActor::GfxActor(Actor* actor, ActorSpawner* spawner, std::string ogre_re
     m_prop_anim_crankfactor_prev(0.f),
     m_prop_anim_shift_timer(0.f),
     m_beaconlight_active(true), // 'true' will trigger SetBeaconsEnabled(false) on the first buffer update
+    m_sim_snapshot_ready(false),
     m_initialized(false)
 {
     // Setup particles
@@ -76,10 +77,15 @@ RoR::GfxActor::GfxActor(Actor* actor, ActorSpawner* spawner, std::string ogre_re
     m_particles_sparks = App::GetGfxScene()->GetDustPool("sparks");
     m_particles_clump  = App::GetGfxScene()->GetDustPool("clump");
 
-    m_simbuf.simbuf_nodes.reset(new SimBuffer::NodeSB[actor->ar_num_nodes]);
-    m_simbuf.simbuf_aeroengines.resize(actor->ar_num_aeroengines);
-    m_simbuf.simbuf_commandkey.resize(MAX_COMMANDS + 10);
-    m_simbuf.simbuf_airbrakes.resize(spawner->GetMemoryRequirements().num_airbrakes);
+    SimBuffer* simbufs[2] = { &m_simbuf, &m_simbuf_back };
+    for (int i = 0; i < 2; i++)
+    {
+        m_node_snapshots[i].resize(actor->ar_num_nodes);
+        simbufs[i]->simbuf_nodes = m_node_snapshots[i].data();
+        simbufs[i]->simbuf_aeroengines.resize(actor->ar_num_aeroengines);
+        simbufs[i]->simbuf_commandkey.resize(MAX_COMMANDS + 10);
+        simbufs[i]->simbuf_airbrakes.resize(spawner->GetMemoryRequirements().num_airbrakes);
+    }
 
     // Attributes
     m_attr.xa_speedo_highest_kph = actor->ar_speedo_max_kph; // TODO: Remove the attribute from Actor altogether ~ only_a_ptr, 05/2018
@@ -432,7 +438,7 @@ void RoR::GfxActor::UpdateVideoCameras(float dt_sec)
             vidcam.vcam_render_window->update();
 
         // get the normal of the camera plane now
-        GfxActor::SimBuffer::NodeSB* node_buf = m_simbuf.simbuf_nodes.get();
+        GfxActor::SimBuffer::NodeSB* node_buf = m_simbuf.simbuf_nodes;
         const Ogre::Vector3 abs_pos_center = node_buf[vidcam.vcam_node_center].AbsPosition;
         const Ogre::Vector3 abs_pos_z = node_buf[vidcam.vcam_node_dir_z].AbsPosition;
         const Ogre::Vector3 abs_pos_y = node_buf[vidcam.vcam_node_dir_y].AbsPosition;
@@ -1726,43 +1732,22 @@ void RoR::GfxActor::SetRodsVisible(bool visible)
 
 void RoR::GfxActor::UpdateSimDataBuffer()
 {
-    m_simbuf.simbuf_live_local = (m_actor->ar_sim_state == Actor::SimState::LOCAL_SIMULATED);
-    m_simbuf.simbuf_physics_paused = m_actor->ar_physics_paused;
-    m_simbuf.simbuf_pos = m_actor->GetRotationCenter();
-    m_simbuf.simbuf_rotation = m_actor->getRotation();
-    m_simbuf.simbuf_tyre_pressure = m_actor->GetTyrePressure().GetCurPressure();
-    m_simbuf.simbuf_tyre_pressurizing = m_actor->GetTyrePressure().IsPressurizing();
-    m_simbuf.simbuf_aabb = m_actor->ar_bounding_box;
-    m_simbuf.simbuf_wheel_speed = m_actor->ar_wheel_speed;
-    m_simbuf.simbuf_beaconlight_active = m_actor->m_beacon_light_is_active;
-    m_simbuf.simbuf_cur_cinecam = m_actor->ar_current_cinecam;
-    m_simbuf.simbuf_parking_brake = m_actor->ar_parking_brake;
-    m_simbuf.simbuf_brake = m_actor->ar_brake;
-    m_simbuf.simbuf_hydro_dir_state = m_actor->ar_hydro_dir_state;
-    m_simbuf.simbuf_hydro_aileron_state = m_actor->ar_hydro_aileron_state;
-    m_simbuf.simbuf_hydro_elevator_state = m_actor->ar_hydro_elevator_state;
-    m_simbuf.simbuf_hydro_aero_rudder_state = m_actor->ar_hydro_rudder_state;
-    m_simbuf.simbuf_aero_flap_state = m_actor->ar_aerial_flap;
-    m_simbuf.simbuf_airbrake_state = m_actor->ar_airbrake_intensity;
-    m_simbuf.simbuf_headlight_on = m_actor->ar_lights != 0;
-    m_simbuf.simbuf_direction = m_actor->getDirection();
-    m_simbuf.simbuf_top_speed = m_actor->ar_top_speed;
-    m_simbuf.simbuf_node0_velo = m_actor->ar_nodes[0].Velocity;
-    m_simbuf.simbuf_net_username = m_actor->m_net_username;
-    m_simbuf.simbuf_is_remote = m_actor->ar_sim_state == Actor::SimState::NETWORKED_OK;
-
-    // nodes
-    const int num_nodes = m_actor->ar_num_nodes;
-    for (int i = 0; i < num_nodes; ++i)
+    if (m_sim_snapshot_ready)
     {
-        auto node = m_actor->ar_nodes[i];
-        m_simbuf.simbuf_nodes.get()[i].AbsPosition = node.AbsPosition;
-        m_simbuf.simbuf_nodes.get()[i].nd_has_contact = node.nd_has_ground_contact || node.nd_has_mesh_contact;
+        // Physics already filled the back buffer - just flip.
+        std::swap(m_simbuf, m_simbuf_back);
+        m_sim_snapshot_ready = false;
+    }
+    else
+    {
+        // No physics ran since last update, or nodes were moved by reset/script - copy now.
+        this->FillSimBuffer(m_simbuf);
     }
 
+    // Gfx-side data, updated on main thread
     for (NodeGfx& nx: m_gfx_nodes)
     {
-        m_simbuf.simbuf_nodes.get()[nx.nx_node_idx].nd_is_wet = (nx.nx_wet_time_sec != -1.f);
+        m_simbuf.simbuf_nodes[nx.nx_node_idx].nd_is_wet = (nx.nx_wet_time_sec != -1.f);
     }
 
     // beams
@@ -1778,99 +1763,144 @@ void RoR::GfxActor::UpdateSimDataBuffer()
         rod.rod_is_visible = !beam.bm_disabled && !beam.bm_broken;
     }
 
+    // Linked Actors
+    m_linked_gfx_actors.clear();
+    for (auto actor : m_actor->GetAllLinkedActors())
+    {
+        m_linked_gfx_actors.insert(actor->GetGfxActor());
+    }
+}
+
+void RoR::GfxActor::FillSimBuffer(SimBuffer& dst)
+{
+    dst.simbuf_live_local = (m_actor->ar_sim_state == Actor::SimState::LOCAL_SIMULATED);
+    dst.simbuf_physics_paused = m_actor->ar_physics_paused;
+    dst.simbuf_pos = m_actor->GetRotationCenter();
+    dst.simbuf_rotation = m_actor->getRotation();
+    dst.simbuf_tyre_pressure = m_actor->GetTyrePressure().GetCurPressure();
+    dst.simbuf_tyre_pressurizing = m_actor->GetTyrePressure().IsPressurizing();
+    dst.simbuf_aabb = m_actor->ar_bounding_box;
+    dst.simbuf_wheel_speed = m_actor->ar_wheel_speed;
+    dst.simbuf_beaconlight_active = m_actor->m_beacon_light_is_active;
+    dst.simbuf_cur_cinecam = m_actor->ar_current_cinecam;
+    dst.simbuf_parking_brake = m_actor->ar_parking_brake;
+    dst.simbuf_brake = m_actor->ar_brake;
+    dst.simbuf_hydro_dir_state = m_actor->ar_hydro_dir_state;
+    dst.simbuf_hydro_aileron_state = m_actor->ar_hydro_aileron_state;
+    dst.simbuf_hydro_elevator_state = m_actor->ar_hydro_elevator_state;
+    dst.simbuf_hydro_aero_rudder_state = m_actor->ar_hydro_rudder_state;
+    dst.simbuf_aero_flap_state = m_actor->ar_aerial_flap;
+    dst.simbuf_airbrake_state = m_actor->ar_airbrake_intensity;
+    dst.simbuf_headlight_on = m_actor->ar_lights != 0;
+    dst.simbuf_direction = m_actor->getDirection();
+    dst.simbuf_top_speed = m_actor->ar_top_speed;
+    dst.simbuf_node0_velo = m_actor->ar_nodes[0].Velocity;
+    dst.simbuf_net_username = m_actor->m_net_username;
+    dst.simbuf_is_remote = m_actor->ar_sim_state == Actor::SimState::NETWORKED_OK;
+
+    // nodes
+    const node_t* src_nodes = m_actor->ar_nodes;
+    const int num_nodes = m_actor->ar_num_nodes;
+    for (int i = 0; i < num_nodes; ++i)
+    {
+        dst.simbuf_nodes[i].AbsPosition = src_nodes[i].AbsPosition;
+        dst.simbuf_nodes[i].nd_has_contact = src_nodes[i].nd_has_ground_contact || src_nodes[i].nd_has_mesh_contact;
+        dst.simbuf_nodes[i].nd_is_wet = false; // Filled from `m_gfx_nodes` on main thread
+    }
+
     // airbrakes
     const size_t num_airbrakes = m_actor->ar_airbrakes.size();
     for (size_t i=0; i< num_airbrakes; ++i)
     {
-        m_simbuf.simbuf_airbrakes[i].simbuf_ab_ratio = m_actor->ar_airbrakes[i]->ratio;
+        dst.simbuf_airbrakes[i].simbuf_ab_ratio = m_actor->ar_airbrakes[i]->ratio;
     }
 
     // Engine (+drivetrain)
     if (m_actor->ar_engine != nullptr)
     {
-        m_simbuf.simbuf_gear            = m_actor->ar_engine->GetGear();
-        m_simbuf.simbuf_autoshift       = m_actor->ar_engine->getAutoShift();
-        m_simbuf.simbuf_engine_rpm      = m_actor->ar_engine->GetEngineRpm();
-        m_simbuf.simbuf_engine_turbo_psi= m_actor->ar_engine->GetTurboPsi();
-        m_simbuf.simbuf_engine_accel    = m_actor->ar_engine->GetAcceleration();
-        m_simbuf.simbuf_engine_torque   = m_actor->ar_engine->GetEngineTorque();
-        m_simbuf.simbuf_inputshaft_rpm  = m_actor->ar_engine->GetInputShaftRpm();
-        m_simbuf.simbuf_drive_ratio     = m_actor->ar_engine->GetDriveRatio();
-        m_simbuf.simbuf_clutch          = m_actor->ar_engine->GetClutch();
+        dst.simbuf_gear            = m_actor->ar_engine->GetGear();
+        dst.simbuf_autoshift       = m_actor->ar_engine->getAutoShift();
+        dst.simbuf_engine_rpm      = m_actor->ar_engine->GetEngineRpm();
+        dst.simbuf_engine_turbo_psi= m_actor->ar_engine->GetTurboPsi();
+        dst.simbuf_engine_accel    = m_actor->ar_engine->GetAcceleration();
+        dst.simbuf_engine_torque   = m_actor->ar_engine->GetEngineTorque();
+        dst.simbuf_inputshaft_rpm  = m_actor->ar_engine->GetInputShaftRpm();
+        dst.simbuf_drive_ratio     = m_actor->ar_engine->GetDriveRatio();
+        dst.simbuf_clutch          = m_actor->ar_engine->GetClutch();
     }
     if (m_actor->m_num_wheel_diffs > 0)
     {
-        m_simbuf.simbuf_diff_type = m_actor->m_wheel_diffs[0]->GetActiveDiffType();
+        dst.simbuf_diff_type = m_actor->m_wheel_diffs[0]->GetActiveDiffType();
     }
 
     // Command keys
     const int num_commandkeys = MAX_COMMANDS + 10;
     for (int i = 0; i < num_commandkeys; ++i)
     {
-        m_simbuf.simbuf_commandkey[i].simbuf_cmd_value = m_actor->ar_command_key[i].commandValue;
+        dst.simbuf_commandkey[i].simbuf_cmd_value = m_actor->ar_command_key[i].commandValue;
     }
 
     // Aeroengines
     for (int i = 0; i < m_actor->ar_num_aeroengines; ++i)
     {
         AeroEngine* src = m_actor->ar_aeroengines[i];
-        SimBuffer::AeroEngineSB& dst = m_simbuf.simbuf_aeroengines[i];
+        SimBuffer::AeroEngineSB& ae_dst = dst.simbuf_aeroengines[i];
 
-        dst.simbuf_ae_throttle   = src->getThrottle();
-        dst.simbuf_ae_rpm        = src->getRPM();
-        dst.simbuf_ae_rpmpc      = src->getRPMpc();
-        dst.simbuf_ae_rpm        = src->getRPM();
-        dst.simbuf_ae_turboprop  = (src->getType() == AeroEngine::AEROENGINE_TYPE_TURBOPROP);
-        dst.simbuf_ae_ignition   = src->getIgnition();
-        dst.simbuf_ae_failed     = src->isFailed();
+        ae_dst.simbuf_ae_throttle   = src->getThrottle();
+        ae_dst.simbuf_ae_rpm        = src->getRPM();
+        ae_dst.simbuf_ae_rpmpc      = src->getRPMpc();
+        ae_dst.simbuf_ae_rpm        = src->getRPM();
+        ae_dst.simbuf_ae_turboprop  = (src->getType() == AeroEngine::AEROENGINE_TYPE_TURBOPROP);
+        ae_dst.simbuf_ae_ignition   = src->getIgnition();
+        ae_dst.simbuf_ae_failed     = src->isFailed();
 
-        if (dst.simbuf_ae_turboprop)
+        if (ae_dst.simbuf_ae_turboprop)
         {
             Turboprop* tp = static_cast<Turboprop*>(src);
-            dst.simbuf_tp_aetorque = (100.0 * tp->indicated_torque / tp->max_torque); // TODO: Code ported as-is from calcAnimators(); what does it do? ~ only_a_ptr, 06/2018
-            dst.simbuf_tp_aepitch = tp->pitch;
+            ae_dst.simbuf_tp_aetorque = (100.0 * tp->indicated_torque / tp->max_torque); // TODO: Code ported as-is from calcAnimators(); what does it do? ~ only_a_ptr, 06/2018
+            ae_dst.simbuf_tp_aepitch = tp->pitch;
         }
         else // turbojet
         {
             Turbojet* tj = static_cast<Turbojet*>(src);
-            dst.simbuf_tj_afterburn = tj->getAfterburner() != 0.f;
-            dst.simbuf_tj_ab_thrust = tj->getAfterburnThrust();
-            dst.simbuf_tj_exhaust_velo = tj->getExhaustVelocity();
+            ae_dst.simbuf_tj_afterburn = tj->getAfterburner() != 0.f;
+            ae_dst.simbuf_tj_ab_thrust = tj->getAfterburnThrust();
+            ae_dst.simbuf_tj_exhaust_velo = tj->getExhaustVelocity();
         }
     }
 
     // Wings
     if (m_actor->ar_num_wings > 4)
     {
-        m_simbuf.simbuf_wing4_aoa = m_actor->ar_wings[4].fa->aoa;
+        dst.simbuf_wing4_aoa = m_actor->ar_wings[4].fa->aoa;
     }
     else
     {
-        m_simbuf.simbuf_wing4_aoa = 0.f;
+        dst.simbuf_wing4_aoa = 0.f;
     }
 
     // Autopilot
     if (m_attr.xa_has_autopilot)
     {
-        m_simbuf.simbuf_ap_heading_mode  = m_actor->ar_autopilot->GetHeadingMode();
-        m_simbuf.simbuf_ap_heading_value = m_actor->ar_autopilot->heading;
-        m_simbuf.simbuf_ap_alt_mode      = m_actor->ar_autopilot->GetAltMode();
-        m_simbuf.simbuf_ap_alt_value     = m_actor->ar_autopilot->GetAltValue();
-        m_simbuf.simbuf_ap_ias_mode      = m_actor->ar_autopilot->GetIasMode();
-        m_simbuf.simbuf_ap_ias_value     = m_actor->ar_autopilot->GetIasValue();
-        m_simbuf.simbuf_ap_gpws_mode     = m_actor->ar_autopilot->GetGpwsMode();
-        m_simbuf.simbuf_ap_ils_available = m_actor->ar_autopilot->IsIlsAvailable();
-        m_simbuf.simbuf_ap_ils_vdev      = m_actor->ar_autopilot->GetVerticalApproachDeviation();
-        m_simbuf.simbuf_ap_ils_hdev      = m_actor->ar_autopilot->GetHorizontalApproachDeviation();
-        m_simbuf.simbuf_ap_vs_value      = m_actor->ar_autopilot->GetVsValue();
+        dst.simbuf_ap_heading_mode  = m_actor->ar_autopilot->GetHeadingMode();
+        dst.simbuf_ap_heading_value = m_actor->ar_autopilot->heading;
+        dst.simbuf_ap_alt_mode      = m_actor->ar_autopilot->GetAltMode();
+        dst.simbuf_ap_alt_value     = m_actor->ar_autopilot->GetAltValue();
+        dst.simbuf_ap_ias_mode      = m_actor->ar_autopilot->GetIasMode();
+        dst.simbuf_ap_ias_value     = m_actor->ar_autopilot->GetIasValue();
+        dst.simbuf_ap_gpws_mode     = m_actor->ar_autopilot->GetGpwsMode();
+        dst.simbuf_ap_ils_available = m_actor->ar_autopilot->IsIlsAvailable();
+        dst.simbuf_ap_ils_vdev      = m_actor->ar_autopilot->GetVerticalApproachDeviation();
+        dst.simbuf_ap_ils_hdev      = m_actor->ar_autopilot->GetHorizontalApproachDeviation();
+        dst.simbuf_ap_vs_value      = m_actor->ar_autopilot->GetVsValue();
     }
+}
 
-    // Linked Actors
-    m_linked_gfx_actors.clear();
-    for (auto actor : m_actor->GetAllLinkedActors())
-    {
-        m_linked_gfx_actors.insert(actor->GetGfxActor());
-    }
+void RoR::GfxActor::UpdateSimSnapshot()
+{
+    // Runs on physics worker; gfx is meanwhile reading the front buffer.
+    this->FillSimBuffer(m_simbuf_back);
+    m_sim_snapshot_ready = true;
 }
 
 bool RoR::GfxActor::IsActorLive() const
@@ -1897,28 +1927,17 @@ void RoR::GfxActor::SetWheelVisuals(uint16_t index, WheelGfx wheel_gfx)
 
 void RoR::GfxActor::UpdateWheelVisuals()
 {
-    m_flexwheel_tasks.clear();
-
     for (WheelGfx& w: m_wheels)
     {
         if (w.wx_flex_mesh != nullptr && w.wx_flex_mesh->flexitPrepare())
         {
-            auto func = std::function<void()>([this, w]()
-                {
-                    w.wx_flex_mesh->flexitCompute();
-                });
-            auto task_handle = App::GetThreadPool()->RunTask(func);
-            m_flexwheel_tasks.push_back(task_handle);
+            App::GetGfxScene()->QueueFlexwheelJob(w.wx_flex_mesh);
         }
     }
 }
 
 void RoR::GfxActor::FinishWheelUpdates()
 {
-    for (auto& task: m_flexwheel_tasks)
-    {
-        task->join();
-    }
     for (WheelGfx& w: m_wheels)
     {
         if (w.wx_scenenode != nullptr && w.wx_flex_mesh != nullptr)
@@ -3134,19 +3153,41 @@ void RoR::GfxActor::SortFlexbodies()
 
 void RoR::GfxActor::UpdateFlexbodies()
 {
-    m_flexbody_tasks.clear();
+    // Level of detail: full deformation up close, reduced rate with distance,
+    // rigid movement only when far away or out of view.
+    const bool lod_enabled = App::gfx_flexbody_lod->GetBool();
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+    const float lod_near = App::gfx_flexbody_lod_near->GetFloat();
+    const float lod_far = std::max(lod_near, App::gfx_flexbody_lod_far->GetFloat());
+    const float distance = camera->getDerivedPosition().distance(m_simbuf.simbuf_pos);
 
     for (FlexBody* fb: m_flexbodies)
     {
         const int camera_mode = fb->getCameraMode();
         if ((camera_mode == -2) || (camera_mode == m_simbuf.simbuf_cur_cinecam))
         {
-            auto func = std::function<void()>([fb]()
+            if (lod_enabled && camera_mode == -2 && fb->IsDeformed()) // Cinecam-specific meshes are always close-up
+            {
+                // Shadow casters can be seen through their shadow even when out of view
+                const bool offscreen = !fb->IsCastingShadows() && !camera->isVisible(fb->GetWorldBounds());
+                if (distance > lod_far || offscreen)
+                {
+                    fb->ComputeFlexbodyRigid();
+                    continue;
+                }
+                if (distance > lod_near)
                 {
-                    fb->ComputeFlexbody();
-                });
-            auto task_handle = App::GetThreadPool()->RunTask(func);
-            m_flexbody_tasks.push_back(task_handle);
+                    const float ratio = (distance - lod_near) / std::max(lod_far - lod_near, 1.f);
+                    const int interval = 1 + static_cast<int>(ratio * App::gfx_flexbody_lod_max_skip->GetInt());
+                    if (!fb->IsLodUpdateDue(interval))
+                    {
+                        fb->ComputeFlexbodyRigid();
+                        continue;
+                    }
+                }
+            }
+
+            App::GetGfxScene()->QueueFlexbodyJob(fb);
         }
         else
         {
@@ -3173,10 +3214,6 @@ void RoR::GfxActor::SetFlexbodyVisible(bool visible)
 
 void RoR::GfxActor::FinishFlexbodyTasks()
 {
-    for (auto& task: m_flexbody_tasks)
-    {
-        task->join();
-    }
     for (FlexBody* fb: m_flexbodies)
     {
         fb->UpdateFlexbodyVertexBuffers();
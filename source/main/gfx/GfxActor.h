@@ -111,7 +111,7 @@ public:
             float simbuf_ab_ratio;
         };
 
-        std::unique_ptr<NodeSB>     simbuf_nodes;
+        NodeSB*                     simbuf_nodes              = nullptr; //!< One of `GfxActor::m_node_snapshots`, swapped along with the `SimBuffer`
         Ogre::Vector3               simbuf_pos                = Ogre::Vector3::ZERO;
         Ogre::Vector3               simbuf_node0_velo         = Ogre::Vector3::ZERO;
         bool                        simbuf_live_local         = false;
@@ -201,13 +201,15 @@ public:
     bool                      IsActorLive        () const; //!< Should the visuals be updated for this actor?
     bool                      IsActorInitialized () const  { return m_initialized; } //!< Temporary TODO: Remove once the spawn routine is fixed
     void                      InitializeActor    ()        { m_initialized = true; } //!< Temporary TODO: Remove once the spawn routine is fixed
-    void                      UpdateSimDataBuffer(); //!< Copies sim. data from `Actor` to `GfxActor` for later update
+    void                      UpdateSimDataBuffer(); //!< Flips the sim. data snapshot (or copies it from `Actor` if there's none) for later update
+    void                      UpdateSimSnapshot  (); //!< Fills the back `SimBuffer`; Run on physics worker after last substep
+    void                      InvalidateSimSnapshot() { m_sim_snapshot_ready = false; } //!< Actor was changed outside physics; refill synchronously
     void                      SetWheelVisuals    (uint16_t index, WheelGfx wheel_gfx);
     void                      CalculateDriverPos (Ogre::Vector3& out_pos, Ogre::Quaternion& out_rot);
-    void                      UpdateWheelVisuals ();
+    void                      UpdateWheelVisuals (); //!< Queues flexwheel jobs, see `GfxScene::StartDeformationJobs()`
     void                      FinishWheelUpdates ();
-    void                      UpdateFlexbodies   ();
-    void                      FinishFlexbodyTasks();
+    void                      UpdateFlexbodies   (); //!< Queues flexbody jobs, see `GfxScene::StartDeformationJobs()`
+    void                      FinishFlexbodyTasks(); //!< Uploads vertex buffers; run after `GfxScene::FinishDeformationJobs()`
     void                      SetFlexbodyVisible (bool visible);
     void                      SetWheelsVisible   (bool value);
     void                      SetAllMeshesVisible(bool value);
@@ -237,7 +239,7 @@ public:
     inline VideoCamState      GetVideoCamState   () const                 { return m_vidcam_state; }
     inline DebugViewType      GetDebugView       () const                 { return m_debug_view; }
     SimBuffer &               GetSimDataBuffer   ()                       { return m_simbuf; }
-    SimBuffer::NodeSB*        GetSimNodeBuffer   ()                       { return m_simbuf.simbuf_nodes.get(); }
+    SimBuffer::NodeSB*        GetSimNodeBuffer   ()                       { return m_simbuf.simbuf_nodes; }
     std::set<GfxActor*>       GetLinkedGfxActors ()                       { return m_linked_gfx_actors; }
     Ogre::String              GetResourceGroup   ()                       { return m_custom_resource_group; }
     std::string               FetchActorDesignName() const;
@@ -259,6 +261,7 @@ public:
 private:
 
     static Ogre::Quaternion SpecialGetRotationTo(const Ogre::Vector3& src, const Ogre::Vector3& dest);
+    void                    FillSimBuffer(SimBuffer& dst); //!< Reads `Actor` only, doesn't touch gfx-side data
 
     Actor*                      m_actor;
 
@@ -284,8 +287,6 @@ private:
     std::vector<WheelGfx>       m_wheels;
     Ogre::SceneNode*            m_rods_parent_scenenode;
     RoR::Renderdash*            m_renderdash;
-    std::vector<std::shared_ptr<Task>> m_flexwheel_tasks;
-    std::vector<std::shared_ptr<Task>> m_flexbody_tasks;
     bool                        m_beaconlight_active;
     float                       m_prop_anim_crankfactor_prev;
     float                       m_prop_anim_shift_timer;
@@ -294,7 +295,12 @@ private:
 
     bool                        m_initialized;
 
-    SimBuffer                   m_simbuf;
+    SimBuffer                   m_simbuf;      //!< Front buffer, read by gfx
+    SimBuffer                   m_simbuf_back; //!< Filled by physics worker, see `UpdateSimSnapshot()`
+
+    // Double-buffered sim data: physics writes the back buffer while gfx reads the front one.
+    std::vector<SimBuffer::NodeSB> m_node_snapshots[2]; //!< Storage for `SimBuffer::simbuf_nodes`
+    bool                        m_sim_snapshot_ready; //!< Back buffer was filled by physics and the actor wasn't changed since
 
     // Old cab mesh
     FlexObj*                    m_cab_mesh;
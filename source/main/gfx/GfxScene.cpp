@@ -26,16 +26,20 @@
 #include "ActorManager.h"
 #include "Console.h"
 #include "DustPool.h"
+#include "Flexable.h"
+#include "FlexBody.h"
 #include "HydraxWater.h"
 #include "GameContext.h"
 #include "GUIManager.h"
 #include "GUI_DirectionArrow.h"
 #include "OverlayWrapper.h"
+#include "Profiler.h"
 #include "SkyManager.h"
 #include "SkyXManager.h"
 #include "TerrainGeometryManager.h"
 #include "TerrainManager.h"
 #include "TerrainObjectManager.h"
+#include "ThreadPool.h"
 
 #include <Ogre.h>
 
@@ -63,6 +67,13 @@ void GfxScene::ClearScene()
     }
     m_dustpools.clear();
 
+    // Delete skidmarks
+    for (SkidmarkBatch* batch: m_skidmark_batches)
+    {
+        delete batch;
+    }
+    m_skidmark_batches.clear();
+
     // Delete game elements
     m_all_gfx_actors.clear();
     m_all_gfx_characters.clear();
@@ -85,12 +96,15 @@ void RoR::GfxScene::Init()
 
 void RoR::GfxScene::UpdateScene(float dt_sec)
 {
+    ROR_PROFILE_ZONE("GfxScene::UpdateScene");
+
     // Actors - start threaded tasks
     for (GfxActor* gfx_actor: m_live_gfx_actors)
     {
-        gfx_actor->UpdateFlexbodies(); // Push flexbody tasks to threadpool
-        gfx_actor->UpdateWheelVisuals(); // Push flexwheel tasks to threadpool
+        gfx_actor->UpdateFlexbodies(); // Queue flexbody jobs
+        gfx_actor->UpdateWheelVisuals(); // Queue flexwheel jobs
     }
+    this->StartDeformationJobs(); // Push all queued jobs to threadpool
 
     // Var
     GfxActor* player_gfx_actor = nullptr;
@@ -121,7 +135,16 @@ void RoR::GfxScene::UpdateScene(float dt_sec)
         }
         for (auto itor : m_dustpools)
         {
-            itor.second->update();
+            itor.second->update(dt_sec);
+        }
+    }
+
+    // Skidmarks
+    for (SkidmarkBatch* batch: m_skidmark_batches)
+    {
+        if (batch)
+        {
+            batch->UploadChanges();
         }
     }
 
@@ -145,7 +168,7 @@ void RoR::GfxScene::UpdateScene(float dt_sec)
     {
         if (player_gfx_actor != nullptr)
         {
-            water->SetReflectionPlaneHeight(water->CalcWavesHeight(player_gfx_actor->GetSimDataBuffer().simbuf_pos));
+            water->SetReflectionPlaneHeight(water->CalcWavesHeight(player_gfx_actor->GetSimDataBuffer().simbuf_pos, IWater::GetWavesClock()));
         }
         else
         {
@@ -210,6 +233,7 @@ void RoR::GfxScene::UpdateScene(float dt_sec)
         bool is_player_connected = (player_connected_gfx_actors.find(gfx_actor) != player_connected_gfx_actors.end());
         if (gfx_actor->IsActorLive())
         {
+            ROR_PROFILE_ZONE_ID("GfxActor visuals", gfx_actor->GetActorId());
             gfx_actor->UpdateRods();
             gfx_actor->UpdateCabMesh();
             gfx_actor->UpdateWingMeshes();
@@ -239,11 +263,16 @@ void RoR::GfxScene::UpdateScene(float dt_sec)
         }
     }
 
-    App::GetGuiManager()->DrawSimGuiBuffered(player_gfx_actor);
+    {
+        ROR_PROFILE_ZONE("GUI");
+        App::GetGuiManager()->DrawSimGuiBuffered(player_gfx_actor);
+    }
 
     App::GetGameContext()->GetSceneMouse().UpdateVisuals();
 
     // Actors - finalize threaded tasks
+    ROR_PROFILE_ZONE("Finish flexbody jobs");
+    this->FinishDeformationJobs();
     for (GfxActor* gfx_actor: m_live_gfx_actors)
     {
         gfx_actor->FinishWheelUpdates();
@@ -251,6 +280,87 @@ void RoR::GfxScene::UpdateScene(float dt_sec)
     }
 }
 
+SkidmarkBatch* RoR::GfxScene::GetSkidmarkBatch(int texture_id)
+{
+    if (texture_id >= (int)m_skidmark_batches.size())
+    {
+        m_skidmark_batches.resize(texture_id + 1, nullptr);
+    }
+    if (!m_skidmark_batches[texture_id])
+    {
+        m_skidmark_batches[texture_id] = new SkidmarkBatch(
+            m_skidmark_conf.GetTextureName(texture_id), texture_id, SkidmarkBatch::DEFAULT_MAX_QUADS);
+    }
+    return m_skidmark_batches[texture_id];
+}
+
+void RoR::GfxScene::QueueFlexbodyJob(FlexBody* fb)
+{
+    DeformationJob job;
+    job.dj_flexbody = fb;
+    job.dj_cost = fb->size();
+    m_deform_jobs.push_back(job);
+}
+
+void RoR::GfxScene::QueueFlexwheelJob(Flexable* fw)
+{
+    DeformationJob job;
+    job.dj_flexwheel = fw;
+    job.dj_cost = fw->size();
+    m_deform_jobs.push_back(job);
+}
+
+void RoR::GfxScene::StartDeformationJobs()
+{
+    if (m_deform_jobs.empty())
+        return;
+
+    // Largest first, then always fill the least loaded chunk (greedy balancing by vertex count).
+    std::sort(m_deform_jobs.begin(), m_deform_jobs.end(),
+        [](DeformationJob const& a, DeformationJob const& b) { return a.dj_cost > b.dj_cost; });
+
+    const size_t num_chunks = std::min(m_deform_jobs.size(), static_cast<size_t>(std::max(1, App::app_num_workers->GetInt())));
+    m_deform_chunks.resize(num_chunks);
+    std::vector<int> chunk_costs(num_chunks, 0);
+    for (auto& chunk: m_deform_chunks)
+    {
+        chunk.clear();
+    }
+    for (DeformationJob const& job: m_deform_jobs)
+    {
+        const size_t idx = std::min_element(chunk_costs.begin(), chunk_costs.end()) - chunk_costs.begin();
+        m_deform_chunks[idx].push_back(job);
+        chunk_costs[idx] += job.dj_cost;
+    }
+    m_deform_jobs.clear();
+
+    for (auto& chunk: m_deform_chunks)
+    {
+        std::vector<DeformationJob>* jobs = &chunk;
+        auto func = std::function<void()>([jobs]()
+            {
+                ROR_PROFILE_ZONE("Flexbody jobs");
+                for (DeformationJob const& job: *jobs)
+                {
+                    if (job.dj_flexbody != nullptr)
+                        job.dj_flexbody->ComputeFlexbody();
+                    else
+                        job.dj_flexwheel->flexitCompute();
+                }
+            });
+        m_deform_tasks.push_back(App::GetThreadPool()->RunTask(func));
+    }
+}
+
+void RoR::GfxScene::FinishDeformationJobs()
+{
+    for (auto& task: m_deform_tasks)
+    {
+        task->join();
+    }
+    m_deform_tasks.clear();
+}
+
 void RoR::GfxScene::SetParticlesVisible(bool visible)
 {
     for (auto itor : m_dustpools)
@@ -33,6 +33,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace RoR {
 
@@ -76,12 +77,31 @@ public:
     SimBuffer&     GetSimDataBuffer() { return m_simbuf; }
     GfxEnvmap&     GetEnvMap() { return m_envmap; }
     RoR::SkidmarkConfig* GetSkidmarkConf () { return &m_skidmark_conf; }
+    SkidmarkBatch* GetSkidmarkBatch(int texture_id); //!< Creates the batch on first use
+    std::vector<SkidmarkBatch*>& GetSkidmarkBatches() { return m_skidmark_batches; }
     Ogre::SceneManager* GetSceneManager() { return m_scene_manager; }
     std::vector<GfxActor*>& GetGfxActors() { return m_all_gfx_actors; }
     std::vector<GfxCharacter*>& GetGfxCharacters() { return m_all_gfx_characters; }
 
+    // Scene-wide flexbody/flexwheel deformation jobs
+    void           QueueFlexbodyJob(FlexBody* fb);
+    void           QueueFlexwheelJob(Flexable* fw);
+    void           StartDeformationJobs(); //!< Splits queued jobs into cost-balanced chunks and pushes them to threadpool
+    void           FinishDeformationJobs(); //!< Waits for all chunks; must be called before uploading vertex buffers
+
 private:
 
+    struct DeformationJob
+    {
+        FlexBody*  dj_flexbody  = nullptr;
+        Flexable*  dj_flexwheel = nullptr;
+        int        dj_cost      = 0; //!< Vertex count
+    };
+
+    std::vector<DeformationJob>       m_deform_jobs;
+    std::vector<std::vector<DeformationJob>> m_deform_chunks;
+    std::vector<std::shared_ptr<Task>> m_deform_tasks;
+
     std::map<std::string, DustPool *> m_dustpools;
     Ogre::SceneManager*               m_scene_manager = nullptr;
     std::vector<GfxActor*>            m_all_gfx_actors;
@@ -90,6 +110,7 @@ private:
     RoR::GfxEnvmap                    m_envmap;
     SimBuffer                         m_simbuf;
     SkidmarkConfig                    m_skidmark_conf;
+    std::vector<SkidmarkBatch*>       m_skidmark_batches; //!< Indexed by texture ID
 };
 
 } // namespace RoR
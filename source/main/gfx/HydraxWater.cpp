@@ -38,7 +38,6 @@ HydraxWater::HydraxWater(float water_height, Ogre::String conf_file):
     waternoise(0)
     , mHydrax(0)
     , waterHeight(water_height)
-    , waveHeight(water_height)
     , CurrentConfigFile(conf_file)
 {
     App::GetCameraManager()->GetCamera()->setNearClipDistance(0.1f);
@@ -86,9 +85,9 @@ void HydraxWater::InitHydrax()
     mHydrax->setPosition(Ogre::Vector3(0, waterHeight, 0));
 }
 
-bool HydraxWater::IsUnderWater(Ogre::Vector3 pos)
+bool HydraxWater::IsUnderWater(Ogre::Vector3 pos, float time_sec)
 {
-    if (pos.y < CalcWavesHeight(Ogre::Vector3(pos.x, pos.y, pos.z)))
+    if (pos.y < CalcWavesHeight(Ogre::Vector3(pos.x, pos.y, pos.z), time_sec))
         return true;
     return false;
 }
@@ -123,17 +122,27 @@ void HydraxWater::SetWaterVisible(bool value)
         mHydrax->setVisible(value);
 }
 
-float HydraxWater::CalcWavesHeight(Vector3 pos)
+// Hydrax animates its noise itself, see `FrameStepWater()`; `time_sec` is not used.
+
+float HydraxWater::CalcWavesHeight(Vector3 pos, float time_sec)
 {
     if (!RoR::App::gfx_water_waves->GetBool())
     {
         return waterHeight;
     }
-    waveHeight = mHydrax->getHeigth(pos);
-    return waveHeight;
+    return mHydrax->getHeigth(pos);
+}
+
+void HydraxWater::CalcWavesHeightBatch(const Vector3* pos, float* out_heights, size_t count, float time_sec)
+{
+    const bool waves_enabled = RoR::App::gfx_water_waves->GetBool();
+    for (size_t i = 0; i < count; i++)
+    {
+        out_heights[i] = (waves_enabled) ? mHydrax->getHeigth(pos[i]) : waterHeight;
+    }
 }
 
-Vector3 HydraxWater::CalcWavesVelocity(Vector3 pos)
+Vector3 HydraxWater::CalcWavesVelocity(Vector3 pos, float time_sec)
 {
     if (!RoR::App::gfx_water_waves->GetBool())
         return Vector3(0, 0, 0);
@@ -38,11 +38,12 @@ public:
     // Interface IWater
     float          GetStaticWaterHeight() override;
     void           SetStaticWaterHeight(float value) override;
-    float          CalcWavesHeight(Ogre::Vector3 pos) override;
-    Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos) override;
+    float          CalcWavesHeight(Ogre::Vector3 pos, float time_sec) override;
+    Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos, float time_sec) override;
+    void           CalcWavesHeightBatch(const Ogre::Vector3* pos, float* out_heights, size_t count, float time_sec) override;
     void           SetWaterVisible(bool value) override;
     void           WaterSetSunPosition(Ogre::Vector3) override;
-    bool           IsUnderWater(Ogre::Vector3 pos) override;
+    bool           IsUnderWater(Ogre::Vector3 pos, float time_sec) override;
     void           FrameStepWater(float dt) override;
     void           UpdateWater() override;
 
@@ -52,7 +53,6 @@ protected:
 
     void InitHydrax();
     Hydrax::Hydrax* mHydrax;
-    float waveHeight;
     float waterHeight;
     Hydrax::Noise::Perlin* waternoise;
     Hydrax::Module::ProjectedGrid* mModule;
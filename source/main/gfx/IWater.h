@@ -23,6 +23,7 @@
 
 #include "ForwardDeclarations.h"
 #include <Ogre.h>
+#include <limits>
 
 namespace RoR {
 
@@ -40,11 +41,19 @@ public:
     virtual float          GetStaticWaterHeight() = 0; //!< Returns static water level configured in 'terrn2'
     virtual void           SetStaticWaterHeight(float value) = 0;
     virtual void           SetWaterBottomHeight(float value) {};
-    virtual float          CalcWavesHeight(Ogre::Vector3 pos) = 0;
-    virtual Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos) = 0;
+    // Wave queries take the wave clock explicitly: the physics passes the time of its substep (it runs on its own thread),
+    // everything else passes `GetWavesClock()`.
+    virtual float          CalcWavesHeight(Ogre::Vector3 pos, float time_sec) = 0;
+    virtual Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos, float time_sec) = 0;
+    virtual float          GetWavesMaxAmplitude() { return std::numeric_limits<float>::max(); } //!< Upper bound of `|CalcWavesHeight() - GetStaticWaterHeight()|`
+    virtual void           CalcWavesHeightBatch(const Ogre::Vector3* pos, float* out_heights, size_t count, float time_sec)
+    {
+        for (size_t i = 0; i < count; i++)
+            out_heights[i] = this->CalcWavesHeight(pos[i], time_sec);
+    }
     virtual void           SetWaterVisible(bool value) = 0;
     virtual void           WaterSetSunPosition(Ogre::Vector3) {}
-    virtual bool           IsUnderWater(Ogre::Vector3 pos) = 0;
+    virtual bool           IsUnderWater(Ogre::Vector3 pos, float time_sec) = 0;
     virtual void           FrameStepWater(float dt) = 0;
     virtual void           SetReflectionPlaneHeight(float centerheight) {}
     virtual void           UpdateReflectionPlane(float h) {}
@@ -54,6 +63,8 @@ public:
     // Only used by class Water for SurveyMap texture creation
     virtual void           SetForcedCameraTransform(Ogre::Radian fovy, Ogre::Vector3 pos, Ogre::Quaternion rot) {};
     virtual void           ClearForcedCameraTransform() {};
+
+    static float           GetWavesClock() { return (float)(Ogre::Root::getSingleton().getTimer()->getMilliseconds() * 0.001); } //!< Wall time, seconds
 };
 
 } // namespace RoR
@@ -65,6 +65,8 @@ void RoR::SkidmarkConfig::LoadDefaultSkidmarkDefs()
         RoR::LogFormat("[RoR] Error loading skidmarks.cfg (%s)", e.getFullDescription().c_str());
         m_models.clear(); // Delete anything we might have loaded
     }
+    m_ground_model_ids.clear(); // Resolve again with the new defs
+    m_ground_model_defs.clear();
 }
 
 int RoR::SkidmarkConfig::ProcessSkidmarkConfLine(Ogre::StringVector args, Ogre::String modelName)
@@ -77,71 +79,69 @@ int RoR::SkidmarkConfig::ProcessSkidmarkConfLine(Ogre::StringVector args, Ogre::
     SkidmarkDef cfg;
     cfg.ground = args[0];
     Ogre::StringUtil::trim(cfg.ground);
-    cfg.texture = args[1];
-    Ogre::StringUtil::trim(cfg.texture);
+    Ogre::String texture = args[1];
+    Ogre::StringUtil::trim(texture);
+    cfg.textureId = this->InternTexture(texture);
 
     cfg.slipFrom = Ogre::StringConverter::parseReal(args[2]);
     cfg.slipTo = Ogre::StringConverter::parseReal(args[3]);
 
-    if (!m_models.size() || m_models.find(modelName) == m_models.end())
-        m_models[modelName] = std::vector<SkidmarkDef>();
-
     m_models[modelName].push_back(cfg);
     return 0;
 }
 
-int RoR::SkidmarkConfig::getTexture(Ogre::String model, Ogre::String ground, float slip, Ogre::String& texture)
+int RoR::SkidmarkConfig::InternTexture(Ogre::String const& texture)
 {
-    if (m_models.find(model) == m_models.end())
-        return 1;
-    for (std::vector<SkidmarkDef>::iterator it = m_models[model].begin(); it != m_models[model].end(); it++)
+    for (size_t i = 0; i < m_texture_names.size(); i++)
     {
-        if (it->ground == ground && it->slipFrom <= slip && it->slipTo > slip)
-        {
-            texture = it->texture.c_str();
-            return 0;
-        }
+        if (m_texture_names[i] == texture)
+            return static_cast<int>(i);
     }
-    return 2;
+    m_texture_names.push_back(texture);
+    return static_cast<int>(m_texture_names.size() - 1);
 }
 
-// this is a hardcoded array which we use to map ground types to a certain texture with UV/ coords
-Ogre::Vector2 RoR::Skidmark::m_tex_coords[4] = {Ogre::Vector2(0, 0), Ogre::Vector2(0, 1), Ogre::Vector2(1, 0), Ogre::Vector2(1, 1)};
-
-RoR::Skidmark::Skidmark(RoR::SkidmarkConfig* config, wheel_t* m_wheel, 
-        Ogre::SceneNode* snode, int m_length /* = 500 */, int m_bucket_count /* = 20 */)
-    : m_scene_node(snode)
-    , m_is_dirty(true)
-    , m_length(m_length)
-    , m_bucket_count(m_bucket_count)
-    , m_wheel(m_wheel)
-    , m_min_distance(0.25f)
-    , m_max_distance(std::max(0.5f, m_wheel->wh_width * 1.1f))
-    , m_config(config)
+int RoR::SkidmarkConfig::GetGroundModelId(const ground_model_t* gm)
 {
-    if (m_length % 2)
+    auto found = m_ground_model_ids.find(gm->name);
+    if (found != m_ground_model_ids.end())
+        return found->second;
+
+    // Resolve the defs of this ground model, so that lookups don't need to compare names
+    std::vector<SkidmarkDef> defs;
+    auto model = m_models.find("default");
+    if (model != m_models.end())
     {
-        m_length--;
+        for (SkidmarkDef const& def: model->second)
+        {
+            if (def.ground == gm->name)
+                defs.push_back(def);
+        }
     }
+
+    const int id = static_cast<int>(m_ground_model_defs.size());
+    m_ground_model_defs.push_back(defs);
+    m_ground_model_ids.insert(std::make_pair(std::string(gm->name), id));
+    return id;
 }
 
-RoR::Skidmark::~Skidmark()
+int RoR::SkidmarkConfig::GetTextureId(int ground_model_id, float slip) const
 {
-    this->reset();
+    for (SkidmarkDef const& def: m_ground_model_defs[ground_model_id])
+    {
+        if (def.slipFrom <= slip && def.slipTo > slip)
+            return def.textureId;
+    }
+    return -1;
 }
 
-void RoR::Skidmark::AddObject(Ogre::Vector3 start, Ogre::String texture)
+RoR::SkidmarkBatch::SkidmarkBatch(Ogre::String const& texture, int texture_id, int max_quads)
+    : m_max_quads(max_quads)
 {
-    SkidmarkSegment skid;
-    skid.pos = 0;
-    skid.lastPointAv = start;
-    skid.facecounter = 0;
+    const Ogre::String name = "skidmarks-" + TOSTRING(texture_id);
 
-    // new material
-    char bname[256] = "";
-    sprintf(bname, "mat-skidmark-%d", m_instance_counter);
-    skid.material = Ogre::MaterialManager::getSingleton().create(bname, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-    Ogre::Pass* p = skid.material->getTechnique(0)->getPass(0);
+    m_material = Ogre::MaterialManager::getSingleton().create("mat-" + name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Ogre::Pass* p = m_material->getTechnique(0)->getPass(0);
 
     p->createTextureUnitState(texture);
     p->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
@@ -150,58 +150,163 @@ void RoR::Skidmark::AddObject(Ogre::Vector3 start, Ogre::String texture)
     p->setDepthBias(3, 3);
     p->setCullingMode(Ogre::CULL_NONE);
 
-    skid.points.resize(m_length);
-    skid.faceSizes.resize(m_length);
-    skid.groundTexture.resize(m_length);
-    skid.obj = App::GetGfxScene()->GetSceneManager()->createManualObject("skidmark" + TOSTRING(m_instance_counter++));
-    skid.obj->setDynamic(true);
-    skid.obj->setRenderingDistance(800); // 800m view distance
-    skid.obj->begin(bname, Ogre::RenderOperation::OT_TRIANGLE_STRIP);
-    for (int i = 0; i < m_length; i++)
+    // All quads start collapsed (zero area), they aren't rasterized
+    SkidmarkVertex zero;
+    zero.position = Ogre::Vector3::ZERO;
+    zero.texcoord = Ogre::Vector2::ZERO;
+    m_vertices.resize(4 * m_max_quads, zero);
+    m_quad_owners.resize(m_max_quads, -1);
+
+    m_mesh = Ogre::MeshManager::getSingleton().createManual(name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Ogre::SubMesh* submesh = m_mesh->createSubMesh();
+    submesh->useSharedVertices = false;
+    submesh->vertexData = new Ogre::VertexData();
+    submesh->vertexData->vertexStart = 0;
+    submesh->vertexData->vertexCount = m_vertices.size();
+
+    Ogre::VertexDeclaration* decl = submesh->vertexData->vertexDeclaration;
+    size_t offset = 0;
+    decl->addElement(0, offset, Ogre::VET_FLOAT3, Ogre::VES_POSITION);
+    offset += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT3);
+    decl->addElement(0, offset, Ogre::VET_FLOAT2, Ogre::VES_TEXTURE_COORDINATES, 0);
+    offset += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT2);
+
+    m_hw_vbuf = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+        offset, m_vertices.size(), Ogre::HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY);
+    m_hw_vbuf->writeData(0, m_hw_vbuf->getSizeInBytes(), m_vertices.data(), true);
+    submesh->vertexData->vertexBufferBinding->setBinding(0, m_hw_vbuf);
+
+    // Indices never change: 2 triangles per quad
+    std::vector<unsigned short> indices(6 * m_max_quads);
+    for (int i = 0; i < m_max_quads; i++)
     {
-        skid.points[i] = start;
-        skid.faceSizes[i] = 0;
-        skid.groundTexture[i] = "0.png";
-        skid.obj->position(start);
-        skid.obj->textureCoord(0, 0);
+        const unsigned short base = static_cast<unsigned short>(4 * i);
+        indices[6*i + 0] = base + 0;
+        indices[6*i + 1] = base + 1;
+        indices[6*i + 2] = base + 2;
+        indices[6*i + 3] = base + 2;
+        indices[6*i + 4] = base + 1;
+        indices[6*i + 5] = base + 3;
     }
-    skid.obj->end();
-    m_scene_node->attachObject(skid.obj);
+    Ogre::HardwareIndexBufferSharedPtr ibuf = Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+        Ogre::HardwareIndexBuffer::IT_16BIT, indices.size(), Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    ibuf->writeData(0, ibuf->getSizeInBytes(), indices.data(), true);
+    submesh->indexData->indexBuffer = ibuf;
+    submesh->indexData->indexCount = indices.size();
+    submesh->indexData->indexStart = 0;
+    submesh->setMaterialName(m_material->getName());
+
+    m_mesh->_setBounds(Ogre::AxisAlignedBox::BOX_NULL, false);
+    m_mesh->load();
+
+    m_entity = App::GetGfxScene()->GetSceneManager()->createEntity(name, name);
+    m_entity->setCastShadows(false);
+    App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode()->attachObject(m_entity);
+}
 
-    m_objects.push(skid);
+RoR::SkidmarkBatch::~SkidmarkBatch()
+{
+    Ogre::SceneNode* snode = m_entity->getParentSceneNode();
+    App::GetGfxScene()->GetSceneManager()->destroyEntity(m_entity);
+    App::GetGfxScene()->GetSceneManager()->destroySceneNode(snode);
+
+    Ogre::MeshManager::getSingleton().remove(m_mesh->getHandle());
+    m_mesh.setNull();
+    Ogre::MaterialManager::getSingleton().remove(m_material->getName());
+    m_material.setNull();
+}
+
+void RoR::SkidmarkBatch::AddQuad(int owner_id, const Ogre::Vector3 corners[4], float tex_scale)
+{
+    // this is a hardcoded array which we use to map ground types to a certain texture with UV/ coords
+    static const Ogre::Vector2 tex_coords[4] = {Ogre::Vector2(0, 0), Ogre::Vector2(0, 1), Ogre::Vector2(1, 0), Ogre::Vector2(1, 1)};
 
-    this->LimitObjects();
+    const int quad = m_next_quad;
+    m_next_quad = (m_next_quad + 1) % m_max_quads; // Overwrite the oldest when full
+
+    for (int i = 0; i < 4; i++)
+    {
+        SkidmarkVertex& v = m_vertices[4*quad + i];
+        v.position = corners[i];
+        v.texcoord = tex_coords[i];
+        v.texcoord.x *= tex_scale; // scale texture according face size
+        m_bounds.merge(corners[i]);
+    }
+    m_quad_owners[quad] = owner_id;
+
+    this->MarkDirty(quad);
 }
 
-void RoR::Skidmark::PopSegment()
+void RoR::SkidmarkBatch::RemoveQuads(int owner_id)
 {
-    SkidmarkSegment& skid = m_objects.front();
-    skid.points.clear();
-    skid.faceSizes.clear();
-    Ogre::MaterialManager::getSingleton().remove(skid.material->getName());
-    skid.material.setNull();
-    App::GetGfxScene()->GetSceneManager()->destroyManualObject(skid.obj);
-    m_objects.pop();
+    for (int quad = 0; quad < m_max_quads; quad++)
+    {
+        if (m_quad_owners[quad] != owner_id)
+            continue;
+
+        for (int i = 1; i < 4; i++)
+        {
+            m_vertices[4*quad + i].position = m_vertices[4*quad].position;
+        }
+        m_quad_owners[quad] = -1;
+
+        this->MarkDirty(quad);
+    }
 }
 
-void RoR::Skidmark::LimitObjects()
+void RoR::SkidmarkBatch::MarkDirty(int quad)
 {
-    if ((int)m_objects.size() > m_bucket_count)
+    if (m_dirty_begin == -1)
+    {
+        m_dirty_begin = quad;
+        m_dirty_end = quad + 1;
+    }
+    else
     {
-        this->PopSegment();
+        m_dirty_begin = std::min(m_dirty_begin, quad);
+        m_dirty_end = std::max(m_dirty_end, quad + 1);
     }
 }
 
-void RoR::Skidmark::SetPointInt(unsigned short index, const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture)
+void RoR::SkidmarkBatch::UploadChanges()
 {
-    m_objects.back().points[index] = value;
-    m_objects.back().faceSizes[index] = fsize;
-    m_objects.back().groundTexture[index] = texture;
+    if (m_dirty_begin == -1)
+        return;
+
+    const size_t quad_size = 4 * sizeof(SkidmarkVertex);
+    m_hw_vbuf->writeData(m_dirty_begin * quad_size, (m_dirty_end - m_dirty_begin) * quad_size, &m_vertices[4 * m_dirty_begin], false);
+    m_dirty_begin = -1;
+    m_dirty_end = -1;
+
+    // The bounds only grow, which is fine for culling
+    const Ogre::Vector3 extent(
+        std::max(std::abs(m_bounds.getMinimum().x), std::abs(m_bounds.getMaximum().x)),
+        std::max(std::abs(m_bounds.getMinimum().y), std::abs(m_bounds.getMaximum().y)),
+        std::max(std::abs(m_bounds.getMinimum().z), std::abs(m_bounds.getMaximum().z)));
+    m_mesh->_setBounds(m_bounds, false);
+    m_mesh->_setBoundingSphereRadius(extent.length());
+}
 
-    m_is_dirty = true;
+RoR::Skidmark::Skidmark(RoR::SkidmarkConfig* config, wheel_t* m_wheel)
+    : m_id(m_instance_counter++)
+    , m_wheel(m_wheel)
+    , m_min_distance(0.25f)
+    , m_max_distance(std::max(0.5f, m_wheel->wh_width * 1.1f))
+    , m_config(config)
+    , m_has_trail(false)
+    , m_texture_id(-1)
+    , m_last_point_av(Ogre::Vector3::ZERO)
+    , m_ground_model(nullptr)
+    , m_ground_model_id(-1)
+{
+}
+
+RoR::Skidmark::~Skidmark()
+{
+    this->reset();
 }
 
-void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float slip, Ogre::String ground_model_name)
+void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float slip, const ground_model_t* ground_model)
 {
     Ogre::Vector3 thisPoint = contact_point;
     Ogre::Vector3 axis = m_wheel->wh_axis_node_1->RelPosition - m_wheel->wh_axis_node_0->RelPosition;
@@ -212,170 +317,74 @@ void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float sl
     Ogre::Vector3 thisPointAV = thisPoint + axis * 0.5f;
     Ogre::Real distance = 0;
     Ogre::Real maxDist = m_max_distance;
-    Ogre::String texture = "none";
-    m_config->getTexture("default", ground_model_name, slip, texture);
+
+    // Ground models only change when the wheel moves to another surface
+    if (ground_model != m_ground_model)
+    {
+        m_ground_model = ground_model;
+        m_ground_model_id = m_config->GetGroundModelId(ground_model);
+    }
+    const int texture_id = m_config->GetTextureId(m_ground_model_id, slip);
 
     // dont add points with no texture
-    if (texture == "none")
+    if (texture_id == -1)
         return;
 
     if (m_wheel->wh_speed > 1)
         maxDist *= m_wheel->wh_speed;
 
-    if (!m_objects.size())
-    {
-        // add first bucket
-        this->AddObject(thisPoint, texture);
-    }
-    else
+    bool connect = false;
+    if (m_has_trail)
     {
-        // check existing buckets
-        SkidmarkSegment skid = m_objects.back();
-
-        distance = skid.lastPointAv.distance(thisPointAV);
+        distance = m_last_point_av.distance(thisPointAV);
         // too near to update?
         if (distance < m_min_distance)
         {
-            //LOG("E: too near for update");
             return;
         }
 
-        // change ground texture if required
-        if (skid.pos > 0 && skid.groundTexture[0] != texture)
+        if (texture_id != m_texture_id)
         {
-            // new object with new texture
-            if (distance > maxDist)
-            {
-                // to far away for connection
-                this->AddObject(thisPoint, texture);
-            }
-            else
-            {
-                // add new bucket with connection to last bucket
-                Ogre::Vector3 lp1 = m_objects.back().points[m_objects.back().pos - 1];
-                Ogre::Vector3 lp2 = m_objects.back().points[m_objects.back().pos - 2];
-                this->AddObject(lp1, texture);
-                this->AddPoint(lp2, distance, texture);
-                this->AddPoint(lp1, distance, texture);
-            }
+            // change ground texture; connect to the last trail unless it's too far away
+            connect = (distance <= maxDist);
         }
         else
         {
-            // no texture change required :D
-
-            // far enough for new bucket?
-            if (skid.pos >= (int)skid.points.size())
-            {
-                if (distance > maxDist)
-                {
-                    // to far away for connection
-                    this->AddObject(thisPoint, texture);
-                }
-                else
-                {
-                    // add new bucket with connection to last bucket
-                    Ogre::Vector3 lp1 = m_objects.back().points[m_objects.back().pos - 1];
-                    Ogre::Vector3 lp2 = m_objects.back().points[m_objects.back().pos - 2];
-                    this->AddObject(lp1, texture);
-                    this->AddPoint(lp2, distance, texture);
-                    this->AddPoint(lp1, distance, texture);
-                }
-            }
-            else if (distance > m_max_distance)
-            {
-                // just new bucket, no connection to last bucket
-                this->AddObject(thisPoint, texture);
-            }
+            // no connection if too far away
+            connect = (distance <= m_max_distance);
         }
     }
 
     const float overaxis = 0.2f;
+    const Ogre::Vector3 left = contact_point - (axis * overaxis);
+    const Ogre::Vector3 right = contact_point + axis + (axis * overaxis);
 
-    this->AddPoint(contact_point - (axis * overaxis), distance, texture);
-    this->AddPoint(contact_point + axis + (axis * overaxis), distance, texture);
+    if (connect)
+    {
+        const Ogre::Vector3 corners[4] = { m_last_points[0], m_last_points[1], left, right };
+        App::GetGfxScene()->GetSkidmarkBatch(texture_id)->AddQuad(m_id, corners, distance / m_min_distance);
+    }
+
+    m_has_trail = true;
+    m_texture_id = texture_id;
+    m_last_points[0] = left;
+    m_last_points[1] = right;
 
     // save as last point (in the middle of the m_wheel)
-    m_objects.back().lastPointAv = thisPointAV;
+    m_last_point_av = thisPointAV;
 }
 
-void RoR::Skidmark::AddPoint(const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture)
+void RoR::Skidmark::reset()
 {
-    if (m_objects.back().pos >= m_length)
+    for (SkidmarkBatch* batch: App::GetGfxScene()->GetSkidmarkBatches())
     {
-        return;
+        if (batch)
+            batch->RemoveQuads(m_id);
     }
-    this->SetPointInt(m_objects.back().pos, value, fsize, texture);
-    m_objects.back().pos++;
+    m_has_trail = false;
 }
 
-void RoR::Skidmark::reset()
-{
-    while (m_objects.size() != 0) // Remove all skid segments
-        this->PopSegment();
-}
-
-void RoR::Skidmark::update(Ogre::Vector3 contact_point, int index, float slip, Ogre::String ground_model_name)
+void RoR::Skidmark::update(Ogre::Vector3 contact_point, int index, float slip, const ground_model_t* ground_model)
 {
-    this->UpdatePoint(contact_point, index, slip, ground_model_name);
-    if (!m_is_dirty)
-        return;
-    if (!m_objects.size())
-        return;
-    SkidmarkSegment skid = m_objects.back();
-    Ogre::Vector3 vaabMin = skid.points[0];
-    Ogre::Vector3 vaabMax = skid.points[0];
-    skid.obj->beginUpdate(0);
-    bool behindEnd = false;
-    Ogre::Vector3 lastValid = Ogre::Vector3::ZERO;
-    int to_counter = 0;
-    float tcox_counter = 0;
-
-    for (int i = 0; i < m_length; i++ , to_counter++)
-    {
-        if (i >= skid.pos)
-            behindEnd = true;
-
-        if (to_counter > 3)
-            to_counter = 0;
-
-        if (!behindEnd)
-            tcox_counter += skid.faceSizes[i] / m_min_distance;
-
-        while (tcox_counter > 1)
-            tcox_counter--;
-
-        if (behindEnd)
-        {
-            skid.obj->position(lastValid);
-            skid.obj->textureCoord(0, 0);
-        }
-        else
-        {
-            skid.obj->position(skid.points[i]);
-
-            Ogre::Vector2 tco = m_tex_coords[to_counter];
-            tco.x *= skid.faceSizes[i] / m_min_distance; // scale texture according face size
-            skid.obj->textureCoord(tco);
-
-            lastValid = skid.points[i];
-        }
-
-        if (skid.points[i].x < vaabMin.x)
-            vaabMin.x = skid.points[i].x;
-        if (skid.points[i].y < vaabMin.y)
-            vaabMin.y = skid.points[i].y;
-        if (skid.points[i].z < vaabMin.z)
-            vaabMin.z = skid.points[i].z;
-        if (skid.points[i].x > vaabMax.x)
-            vaabMax.x = skid.points[i].x;
-        if (skid.points[i].y > vaabMax.y)
-            vaabMax.y = skid.points[i].y;
-        if (skid.points[i].z > vaabMax.z)
-            vaabMax.z = skid.points[i].z;
-    }
-    skid.obj->end();
-
-    skid.obj->setBoundingBox(Ogre::AxisAlignedBox(vaabMin, vaabMax));
-
-    m_is_dirty = false;
+    this->UpdatePoint(contact_point, index, slip, ground_model);
 }
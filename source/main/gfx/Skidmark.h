@@ -22,11 +22,18 @@
 
 #include "Application.h"
 
+#include <OgreAxisAlignedBox.h>
+#include <OgreHardwareVertexBuffer.h>
 #include <OgreMaterial.h>
+#include <OgreMesh.h>
 #include <OgreString.h>
 #include <OgreVector2.h>
 #include <OgreVector3.h>
 
+#include <map>
+#include <unordered_map>
+#include <vector>
+
 namespace RoR {
 
 class SkidmarkConfig //!< Skidmark config file parser and data container
@@ -35,66 +42,101 @@ public:
 
     void LoadDefaultSkidmarkDefs();
 
-    int getTexture(Ogre::String model, Ogre::String ground, float slip, Ogre::String& texture);
+    /// Interns the ground model; its skidmark defs are resolved on first use.
+    int GetGroundModelId(const ground_model_t* gm);
+    /// @return Texture ID or -1 if there's no skidmark for this ground model and slip.
+    int GetTextureId(int ground_model_id, float slip) const;
+    Ogre::String const& GetTextureName(int texture_id) const { return m_texture_names[texture_id]; }
+    size_t GetNumTextures() const { return m_texture_names.size(); }
 
 private:
 
     struct SkidmarkDef
     {
         Ogre::String ground; //!< Ground model name, see `struct ground_model_t`
-        Ogre::String texture;
+        int textureId;       //!< Index to `m_texture_names`
         float slipFrom; //!< Minimum slipping velocity
         float slipTo;   //!< Maximum slipping velocity
     };
 
     int ProcessSkidmarkConfLine(Ogre::StringVector args, Ogre::String model);
+    int InternTexture(Ogre::String const& texture);
 
     std::map<Ogre::String, std::vector<SkidmarkDef>> m_models;
+    std::vector<Ogre::String>                        m_texture_names;
+    std::unordered_map<std::string, int>             m_ground_model_ids; //!< Keyed by ground model name
+    std::vector<std::vector<SkidmarkDef>>            m_ground_model_defs; //!< Defs of model 'default', indexed by ground model ID
 };
 
-class Skidmark
+/// All skidmarks with one texture, kept as quads in one preallocated ring-buffer vertex buffer.
+/// When full, the oldest quads are overwritten.
+class SkidmarkBatch
 {
 public:
 
-    /// Constructor - see setOperationType() for description of argument.
-    Skidmark(SkidmarkConfig* config,  wheel_t* m_wheel, Ogre::SceneNode* snode, int m_length = 500, int m_bucket_count = 20);
-    virtual ~Skidmark();
+    static const int DEFAULT_MAX_QUADS = 8192; //!< With 16-bit indices, 16384 is the limit.
 
-    void reset();
-    void update(Ogre::Vector3 contact_point, int index, float slip, Ogre::String ground_model_name);
+    SkidmarkBatch(Ogre::String const& texture, int texture_id, int max_quads);
+    ~SkidmarkBatch();
+
+    /// @param corners Previous left, previous right, new left, new right
+    void AddQuad(int owner_id, const Ogre::Vector3 corners[4], float tex_scale);
+    void RemoveQuads(int owner_id); //!< Collapses all quads of the owner
+    void UploadChanges(); //!< Writes the modified part of the ring buffer to the GPU; call once per frame.
 
 private:
 
-    struct SkidmarkSegment //!< Also reffered to as 'bucket'
+    struct SkidmarkVertex
     {
-        Ogre::ManualObject* obj;
-        Ogre::MaterialPtr material;
-        std::vector<Ogre::Vector3> points;
-        std::vector<Ogre::Real> faceSizes;
-        std::vector<Ogre::String> groundTexture;
-        Ogre::Vector3 lastPointAv;
-        int pos;
-        int facecounter;
+        Ogre::Vector3 position;
+        Ogre::Vector2 texcoord;
     };
 
-    void PopSegment();
-    void LimitObjects();
-    void AddObject(Ogre::Vector3 start, Ogre::String texture);
-    void SetPointInt(unsigned short index, const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture);
-    void AddPoint(const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture);
-    void UpdatePoint(Ogre::Vector3 contact_point, int index, float slip, Ogre::String ground_model_name);
+    void MarkDirty(int quad);
+
+    Ogre::MeshPtr                     m_mesh;
+    Ogre::Entity*                     m_entity = nullptr;
+    Ogre::MaterialPtr                 m_material;
+    Ogre::HardwareVertexBufferSharedPtr m_hw_vbuf;
+    std::vector<SkidmarkVertex>       m_vertices;
+    std::vector<int>                  m_quad_owners; //!< -1 = unused
+    int                               m_max_quads = 0;
+    int                               m_next_quad = 0;
+    int                               m_dirty_begin = -1; //!< First modified quad, -1 = none
+    int                               m_dirty_end = -1;   //!< One past the last modified quad
+    Ogre::AxisAlignedBox              m_bounds;
+};
+
+class Skidmark
+{
+public:
+
+    Skidmark(SkidmarkConfig* config, wheel_t* m_wheel);
+    virtual ~Skidmark();
+
+    void reset();
+    void update(Ogre::Vector3 contact_point, int index, float slip, const ground_model_t* ground_model);
+
+private:
+
+    void UpdatePoint(Ogre::Vector3 contact_point, int index, float slip, const ground_model_t* ground_model);
 
     static int           m_instance_counter;
-    bool                 m_is_dirty;
-    std::queue<SkidmarkSegment> m_objects;
+    int                  m_id;            //!< Owner ID of our quads in the batches
     float                m_max_distance;
     float                m_min_distance;
-    static Ogre::Vector2 m_tex_coords[4];
-    int                  m_bucket_count;
-    int                  m_length;
     wheel_t*             m_wheel;
-    Ogre::SceneNode*     m_scene_node;  
     SkidmarkConfig*      m_config;
+
+    // Current trail
+    bool                 m_has_trail;
+    int                  m_texture_id;
+    Ogre::Vector3        m_last_points[2]; //!< Left, right
+    Ogre::Vector3        m_last_point_av;  //!< In the middle of the wheel
+
+    // Interned ground model of the last update
+    const ground_model_t* m_ground_model;
+    int                  m_ground_model_id;
 };
 
 } // namespace RoR
@@ -29,6 +29,9 @@
 
 #include <Ogre.h>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -89,6 +92,12 @@ Water::Water(Ogre::Vector3 terrn_size) :
     {
         m_wavetrain_defs[i].wavespeed = 1.25 * sqrt(m_wavetrain_defs[i].wavelength);
         m_max_ampl += m_wavetrain_defs[i].maxheight;
+
+        m_wt_amplitude.push_back(m_wavetrain_defs[i].amplitude);
+        m_wt_maxheight.push_back(m_wavetrain_defs[i].maxheight);
+        m_wt_kx.push_back(m_wavetrain_defs[i].dir_sin / m_wavetrain_defs[i].wavelength);
+        m_wt_kz.push_back(m_wavetrain_defs[i].dir_cos / m_wavetrain_defs[i].wavelength);
+        m_wt_kt.push_back(m_wavetrain_defs[i].wavespeed / m_wavetrain_defs[i].wavelength);
     }
 
     this->PrepareWater();
@@ -372,11 +381,20 @@ void Water::ShowWave(Vector3 refpos)
     float xScaled = m_map_size.x * m_waterplane_mesh_scale;
     float zScaled = m_map_size.z * m_waterplane_mesh_scale;
 
+    const float time_sec = IWater::GetWavesClock();
+
+    Vector3 row_pos[WAVEREZ + 1];
+    float row_height[WAVEREZ + 1];
     for (int pz = 0; pz < WAVEREZ + 1; pz++)
     {
         for (int px = 0; px < WAVEREZ + 1; px++)
         {
-            m_waterplane_vert_buf_local[(pz * (WAVEREZ + 1) + px) * 8 + 1] = CalcWavesHeight(refpos + Vector3(xScaled * 0.5 - (float)px * xScaled / WAVEREZ, 0, (float)pz * zScaled / WAVEREZ - zScaled * 0.5)) - m_water_height;
+            row_pos[px] = refpos + Vector3(xScaled * 0.5 - (float)px * xScaled / WAVEREZ, 0, (float)pz * zScaled / WAVEREZ - zScaled * 0.5);
+        }
+        this->EvalWavesHeight(row_pos, row_height, WAVEREZ + 1, time_sec);
+        for (int px = 0; px < WAVEREZ + 1; px++)
+        {
+            m_waterplane_vert_buf_local[(pz * (WAVEREZ + 1) + px) * 8 + 1] = row_height[px] - m_water_height;
         }
     }
 
@@ -404,7 +422,7 @@ void Water::ShowWave(Vector3 refpos)
 
 bool Water::IsCameraUnderWater()
 {
-    return (App::GetCameraManager()->GetCameraNode()->getPosition().y < CalcWavesHeight(App::GetCameraManager()->GetCameraNode()->getPosition()));
+    return (App::GetCameraManager()->GetCameraNode()->getPosition().y < CalcWavesHeight(App::GetCameraManager()->GetCameraNode()->getPosition(), IWater::GetWavesClock()));
 }
 
 void Water::UpdateWater()
@@ -510,58 +528,102 @@ void Water::SetWaterBottomHeight(float value)
     m_bottom_height = value;
 }
 
-float Water::CalcWavesHeight(Vector3 pos)
+/// Evaluates sin(2*pi*turns); branch-free so that loops over wave trains can be vectorized.
+static inline float SinTurns(float turns)
+{
+    // reduce to [-0.5, 0.5] turns, then mirror into [-0.25, 0.25] where the polynomial is accurate
+    float t = turns - std::floor(turns + 0.5f);
+    const float mirror = (t >= 0.f) ? 0.5f : -0.5f;
+    t = (std::fabs(t) > 0.25f) ? (mirror - t) : t;
+    const float x = t * Math::TWO_PI;
+    const float x2 = x * x;
+    return x * (1.f + x2 * (-1.f / 6.f + x2 * (1.f / 120.f + x2 * (-1.f / 5040.f + x2 * (1.f / 362880.f)))));
+}
+
+float Water::GetWavesMaxAmplitude()
+{
+    return (this->AreWavesEnabled()) ? m_max_ampl : 0.f;
+}
+
+bool Water::AreWavesEnabled() const
+{
+    return RoR::App::gfx_water_waves->GetBool() && RoR::App::mp_state->GetEnum<MpState>() != RoR::MpState::CONNECTED;
+}
+
+float Water::CalcWavesHeight(Vector3 pos, float time_sec)
+{
+    float result;
+    this->CalcWavesHeightBatch(&pos, &result, 1, time_sec);
+    return result;
+}
+
+void Water::CalcWavesHeightBatch(const Vector3* pos, float* out_heights, size_t count, float time_sec)
 {
     // no waves?
-    if (!RoR::App::gfx_water_waves->GetBool() || RoR::App::mp_state->GetEnum<MpState>() == RoR::MpState::CONNECTED)
+    if (!this->AreWavesEnabled())
     {
         // constant height, sea is flat as pancake
-        return m_water_height;
+        std::fill(out_heights, out_heights + count, m_water_height);
+        return;
     }
 
-    const float time_sec = (float)(App::GetAppContext()->GetOgreRoot()->getTimer()->getMilliseconds() * 0.001);
-
-    // uh, some upper limit?!
-    if (pos.y > m_water_height + m_max_ampl)
-        return m_water_height;
+    this->EvalWavesHeight(pos, out_heights, count, time_sec);
+}
 
-    float waveheight = GetWaveHeight(pos);
-    // we will store the result in this variable, init it with the default height
-    float result = m_water_height;
-    // now walk through all the wave trains. One 'train' is one sin/cos set that will generate once wave. All the trains together will sum up, so that they generate a 'rough' sea
-    for (size_t i = 0; i < m_wavetrain_defs.size(); i++)
+void Water::EvalWavesHeight(const Vector3* pos, float* out_heights, size_t count, float time_sec)
+{
+    const size_t num_trains = m_wt_amplitude.size();
+    const float* wt_amplitude = m_wt_amplitude.data();
+    const float* wt_maxheight = m_wt_maxheight.data();
+    const float* wt_kx = m_wt_kx.data();
+    const float* wt_kz = m_wt_kz.data();
+    const float* wt_kt = m_wt_kt.data();
+
+    for (size_t j = 0; j < count; j++)
     {
-        // calculate the amplitude that this wave will have. wavetrains[i].amplitude is read from the config
-        // upper limit: prevent too big waves by setting an upper limit
-        float amp = std::min(m_wavetrain_defs[i].amplitude * waveheight, m_wavetrain_defs[i].maxheight);
-        // now the main thing:
-        // calculate the sinus with the values of the config file and add it to the result
-        result += amp * sin(Math::TWO_PI * ((time_sec * m_wavetrain_defs[i].wavespeed + m_wavetrain_defs[i].dir_sin * pos.x + m_wavetrain_defs[i].dir_cos * pos.z) / m_wavetrain_defs[i].wavelength));
+        const Vector3& p = pos[j];
+
+        // uh, some upper limit?!
+        if (p.y > m_water_height + m_max_ampl)
+        {
+            out_heights[j] = m_water_height;
+            continue;
+        }
+
+        const float waveheight = GetWaveHeight(p);
+        // we will store the result in this variable, init it with the default height
+        float result = m_water_height;
+        // now walk through all the wave trains. One 'train' is one sin/cos set that will generate once wave. All the trains together will sum up, so that they generate a 'rough' sea
+        for (size_t i = 0; i < num_trains; i++)
+        {
+            // calculate the amplitude that this wave will have; upper limit: prevent too big waves
+            const float amp = std::min(wt_amplitude[i] * waveheight, wt_maxheight[i]);
+            result += amp * SinTurns(time_sec * wt_kt[i] + wt_kx[i] * p.x + wt_kz[i] * p.z);
+        }
+        out_heights[j] = result;
     }
-    // return the summed up waves
-    return result;
 }
 
-bool Water::IsUnderWater(Vector3 pos)
+bool Water::IsUnderWater(Vector3 pos, float time_sec)
 {
     float waterheight = m_water_height;
 
-    if (RoR::App::gfx_water_waves->GetBool() && RoR::App::mp_state->GetEnum<MpState>() == RoR::MpState::DISABLED)
+    if (this->AreWavesEnabled())
     {
         float waveheight = GetWaveHeight(pos);
 
         if (pos.y > m_water_height + m_max_ampl * waveheight || pos.y > m_water_height + m_max_ampl)
             return false;
 
-        waterheight = CalcWavesHeight(pos);
+        waterheight = CalcWavesHeight(pos, time_sec);
     }
 
     return pos.y < waterheight;
 }
 
-Vector3 Water::CalcWavesVelocity(Vector3 pos)
+Vector3 Water::CalcWavesVelocity(Vector3 pos, float time_sec)
 {
-    if (!RoR::App::gfx_water_waves->GetBool() || RoR::App::mp_state->GetEnum<MpState>() == RoR::MpState::CONNECTED)
+    if (!this->AreWavesEnabled())
         return Vector3::ZERO;
 
     float waveheight = GetWaveHeight(pos);
@@ -571,15 +633,15 @@ Vector3 Water::CalcWavesVelocity(Vector3 pos)
 
     Vector3 result(Vector3::ZERO);
 
-    const float time_sec = (float)(App::GetAppContext()->GetOgreRoot()->getTimer()->getMilliseconds() * 0.001);
-
     for (size_t i = 0; i < m_wavetrain_defs.size(); i++)
     {
-        float amp = std::min(m_wavetrain_defs[i].amplitude * waveheight, m_wavetrain_defs[i].maxheight);
-        float speed = Math::TWO_PI * amp / (m_wavetrain_defs[i].wavelength / m_wavetrain_defs[i].wavespeed);
-        float coeff = Math::TWO_PI * (time_sec * m_wavetrain_defs[i].wavespeed + m_wavetrain_defs[i].dir_sin * pos.x + m_wavetrain_defs[i].dir_cos * pos.z) / m_wavetrain_defs[i].wavelength;
-        result.y += speed * cos(coeff);
-        result += Vector3(m_wavetrain_defs[i].dir_sin, 0, m_wavetrain_defs[i].dir_cos) * speed * sin(coeff);
+        const float amp = std::min(m_wt_amplitude[i] * waveheight, m_wt_maxheight[i]);
+        const float speed = Math::TWO_PI * amp * m_wt_kt[i];
+        const float turns = time_sec * m_wt_kt[i] + m_wt_kx[i] * pos.x + m_wt_kz[i] * pos.z;
+        const float speed_sin = speed * SinTurns(turns);
+        result.x += m_wavetrain_defs[i].dir_sin * speed_sin;
+        result.y += speed * SinTurns(turns + 0.25f); // cos
+        result.z += m_wavetrain_defs[i].dir_cos * speed_sin;
     }
 
     return result;
@@ -45,10 +45,12 @@ public:
     float          GetStaticWaterHeight() override;
     void           SetStaticWaterHeight(float value) override;
     void           SetWaterBottomHeight(float value) override;
-    float          CalcWavesHeight(Ogre::Vector3 pos) override;
-    Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos) override;
+    float          CalcWavesHeight(Ogre::Vector3 pos, float time_sec) override;
+    Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos, float time_sec) override;
+    float          GetWavesMaxAmplitude() override;
+    void           CalcWavesHeightBatch(const Ogre::Vector3* pos, float* out_heights, size_t count, float time_sec) override;
     void           SetWaterVisible(bool value) override;
-    bool           IsUnderWater(Ogre::Vector3 pos) override;
+    bool           IsUnderWater(Ogre::Vector3 pos, float time_sec) override;
     void           SetReflectionPlaneHeight(float centerheight) override;
     void           UpdateReflectionPlane(float h) override;
     void           WaterPrepareShutdown() override;
@@ -93,6 +95,8 @@ private:
     };
 
     float          GetWaveHeight(Ogre::Vector3 pos);
+    bool           AreWavesEnabled() const;
+    void           EvalWavesHeight(const Ogre::Vector3* pos, float* out_heights, size_t count, float time_sec);
     void           ShowWave(Ogre::Vector3 refpos);
     bool           IsCameraUnderWater();
     void           PrepareWater();
@@ -127,6 +131,13 @@ private:
     Ogre::Plane           m_bottom_plane;
     std::vector<WaveTrain>  m_wavetrain_defs;
 
+    // Wave trains as structure-of-arrays, for the evaluation loops
+    std::vector<float>    m_wt_amplitude;
+    std::vector<float>    m_wt_maxheight;
+    std::vector<float>    m_wt_kx;               //!< dir_sin / wavelength
+    std::vector<float>    m_wt_kz;               //!< dir_cos / wavelength
+    std::vector<float>    m_wt_kt;               //!< wavespeed / wavelength
+
     // Forced camera transforms, used by UpdateWater()
     bool                  m_cam_forced;
     Ogre::Radian          m_cam_forced_fovy;
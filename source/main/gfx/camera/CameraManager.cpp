@@ -53,15 +53,9 @@ bool intersectsTerrain(Vector3 a, Vector3 b) // internal helper
 {
     b.y = std::max(b.y, App::GetSimTerrain()->GetHeightAt(b.x, b.z) + 1.0f);
 
-    int steps = std::max(3.0f, a.distance(b) * 2.0f);
-    for (int i = 1; i < steps; i++)
+    if (App::GetSimTerrain()->IntersectsTerrain(a, b))
     {
-        Vector3 pos = a + (b - a) * (float)i / steps;
-        float h = App::GetSimTerrain()->GetHeightAt(pos.x, pos.z);
-        if (h > pos.y)
-        {
-            return true;
-        }
+        return true;
     }
     return App::GetSimTerrain()->GetCollisions()->intersectsTris(Ray(a, b - a)).first;
 }
@@ -745,7 +739,7 @@ void CameraManager::UpdateCameraBehaviorStatic()
                 intersectsTerrain(m_staticcam_position, lookAt, lookAtPrediction, interval))
         {
             const auto water = App::GetSimTerrain()->getWater();
-            float water_height = (water && !water->IsUnderWater(lookAt)) ? water->GetStaticWaterHeight() : 0.0f;
+            float water_height = (water && !water->IsUnderWater(lookAt, IWater::GetWavesClock())) ? water->GetStaticWaterHeight() : 0.0f;
             float desired_offset = std::max(std::sqrt(radius) * 2.89f, App::gfx_camera_height->GetFloat());
 
             std::vector<std::pair<float, Vector3>> viable_positions;
@@ -27,6 +27,8 @@ http://www.gnu.org/copyleft/lesser.txt.
 
 #include <Hydrax.h>
 
+#include <utility>
+
 namespace Hydrax{namespace Noise
 {
 	inline float uniform_deviate()
@@ -39,6 +41,7 @@ namespace Hydrax{namespace Noise
 		, resolution(128)
 		, re(0)
 		, img(0)
+		, frontRe(0)
 		, maximalValue(2)
 		, initialWaves(0)
 		, currentWaves(0)
@@ -54,6 +57,7 @@ namespace Hydrax{namespace Noise
 		, resolution(128)
 		, re(0)
 		, img(0)
+		, frontRe(0)
 		, maximalValue(2)
 		, initialWaves(0)
 		, currentWaves(0)
@@ -84,6 +88,8 @@ namespace Hydrax{namespace Noise
 
 	void FFT::remove()
 	{
+		_waitForNoiseTask();
+
 		if (areGPUNormalMapResourcesCreated())
 		{
 			Noise::removeGPUNormalMapResources(mGPUNormalMapManager);
@@ -106,6 +112,10 @@ namespace Hydrax{namespace Noise
 		{
 			delete [] img;
 		}
+		if (frontRe)
+		{
+			delete [] frontRe;
+		}
 		if (initialWaves)
 		{
 			delete [] initialWaves;
@@ -124,6 +134,9 @@ namespace Hydrax{namespace Noise
 
 	void FFT::setOptions(const Options &Options)
 	{
+		// The background generation reads the options
+		_waitForNoiseTask();
+
 		if (isCreated())
 		{
 			if (mOptions.Resolution != Options.Resolution ||
@@ -382,7 +395,7 @@ namespace Hydrax{namespace Noise
 
 		for (int u = 0; u < resolution*resolution; u++)
 		{
-			Data[u] = (re[u]*65535);
+			Data[u] = (frontRe[u]*65535);
 		}
 
 		PixelBuffer->unlock();
@@ -422,7 +435,15 @@ namespace Hydrax{namespace Noise
 
 	void FFT::update(const Ogre::Real &timeSinceLastFrame)
 	{
-		_calculeNoise(timeSinceLastFrame);
+		// The noise of this frame has been calculated in the background during the last one
+		if (_waitForNoiseTask())
+		{
+			std::swap(re, frontRe);
+		}
+
+		// Calculate the next one while the frame is being rendered
+		const float Delta = timeSinceLastFrame;
+		_launchNoiseTask([this, Delta]() { _calculeNoise(Delta); });
 
 		if (areGPUNormalMapResourcesCreated())
 		{
@@ -432,12 +453,21 @@ namespace Hydrax{namespace Noise
 
 	void FFT::_initNoise()
 	{
+		// The inverse FFT works with power of two sizes
+		int p = 1;
+		while (p < resolution)
+		{
+			p *= 2;
+		}
+		resolution = p;
+
 		initialWaves = new std::complex<float>[resolution*resolution];
 		currentWaves = new std::complex<float>[resolution*resolution];
 		angularFrequencies = new float[resolution*resolution];
 
 		re  = new float[resolution*resolution];
 		img = new float[resolution*resolution];
+		frontRe = new float[resolution*resolution];
 
 		Ogre::Vector2 wave = Ogre::Vector2(0,0);
 
@@ -464,6 +494,7 @@ namespace Hydrax{namespace Noise
 		}
 
 		_calculeNoise(0);
+		std::swap(re, frontRe);
 	}
 
 	void FFT::_calculeNoise(const float &delta)
@@ -557,9 +588,6 @@ namespace Hydrax{namespace Noise
 			p *= 2; l2m++;
 		}
 
-		resolution = 1<<l2m;
-		resolution = 1<<l2n;
-
 		int x, y, i;
 
 		for(x = 0; x <resolution; x++)
@@ -786,10 +814,10 @@ namespace Hydrax{namespace Noise
 		//
 		//
 		//   C      D
-		float A = re[(ys*resolution+xs)],
-			  B = re[(ys*resolution+xxs+1)],
-			  C = re[((yys+1)*resolution+xs)],
-			  D = re[((yys+1)*resolution+xxs+1)];
+		float A = frontRe[(ys*resolution+xs)],
+			  B = frontRe[(ys*resolution+xxs+1)],
+			  C = frontRe[((yys+1)*resolution+xs)],
+			  D = frontRe[((yys+1)*resolution+xxs+1)];
 
 		// Return the result of the linear interpolation
 		return (A*_xDIFF*_yDIFF +
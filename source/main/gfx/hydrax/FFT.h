@@ -216,6 +216,7 @@ namespace Hydrax{ namespace Noise
 		void _initNoise();
 
 		/** Calcule noise
+		    @remarks Runs on a worker thread, see update(...)
 		    @param delta Time elapsed since last frame
 		 */
 		void _calculeNoise(const float &delta);
@@ -250,6 +251,9 @@ namespace Hydrax{ namespace Noise
 		int resolution;
 		/// Pointers to resolution*resolution float size arrays
     	float *re, *img;
+		/// Last finished (normalized) result, read by getValue(...) and the GPU normal map while
+		/// the next one is being calculated in re/img by the background generation
+		float *frontRe;
 	    /// The minimal value of the result data of the fft transformation
     	float maximalValue;
 
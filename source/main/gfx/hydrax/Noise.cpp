@@ -24,6 +24,7 @@ http://www.gnu.org/copyleft/lesser.txt.
 
 #include "Noise.h"
 #include "Application.h"
+#include "ThreadPool.h"
 
 namespace Hydrax{namespace Noise
 {
@@ -37,6 +38,7 @@ namespace Hydrax{namespace Noise
 
 	Noise::~Noise()
 	{
+		_waitForNoiseTask();
 	}
 
 	void Noise::create()
@@ -78,6 +80,26 @@ namespace Hydrax{namespace Noise
 		}
 	}
 
+	void Noise::_launchNoiseTask(const std::function<void()> &func)
+	{
+		_waitForNoiseTask();
+
+		mNoiseTask = RoR::App::GetThreadPool()->RunTask(func);
+	}
+
+	bool Noise::_waitForNoiseTask()
+	{
+		if (!mNoiseTask)
+		{
+			return false;
+		}
+
+		mNoiseTask->join();
+		mNoiseTask.reset();
+
+		return true;
+	}
+
 	void Noise::saveCfg(Ogre::String &Data)
 	{
 		Data += "#Noise options\n";
@@ -28,6 +28,11 @@ http://www.gnu.org/copyleft/lesser.txt.
 #include "Prerequisites.h"
 #include "GPUNormalMapManager.h"
 
+#include <functional>
+#include <memory>
+
+namespace RoR { class Task; }
+
 namespace Hydrax{ namespace Noise
 {
 	/** Base noise class,
@@ -121,6 +126,16 @@ namespace Hydrax{ namespace Noise
 		virtual float getValue(const float &x, const float &y) = 0;
 
 	protected:
+		/** Generate the next noise data on a worker thread
+		    @param func Generation function, it must only write to the back buffer
+		 */
+		void _launchNoiseTask(const std::function<void()> &func);
+
+		/** Wait for the pending background noise generation
+		    @return true if a generation has been finished, false if there was none pending
+		 */
+		bool _waitForNoiseTask();
+
 		/// Module name
 		Ogre::String mName;
 		/// Has create() been already called?
@@ -130,6 +145,9 @@ namespace Hydrax{ namespace Noise
         bool mGPUNormalMapSupported;
 		/// Are GPU normal map resources created?
 		bool mGPUNormalMapResourcesCreated;
+
+		/// Pending background noise generation
+		std::shared_ptr<RoR::Task> mNoiseTask;
 	};
 }}
 
@@ -37,7 +37,7 @@ namespace Hydrax{namespace Noise
 	Perlin::Perlin()
 		: Noise("Perlin", true)
 		, time(0)
-		, r_noise(0)
+		, p_noise_front(0)
 		, magnitude(n_dec_magn * 0.085f)
 		, mGPUNormalMapManager(0)
 	{
@@ -47,7 +47,7 @@ namespace Hydrax{namespace Noise
 		: Noise("Perlin", true)
 		, mOptions(Options)
 		, time(0)
-		, r_noise(0)
+		, p_noise_front(0)
 		, magnitude(n_dec_magn * Options.Scale)
 		, mGPUNormalMapManager(0)
 	{
@@ -69,10 +69,13 @@ namespace Hydrax{namespace Noise
 
 		Noise::create();
 		_initNoise();
+		_calculeNoise(time, p_noise[p_noise_front]);
 	}
 
 	void Perlin::remove()
 	{
+		_waitForNoiseTask();
+
 		if (areGPUNormalMapResourcesCreated())
 		{
 			Noise::removeGPUNormalMapResources(mGPUNormalMapManager);
@@ -90,6 +93,9 @@ namespace Hydrax{namespace Noise
 
 	void Perlin::setOptions(const Options &Options)
 	{
+		// The background generation reads the options
+		_waitForNoiseTask();
+
 		if (isCreated())
 		{
 			int Octaves_ = Options.Octaves;
@@ -366,8 +372,18 @@ namespace Hydrax{namespace Noise
 
 	void Perlin::update(const Ogre::Real &timeSinceLastFrame)
 	{
+		// The noise of this frame has been generated in the background during the last one
+		if (_waitForNoiseTask())
+		{
+			p_noise_front = 1 - p_noise_front;
+		}
+
+		// Generate the next one while the frame is being rendered
 		time += timeSinceLastFrame*mOptions.Animspeed;
-		_calculeNoise();
+
+		const double Time = time;
+		int *PackedNoise = p_noise[1 - p_noise_front];
+		_launchNoiseTask([this, Time, PackedNoise]() { _calculeNoise(Time, PackedNoise); });
 
 		if (areGPUNormalMapResourcesCreated())
 		{
@@ -393,7 +409,7 @@ namespace Hydrax{namespace Noise
 
 			for (int u = 0; u < np_size_sq; u++)
 			{
-				Data[u] = 32768+p_noise[u+Offset];//std::cout << p_noise[u+Offset] << std::endl;
+				Data[u] = 32768+p_noise[p_noise_front][u+Offset];//std::cout << p_noise[u+Offset] << std::endl;
 			}
 
 			PixelBuffer->unlock();
@@ -444,7 +460,7 @@ namespace Hydrax{namespace Noise
 		}
 	}
 
-	void Perlin::_calculeNoise()
+	void Perlin::_calculeNoise(const double &Time, int *PackedNoise)
 	{
 		int i, o, v, u,
 			multitable[max_octaves],
@@ -480,7 +496,7 @@ namespace Hydrax{namespace Noise
 
 		for(o=0; o<mOptions.Octaves; o++)
 		{
-			fraction = modf(time*r_timemulti,&dImage);
+			fraction = modf(Time*r_timemulti,&dImage);
 			iImage = static_cast<int>(dImage);
 
 			amount[0] = scale_magnitude*f_multitable[o]*(pow(sin((fraction+2)*PI_3),2)/1.5);
@@ -511,10 +527,10 @@ namespace Hydrax{namespace Noise
 				{
 					for(u=0; u<np_size; u++)
 					{
-						p_noise[v*np_size+u+octavepack*np_size_sq]  = o_noise[(o+3)*n_size_sq + (v&n_size_m1)*n_size + (u&n_size_m1)];
-						p_noise[v*np_size+u+octavepack*np_size_sq] += _mapSample( u, v, 3, o);
-						p_noise[v*np_size+u+octavepack*np_size_sq] += _mapSample( u, v, 2, o+1);
-						p_noise[v*np_size+u+octavepack*np_size_sq] += _mapSample( u, v, 1, o+2);
+						PackedNoise[v*np_size+u+octavepack*np_size_sq]  = o_noise[(o+3)*n_size_sq + (v&n_size_m1)*n_size + (u&n_size_m1)];
+						PackedNoise[v*np_size+u+octavepack*np_size_sq] += _mapSample( u, v, 3, o);
+						PackedNoise[v*np_size+u+octavepack*np_size_sq] += _mapSample( u, v, 2, o+1);
+						PackedNoise[v*np_size+u+octavepack*np_size_sq] += _mapSample( u, v, 1, o+2);
 					}
 				}
 
@@ -523,7 +539,7 @@ namespace Hydrax{namespace Noise
 		}
 	}
 
-	int Perlin::_readTexelLinearDual(const int &u, const int &v,const int &o)
+	int Perlin::_readTexelLinearDual(const int *r_noise, const int &u, const int &v,const int &o) const
 	{
 		int iu, iup, iv, ivp, fu, fv,
 			ut01, ut23, ut;
@@ -544,10 +560,10 @@ namespace Hydrax{namespace Noise
 		return ut;
 	}
 
-	float Perlin::_getHeigthDual(float u, float v)
+	float Perlin::_getHeigthDual(float u, float v) const
 	{
 		// Pointer to the current noise source octave
-		r_noise = p_noise;
+		const int *r_noise = p_noise[p_noise_front];
 
 		int ui = u*magnitude,
 		    vi = v*magnitude,
@@ -557,7 +573,7 @@ namespace Hydrax{namespace Noise
 
 		for(i=0; i<hoct; i++)
 		{
-			value += _readTexelLinearDual(ui,vi,0);
+			value += _readTexelLinearDual(r_noise,ui,vi,0);
 			ui = ui << n_packsize;
 			vi = vi << n_packsize;
 			r_noise += np_size_sq;
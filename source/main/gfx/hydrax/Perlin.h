@@ -229,27 +229,31 @@ namespace Hydrax{ namespace Noise
 		void _initNoise();
 
 		/** Calcule noise
+		    @param Time Elapsed (animation) time
+			@param PackedNoise Destination packed noise buffer
+			@remarks Runs on a worker thread, see update(...)
 		 */
-		void _calculeNoise();
+		void _calculeNoise(const double &Time, int *PackedNoise);
 
 		/** Update gpu normal map resources
 		 */
 		void _updateGPUNormalMapResources();
 
 		/** Read texel linear dual
+		    @param r_noise Current noise source octave
 		    @param u u
 			@param v v
 			@param o Octave
 			@return int
 		 */
-	    int _readTexelLinearDual(const int &u, const int &v, const int &o);
+	    int _readTexelLinearDual(const int *r_noise, const int &u, const int &v, const int &o) const;
 
 		/** Read texel linear
 		    @param u u
 			@param v v
 			@return Heigth
 		 */
-		float _getHeigthDual(float u, float v);
+		float _getHeigthDual(float u, float v) const;
 
 		/** Map sample
 		    @param u u
@@ -263,8 +267,10 @@ namespace Hydrax{ namespace Noise
 		/// Perlin noise variables
 		int noise[n_size_sq*noise_frames];
 		int o_noise[n_size_sq*max_octaves];
-		int p_noise[np_size_sq*(max_octaves>>(n_packsize-1))];
-		int *r_noise;
+		/// Packed noise, double buffered: the front one is read by getValue(...) and
+		/// the GPU normal map, the back one is written by the background generation
+		int p_noise[2][np_size_sq*(max_octaves>>(n_packsize-1))];
+		int p_noise_front;
 		float magnitude;
 
 		/// Elapsed time
@@ -96,17 +96,18 @@ float PressurePoint::getValue(const float &x, const float &y)
     if(mTime >= mT)
         return 0.f;
     //! 2nd.- Calculate distance decay factors
+    //! (kept local, the grid samples this from several threads)
     if(r >= R)
         return 0.f;
     #if _DECAYFUNCTION_ == 0
-        mK2 = 1.f - r/R;
+        float K2 = 1.f - r/R;
     #elif _DECAYFUNCTION_ == 1
-        mK2 = exp(_LN001_*r/R) - 0.01f;
+        float K2 = exp(_LN001_*r/R) - 0.01f;
     #elif _DECAYFUNCTION_ == 2
         float f = r/R2;
-        mK2 = 1.f - f;
+        float K2 = 1.f - f;
         r = f*R;
     #endif
     //! 3rd.- Calculate height
-    return mK1*mK2*mA*sin(mW*mTime - mK*r);
+    return mK1*K2*mA*sin(mW*mTime - mK*r);
 }
@@ -142,8 +142,6 @@ private:
     float mW;
     /// Time decay term
     float mK1;
-    /// Distance decay term
-    float mK2;
 
 };
 
@@ -30,7 +30,15 @@ http://www.cnblogs.com/ArenAK/archive/2007/11/07/951713.html
 
 #include <ProjectedGrid.h>
 
+#include "Application.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 #define _def_MaxFarClipDistance 99999
+#define _def_MinVerticesPerTask 4096
 
 namespace Hydrax{namespace Module
 {
@@ -287,35 +295,7 @@ namespace Hydrax{namespace Module
 		}
 		else if (mLastMinMax)
 		{
-			if (getNormalMode() == MaterialManager::NM_VERTEX)
-			{
-				Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
-
-				if (mOptions.ChoppyWaves)
-				{
-					for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		            {
-			            Vertices[i] = mVerticesChoppyBuffer[i];
-						Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		            }
-				}
-				else
-				{
-					for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		            {
-						Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		            }
-				}
-			}
-			else if (getNormalMode() == MaterialManager::NM_RTT)
-			{
-				Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
-
-				for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		        {
-				    Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		        }
-			}
+			_displaceVertices(RenderingCameraPos, getNormalMode() == MaterialManager::NM_VERTEX && mOptions.ChoppyWaves);
 
 			// Smooth the heightdata
 		    if (mOptions.Smooth)
@@ -407,7 +387,6 @@ namespace Hydrax{namespace Module
 
 					Vertices[i].x = result.x;
 					Vertices[i].z = result.z;
-					Vertices[i].y = -mBasePlane.d + mNoise->getValue(WorldPos.x + result.x, WorldPos.z + result.z)*mOptions.Strength;
 
 					i++;
 					u += du;
@@ -417,6 +396,8 @@ namespace Hydrax{namespace Module
 				_1_v = 1.0f-v;
 			}
 
+			_displaceVertices(WorldPos, false);
+
 			if (mOptions.ChoppyWaves)
 			{
 				for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
@@ -445,7 +426,6 @@ namespace Hydrax{namespace Module
 
 					Vertices[i].x = result.x;
 					Vertices[i].z = result.z;
-					Vertices[i].y = -mBasePlane.d + mNoise->getValue(WorldPos.x + result.x, WorldPos.z + result.z)*mOptions.Strength;
 
 					i++;
 					u += du;
@@ -454,6 +434,8 @@ namespace Hydrax{namespace Module
 				v += dv;
 				_1_v = 1.0f-v;
 			}
+
+			_displaceVertices(WorldPos, false);
 		}
 
 		// Smooth the heightdata
@@ -616,6 +598,62 @@ namespace Hydrax{namespace Module
 		}
 	}
 
+	void ProjectedGrid::_displaceVertices(const Ogre::Vector3& WorldPos, const bool& FromChoppyBuffer)
+	{
+		const int NumVertices = mOptions.Complexity*mOptions.Complexity;
+		const int NumTasks = std::max(1, std::min(NumVertices/_def_MinVerticesPerTask, RoR::App::app_num_workers->GetInt()));
+
+		std::vector<std::function<void()>> Tasks;
+		for (int k = 0; k < NumTasks; k++)
+		{
+			const int Start = (NumVertices*k)/NumTasks,
+			          End   = (NumVertices*(k+1))/NumTasks;
+
+			Tasks.push_back([this, WorldPos, FromChoppyBuffer, Start, End]()
+				{
+					_displaceVertices(WorldPos, FromChoppyBuffer, Start, End);
+				});
+		}
+
+		// The noise modules only read their front buffers in getValue(...)
+		RoR::App::GetThreadPool()->Parallelize(Tasks);
+	}
+
+	void ProjectedGrid::_displaceVertices(const Ogre::Vector3& WorldPos, const bool& FromChoppyBuffer, const int& Start, const int& End)
+	{
+		const float Height   = -mBasePlane.d,
+		            Strength = mOptions.Strength;
+
+		int i;
+
+		if (getNormalMode() == MaterialManager::NM_VERTEX)
+		{
+			Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
+
+			if (FromChoppyBuffer)
+			{
+				for(i = Start; i < End; i++)
+				{
+					Vertices[i] = mVerticesChoppyBuffer[i];
+				}
+			}
+
+			for(i = Start; i < End; i++)
+			{
+				Vertices[i].y = Height + mNoise->getValue(WorldPos.x + Vertices[i].x, WorldPos.z + Vertices[i].z)*Strength;
+			}
+		}
+		else if (getNormalMode() == MaterialManager::NM_RTT)
+		{
+			Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
+
+			for(i = Start; i < End; i++)
+			{
+				Vertices[i].y = Height + mNoise->getValue(WorldPos.x + Vertices[i].x, WorldPos.z + Vertices[i].z)*Strength;
+			}
+		}
+	}
+
 	// Check the point of intersection with the plane (0,1,0,0) and return the position in homogenous coordinates
 	Ogre::Vector4 ProjectedGrid::_calculeWorldPosition(const Ogre::Vector2 &uv, const Ogre::Matrix4& m, const Ogre::Matrix4& _viewMat)
 	{
@@ -210,6 +210,20 @@ namespace Hydrax{ namespace Module
 		 */
 		void _performChoppyWaves();
 
+		/** Displace the vertices with the noise, split in several tasks on the thread pool
+		    @param WorldPos Origin world position
+			@param FromChoppyBuffer Restore the vertices from the choppy waves buffer first
+		 */
+		void _displaceVertices(const Ogre::Vector3& WorldPos, const bool& FromChoppyBuffer);
+
+		/** Displace a range of vertices with the noise
+		    @param WorldPos Origin world position
+			@param FromChoppyBuffer Restore the vertices from the choppy waves buffer first
+			@param Start First vertex
+			@param End Last vertex + 1
+		 */
+		void _displaceVertices(const Ogre::Vector3& WorldPos, const bool& FromChoppyBuffer, const int& Start, const int& End);
+
 		/** Render geometry
 		    @param m Range
 			@param _viewMat View matrix
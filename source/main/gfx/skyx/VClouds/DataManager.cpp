@@ -26,17 +26,19 @@ http://www.gnu.org/copyleft/lesser.txt.
 #include "VClouds.h"
 #include "Ellipsoid.h"
 
+#include "Application.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+
 namespace SkyX { namespace VClouds
 {
 	DataManager::DataManager(VClouds *vc)
 		: mVClouds(vc)
-		, mCellsCurrent(0)
-		, mCellsTmp(0)
-		, mFFRandom(0)
 		, mNx(0), mNy(0), mNz(0)
 		, mCurrentTransition(0)
 		, mUpdateTime(10.0f)
-		, mStep(0), mXStart(0), mXEnd(0)
+		, mSimStage(SIM_IDLE)
 		, mMaxNumberOfClouds(250)
 		, mVolTexToUpdate(true)
 		, mCreated(false)
@@ -59,16 +61,25 @@ namespace SkyX { namespace VClouds
 			return;
 		}
 
+		// Wait for the workers before releasing the data
+		_advanceSimulation(true);
+		mSimStage = SIM_IDLE;
+
 		for (int k = 0; k < 2; k++)
 		{
 			Ogre::TextureManager::getSingleton().remove(mVolTextures[k]->getName());
 			mVolTextures[k].setNull();
 		}
 
-		_delete3DCellArray(mCellsCurrent, mNx, mNy);
-		_delete3DCellArray(mCellsTmp, mNx, mNy);
+		mCellsCurrent.clear();
+		mActTmp.clear();
+		mVolTexStaging.clear();
 
-		delete mFFRandom;
+		for (size_t k = 0; k < mFFRandoms.size(); k++)
+		{
+			delete mFFRandoms[k];
+		}
+		mFFRandoms.clear();
 
 		mNx = mNy = mNz = 0;
 
@@ -77,81 +88,42 @@ namespace SkyX { namespace VClouds
 
 	void DataManager::update(const Ogre::Real &timeSinceLastFrame)
 	{
+		_advanceSimulation(false);
+
+		// The next step is simulated in the background during a transition. Once the transition is over,
+		// the result is uploaded to the texture which isn't visible anymore; if it's not ready yet, the
+		// transition just waits at its end.
 		if (mVolTexToUpdate)
 		{
 			mCurrentTransition += timeSinceLastFrame;
 
-			mXEnd = static_cast<int>((mCurrentTransition / mUpdateTime)*4*mNx);
-			if (mXEnd > 4*mNx)
+			if (mCurrentTransition >= mUpdateTime)
 			{
-				mXEnd = 4*mNx;
-			}
+				mCurrentTransition = mUpdateTime;
 
-			if (mXEnd/mNx != mXStart/mNx)
-			{
-				for (int k = mStep; k <= mXEnd/mNx; k++)
+				if (mSimStage == SIM_READY)
 				{
-					_performCalculations(mNx, mNy, mNz, k, mXStart%mNx, (mXEnd/mNx != k) ? mNx : mXEnd%mNx);
-					mXStart = 0;
+					_uploadVolTextureData(VOL_TEX0);
+					mVolTexToUpdate = !mVolTexToUpdate;
+					_startSimulation();
 				}
 			}
-			else
-			{
-				if (mXStart != mXEnd)
-				{
-					_performCalculations(mNx, mNy, mNz, mXEnd/mNx, mXStart%mNx, mXEnd%mNx);
-				}
-			}
-
-			mStep = mXEnd/mNx;
-			mXStart = mXEnd;
-			
-			if (mCurrentTransition >= mUpdateTime)
-			{
-				_updateVolTextureData(mCellsCurrent, VOL_TEX0, mNx, mNy, mNz);
-
-				mCurrentTransition = mUpdateTime;
-				mVolTexToUpdate = !mVolTexToUpdate;
-				mStep = mXStart = mXEnd = 0;
-			}
 		}
 		else
 		{
 			mCurrentTransition -= timeSinceLastFrame;
 
-			mXEnd = static_cast<int>(((mUpdateTime-mCurrentTransition) / mUpdateTime)*4*mNx);
-			if (mXEnd < 0)
+			if (mCurrentTransition <= 0)
 			{
-				mXEnd = 0;
-			}
+				mCurrentTransition = 0;
 
-			if (mXEnd/mNx != mXStart/mNx)
-			{
-				for (int k = mStep; k <= mXEnd/mNx; k++)
+				if (mSimStage == SIM_READY)
 				{
-					_performCalculations(mNx, mNy, mNz, k, mXStart%mNx, (mXEnd/mNx != k) ? mNx : mXEnd%mNx);
-					mXStart = 0;
+					_uploadVolTextureData(VOL_TEX1);
+					mVolTexToUpdate = !mVolTexToUpdate;
+					_startSimulation();
 				}
 			}
-			else
-			{
-				if (mXStart != mXEnd)
-				{
-					_performCalculations(mNx, mNy, mNz, mXEnd/mNx, mXStart%mNx, mXEnd%mNx);
-				}
-			}
-
-			mStep = mXEnd/mNx;
-			mXStart = mXEnd;
-
-			if (mCurrentTransition <= 0)
-			{
-				_updateVolTextureData(mCellsCurrent, VOL_TEX1, mNx, mNy, mNz);
-
-				mCurrentTransition = 0;
-				mVolTexToUpdate = !mVolTexToUpdate;
-				mStep = mXStart = mXEnd = 0;
-			}
 		}
 	}
 
@@ -161,7 +133,11 @@ namespace SkyX { namespace VClouds
 
 		mNx = nx; mNy = ny; mNz = nz;
 
-		mFFRandom = new FastFakeRandom(1024, 0, 1);
+		const int numSlabs = std::max(1, std::min(RoR::App::app_num_workers->GetInt(), nx));
+		for (int k = 0; k < numSlabs; k++)
+		{
+			mFFRandoms.push_back(new FastFakeRandom(1024, 0, 1));
+		}
 
 		_initData(nx, ny, nz);
 
@@ -170,130 +146,122 @@ namespace SkyX { namespace VClouds
 			_createVolTexture(static_cast<VolTextureId>(k), nx, ny, nz);
 		}
 
-		_updateVolTextureData(mCellsCurrent, VOL_TEX0, mNx, mNy, mNz);
-		_updateVolTextureData(mCellsCurrent, VOL_TEX1, mNx, mNy, mNz);
+		_packVolTextureData(0, mNx);
+		_uploadVolTextureData(VOL_TEX0);
+		_uploadVolTextureData(VOL_TEX1);
 
 		mCreated = true;
+
+		_startSimulation();
 	}
 
 	void DataManager::forceToUpdateData()
 	{
 		// Finish current update process
-		_performCalculations(mNx, mNy, mNz, mStep, mXStart%mNx, mNx);
-		for (int k = mStep+1; k < 4; k++)
-		{
-			_performCalculations(mNx, mNy, mNz, k, 0, mNx);
-		}
-		mStep = mXStart = mXEnd = 0;
+		_advanceSimulation(true);
 
 		if (mVolTexToUpdate)
 		{
-			_updateVolTextureData(mCellsCurrent, VOL_TEX0, mNx, mNy, mNz);
+			_uploadVolTextureData(VOL_TEX0);
 			mCurrentTransition = mUpdateTime;
 		}
 		else
 		{
-			_updateVolTextureData(mCellsCurrent, VOL_TEX1, mNx, mNy, mNz);
+			_uploadVolTextureData(VOL_TEX1);
 			mCurrentTransition = 0;
 		}
 
 		mVolTexToUpdate = !mVolTexToUpdate;
+
+		_startSimulation();
 	}
 
 	void DataManager::_initData(const int& nx, const int& ny, const int& nz)
 	{
-		mCellsCurrent = _create3DCellArray(nx, ny, nz);
-		mCellsTmp     = _create3DCellArray(nx, ny, nz, false);
-	}
+		Cell init;
+		init.act = false;
+		init.cld = false;
+		init.hum = false;
 
-	DataManager::Cell *** DataManager::_create3DCellArray(const int& nx, const int& ny, const int& nz, const bool& init)
-	{
-		Cell ***c = new Cell** [nx];
+		init.pact = 0;
+		init.pext = 1;
+		init.phum = 0;
 
-		int u, v, w;
+		init.dens = 0.0f;
+		init.light = 1.0f;
 
-		for (u = 0; u < nx; u++)
-		{
-			c[u] = new Cell* [ny];
+		mCellsCurrent.assign(nx*ny*nz, init);
+		mActTmp.assign(nx*ny*nz, 0);
+		mVolTexStaging.assign(nx*ny*nz, 0);
+	}
 
-			for (v = 0; v < ny; v++)
-			{
-				 c[u][v] = new Cell[nz];
-			}
-		}
+	void DataManager::_startSimulation()
+	{
+		mSimSunDir = Ogre::Vector3(mVClouds->getSunDirection().x, mVClouds->getSunDirection().z, mVClouds->getSunDirection().y);
 
-		if (!init)
-		{
-			return c;
-		}
+		mSimStage = 0;
+		_launchSimStage(mSimStage);
+	}
 
-		for (u = 0; u < nx; u++)
+	void DataManager::_advanceSimulation(const bool& wait)
+	{
+		while (mSimStage != SIM_IDLE && mSimStage != SIM_READY)
 		{
-			for (v = 0; v < ny; v++)
+			for (size_t k = 0; k < mSimTasks.size(); k++)
 			{
-				for (w = 1; w < nz; w++)
+				if (wait)
 				{
-					c[u][v][w].act = false;
-					c[u][v][w].cld = false;
-					c[u][v][w].hum = false;
-
-					c[u][v][w].pact = 0;
-					c[u][v][w].pext = 1;
-					c[u][v][w].phum = 0;
-
-					c[u][v][w].dens = 0.0f;
-					c[u][v][w].light = 1.0f;
+					mSimTasks[k]->join();
+				}
+				else if (!mSimTasks[k]->is_finished())
+				{
+					return;
 				}
 			}
-		}
-
-		return c;
-	}
+			mSimTasks.clear();
 
-	void DataManager::_delete3DCellArray(Cell ***c, const int& nx, const int& ny)
-	{
-		int u, v;
-
-		for (u = 0; u < nx; u++)
-		{
-			for (v = 0; v < ny; v++)
+			mSimStage++;
+			if (mSimStage != SIM_READY)
 			{
-				delete [] c[u][v];
+				_launchSimStage(mSimStage);
 			}
 
-			delete [] c[u];
+			if (!wait)
+			{
+				return; // One stage per frame at most
+			}
 		}
-
-		delete [] c;
 	}
 
-	void DataManager::_copy3DCellArraysData(Cell ***src, Cell ***dest, const int& nx, const int& ny, const int& nz)
+	void DataManager::_launchSimStage(const int& stage)
 	{
-		int u, v, w;
+		const int numSlabs = static_cast<int>(mFFRandoms.size());
 
-		for (u = 0; u < nx; u++)
+		for (int k = 0; k < numSlabs; k++)
 		{
-			for (v = 0; v < ny; v++)
-			{
-				for (w = 0; w < nz; w++)
-				{
-					dest[u][v][w].act = src[u][v][w].act;
-					dest[u][v][w].cld = src[u][v][w].cld;
-					dest[u][v][w].hum = src[u][v][w].hum;
-
-					dest[u][v][w].pact = src[u][v][w].pact;
-					dest[u][v][w].pext = src[u][v][w].pext;
-					dest[u][v][w].phum = src[u][v][w].phum;
+			const int xStart = (mNx*k)/numSlabs;
+			const int xEnd = (mNx*(k + 1))/numSlabs;
+			FastFakeRandom* ffRandom = mFFRandoms[k];
 
-					dest[u][v][w].dens = src[u][v][w].dens;
-					dest[u][v][w].light = src[u][v][w].light;
-				}
-			}
+			mSimTasks.push_back(RoR::App::GetThreadPool()->RunTask([this, stage, xStart, xEnd, ffRandom]()
+				{
+					if (stage == SIM_PACK)
+					{
+						_packVolTextureData(xStart, xEnd);
+					}
+					else
+					{
+						_performCalculations(mNx, mNy, mNz, stage, xStart, xEnd, ffRandom);
+					}
+				}));
 		}
 	}
 
 	void DataManager::setWheater(const float& Humidity, const float& AverageCloudsSize, const bool& delayedResponse)
 	{
+		// The cells can't be touched while the workers run
+		_advanceSimulation(true);
+
 		int numberofclouds = static_cast<int>(Humidity * mMaxNumberOfClouds);
 		Ogre::Vector3 maxcloudsize = AverageCloudsSize*Ogre::Vector3(mNx/14, mNy/14, static_cast<int>(static_cast<float>(mNz)/2.75));
 
@@ -340,18 +308,17 @@ namespace SkyX { namespace VClouds
 			addEllipsoid(new Ellipsoid(newclouddimensions.x,  newclouddimensions.y,  newclouddimensions.z, mNx, mNy, mNz, (int)Ogre::Math::RangeRandom(0, mNx), (int)Ogre::Math::RangeRandom(0, mNy), static_cast<int>(Ogre::Math::RangeRandom(newclouddimensions.z+2,mNz-newclouddimensions.z-2)), Ogre::Math::RangeRandom(1,5.0f)), false);
 		}
 
-		_updateProbabilities(mCellsCurrent, mNx, mNy, mNz, delayedResponse);
+		_updateProbabilities(mCellsCurrent.data(), mNx, mNy, mNz, delayedResponse);
 
 		if (!delayedResponse)
 		{
-			for (int k = 0; k < 4; k++)
-			{
-				_performCalculations(mNx, mNy, mNz, k, 0, mNx);
-			}
-			mStep = mXStart = mXEnd = 0;
+			_startSimulation();
+			_advanceSimulation(true);
 
-			_updateVolTextureData(mCellsCurrent, VOL_TEX0, mNx, mNy, mNz);
-			_updateVolTextureData(mCellsCurrent, VOL_TEX1, mNx, mNy, mNz);
+			_uploadVolTextureData(VOL_TEX0);
+			_uploadVolTextureData(VOL_TEX1);
+
+			_startSimulation();
 		}
 	}
 
@@ -361,39 +328,34 @@ namespace SkyX { namespace VClouds
 
 		if (UpdateProbabilities)
 		{
-			e->updateProbabilities(mCellsCurrent,mNx,mNy,mNz);
+			_advanceSimulation(true);
+			e->updateProbabilities(mCellsCurrent.data(),mNx,mNy,mNz);
 		}
 	}
 
-	void DataManager::_clearProbabilities(Cell*** c, const int& nx, const int& ny, const int& nz, const bool& clearData)
+	void DataManager::_clearProbabilities(Cell* c, const int& nx, const int& ny, const int& nz, const bool& clearData)
 	{
-		int u, v, w;
+		const int n = nx*ny*nz;
 
-		for (u = 0; u < nx; u++)
+		for (int k = 0; k < n; k++)
 		{
-			for (v = 0; v < ny; v++)
-			{
-				for (w = 0; w < nz; w++)
-				{
-					c[u][v][w].pact = 0;
-					c[u][v][w].pext = 1;
-					c[u][v][w].phum = 0;
+			c[k].pact = 0;
+			c[k].pext = 1;
+			c[k].phum = 0;
 
-					if (clearData)
-					{
-						c[u][v][w].act = false;
-						c[u][v][w].cld = false;
-						c[u][v][w].hum = false;
+			if (clearData)
+			{
+				c[k].act = false;
+				c[k].cld = false;
+				c[k].hum = false;
 
-						c[u][v][w].dens = 0;
-						c[u][v][w].light = 0;
-					}
-				}
+				c[k].dens = 0;
+				c[k].light = 0;
 			}
 		}
 	}
 
-	void DataManager::_updateProbabilities(Cell*** c, const int& nx, const int& ny, const int& nz, const bool& delayedResponse)
+	void DataManager::_updateProbabilities(Cell* c, const int& nx, const int& ny, const int& nz, const bool& delayedResponse)
 	{
 		_clearProbabilities(c,nx,ny,nz,!delayedResponse);
 
@@ -405,7 +367,7 @@ namespace SkyX { namespace VClouds
 		}
 	}
 
-	const Ogre::Real DataManager::_getLightAbsorcionAt(Cell*** c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const Ogre::Vector3& d, const float& att) const
+	const Ogre::Real DataManager::_getLightAbsorcionAt(const Cell* c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const Ogre::Vector3& d, const float& att) const
 	{
 		Ogre::Real step = 1, factor = 1;
 		Ogre::Vector3 pos = Ogre::Vector3(x, y, z);
@@ -426,7 +388,7 @@ namespace SkyX { namespace VClouds
 				uu = (u<0) ? (u + nx) : u; if (u>=nx) { uu-= nx; }
 				vv = (v<0) ? (v + ny) : v; if (v>=ny) { vv-= ny; }
 
-				factor -= c[uu][vv][(int)pos.z].dens*att*(1-static_cast<float>(current_iteration)/max_iterations);
+				factor -= c[getCellIndex(uu, vv, (int)pos.z, ny, nz)].dens*att*(1-static_cast<float>(current_iteration)/max_iterations);
 				pos += step*(-d);
 
 				current_iteration++;
@@ -436,9 +398,11 @@ namespace SkyX { namespace VClouds
 		return Ogre::Math::Clamp<Ogre::Real>(factor,0,1);
 	}
 
-	void DataManager::_performCalculations(const int& nx, const int& ny, const int& nz, const int& step, const int& xStart, const int& xEnd)
+	void DataManager::_performCalculations(const int& nx, const int& ny, const int& nz, const int& step, const int& xStart, const int& xEnd, FastFakeRandom* ffRandom)
 	{
 		int u, v, w;
+		Cell *c = mCellsCurrent.data();
+		unsigned char *act = mActTmp.data();
 
 		switch (step)
 		{
@@ -450,13 +414,15 @@ namespace SkyX { namespace VClouds
 					{
 						for (w = 0; w < nz; w++)
 						{
+							Cell& cell = c[getCellIndex(u, v, w, ny, nz)];
+
 							// ti+1                       ti
-							mCellsCurrent[u][v][w].hum = mCellsCurrent[u][v][w].hum || (mFFRandom->get() < mCellsCurrent[u][v][w].phum);
-							mCellsCurrent[u][v][w].cld = mCellsCurrent[u][v][w].cld && (mFFRandom->get() > mCellsCurrent[u][v][w].pext);
-							mCellsCurrent[u][v][w].act = mCellsCurrent[u][v][w].act || (mFFRandom->get() < mCellsCurrent[u][v][w].pact);
+							cell.hum = cell.hum || (ffRandom->get() < cell.phum);
+							cell.cld = cell.cld && (ffRandom->get() > cell.pext);
+							cell.act = cell.act || (ffRandom->get() < cell.pact);
 
 							// Copy act in the temporal buffer, for _fact(...)
-							mCellsTmp[u][v][w].act = mCellsCurrent[u][v][w].act;
+							act[getCellIndex(u, v, w, ny, nz)] = cell.act;
 						}
 					}
 				}
@@ -470,10 +436,12 @@ namespace SkyX { namespace VClouds
 					{
 						for (w = 0; w < nz; w++)
 						{
+							Cell& cell = c[getCellIndex(u, v, w, ny, nz)];
+
 							// ti+1                       ti
-							mCellsCurrent[u][v][w].hum =  mCellsCurrent[u][v][w].hum && !mCellsCurrent[u][v][w].act;
-							mCellsCurrent[u][v][w].cld =  mCellsCurrent[u][v][w].cld ||  mCellsCurrent[u][v][w].act;
-							mCellsCurrent[u][v][w].act = !mCellsCurrent[u][v][w].act &&  mCellsCurrent[u][v][w].hum && _fact(mCellsTmp, nx, ny, nz, u,v,w);
+							cell.hum =  cell.hum && !cell.act;
+							cell.cld =  cell.cld ||  cell.act;
+							cell.act = !cell.act &&  cell.hum && _fact(act, nx, ny, nz, u,v,w);
 						}
 					}
 				}
@@ -488,8 +456,8 @@ namespace SkyX { namespace VClouds
 					{
 						for (w = 0; w < nz; w++)
 						{
-						   mCellsCurrent[u][v][w].dens = _getDensityAt(mCellsCurrent, nx, ny, nz, u,v,w, 1/*TODOOOO!!!*/, 1.15f);
-						  // mCellsCurrent[u][v][w].dens = _getDensityAt(mCellsCurrent,u,v,w);
+						   c[getCellIndex(u, v, w, ny, nz)].dens = _getDensityAt(c, nx, ny, nz, u,v,w, 1/*TODOOOO!!!*/, 1.15f);
+						  // c[getCellIndex(u, v, w, ny, nz)].dens = _getDensityAt(c,u,v,w);
 						}
 					}
 				}
@@ -498,15 +466,13 @@ namespace SkyX { namespace VClouds
 			case 3:
 			{
 				// Light scattering
-				Ogre::Vector3 SunDir = Ogre::Vector3(mVClouds->getSunDirection().x, mVClouds->getSunDirection().z, mVClouds->getSunDirection().y);
-
 				for (u = xStart; u < xEnd; u++)
 				{
 					for (v = 0; v < ny; v++)
 					{
 						for (w = 0; w < nz; w++)
 						{
-							mCellsCurrent[u][v][w].light = _getLightAbsorcionAt(mCellsCurrent, nx, ny, nz, u,v,w, SunDir, 0.15f/*TODO!!!!*/);
+							c[getCellIndex(u, v, w, ny, nz)].light = _getLightAbsorcionAt(c, nx, ny, nz, u,v,w, mSimSunDir, 0.15f/*TODO!!!!*/);
 						}
 					}
 				}
@@ -515,31 +481,31 @@ namespace SkyX { namespace VClouds
 		}
 	}
 
-	const bool DataManager::_fact(Cell ***c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z) const
+	const bool DataManager::_fact(const unsigned char *act, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z) const
 	{
 		bool i1m, j1m, k1m, 
 			 i1r, j1r, k1r, 
 			 i2r, i2m, j2r, j2m, k2r;
 
-		i1m = ((x+1)>=nx) ? c[0][y][z].act : c[x+1][y][z].act;
-		j1m = ((y+1)>=ny) ? c[x][0][z].act : c[x][y+1][z].act;
-		k1m = ((z+1)>=nz) ? false : c[x][y][z+1].act;
+		i1m = ((x+1)>=nx) ? act[getCellIndex(0,y,z,ny,nz)] : act[getCellIndex(x+1,y,z,ny,nz)];
+		j1m = ((y+1)>=ny) ? act[getCellIndex(x,0,z,ny,nz)] : act[getCellIndex(x,y+1,z,ny,nz)];
+		k1m = ((z+1)>=nz) ? false : act[getCellIndex(x,y,z+1,ny,nz)];
 
-		i1r = ((x-1)<0) ? c[nx-1][y][z].act : c[x-1][y][z].act;
-		j1r = ((y-1)<0) ? c[x][ny-1][z].act : c[x][y-1][z].act;
-		k1r = ((z-1)<0) ? false : c[x][y][z-1].act;
+		i1r = ((x-1)<0) ? act[getCellIndex(nx-1,y,z,ny,nz)] : act[getCellIndex(x-1,y,z,ny,nz)];
+		j1r = ((y-1)<0) ? act[getCellIndex(x,ny-1,z,ny,nz)] : act[getCellIndex(x,y-1,z,ny,nz)];
+		k1r = ((z-1)<0) ? false : act[getCellIndex(x,y,z-1,ny,nz)];
 
-		i2r = ((x-2)<0) ? c[nx-2][y][z].act : c[x-2][y][z].act;
-		j2r = ((y-2)<0) ? c[x][ny-2][z].act : c[x][y-2][z].act;
-		k2r = ((z-2)<0) ? false : c[x][y][z-2].act;
+		i2r = ((x-2)<0) ? act[getCellIndex(nx-2,y,z,ny,nz)] : act[getCellIndex(x-2,y,z,ny,nz)];
+		j2r = ((y-2)<0) ? act[getCellIndex(x,ny-2,z,ny,nz)] : act[getCellIndex(x,y-2,z,ny,nz)];
+		k2r = ((z-2)<0) ? false : act[getCellIndex(x,y,z-2,ny,nz)];
 
-		i2m = ((x+2)>=nx) ? c[1][y][z].act : c[x+2][y][z].act;
-		j2m = ((y+2)>=ny) ? c[x][1][z].act : c[x][y+2][z].act;
+		i2m = ((x+2)>=nx) ? act[getCellIndex(1,y,z,ny,nz)] : act[getCellIndex(x+2,y,z,ny,nz)];
+		j2m = ((y+2)>=ny) ? act[getCellIndex(x,1,z,ny,nz)] : act[getCellIndex(x,y+2,z,ny,nz)];
 
 		return i1m || j1m || k1m  || i1r || j1r || k1r || i2r || i2m || j2r || j2m || k2r;
 	}
 
-	const float DataManager::_getDensityAt(Cell ***c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const int& r, const float& strength) const
+	const float DataManager::_getDensityAt(const Cell *c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const int& r, const float& strength) const
 	{		
 		int zr = ((z-r)<0) ? 0 : z-r,
 			zm = ((z+r)>=nz) ? nz : z+r,
@@ -556,7 +522,7 @@ namespace SkyX { namespace VClouds
 					uu = (u<0) ? (u + nx) : u; if (u>=nx) { uu-= nx; }
 					vv = (v<0) ? (v + ny) : v; if (v>=ny) { vv-= ny; }
 
-					clouds += c[uu][vv][w].cld ? 1 : 0;
+					clouds += c[getCellIndex(uu, vv, w, ny, nz)].cld ? 1 : 0;
 					div++;
 				}
 			}
@@ -565,9 +531,9 @@ namespace SkyX { namespace VClouds
 		return Ogre::Math::Clamp<float>(strength*((float)clouds)/div, 0, 1);
 	}
 
-	const float DataManager::_getDensityAt(Cell ***c, const int& x, const int& y, const int& z) const
+	const float DataManager::_getDensityAt(const Cell *c, const int& x, const int& y, const int& z) const
 	{
-		return c[x][y][z].cld ? 1.0f : 0.0f;
+		return c[getCellIndex(x, y, z, mNy, mNz)].cld ? 1.0f : 0.0f;
 	}
 
 	void DataManager::_createVolTexture(const VolTextureId& TexId, const int& nx, const int& ny, const int& nz)
@@ -592,29 +558,29 @@ namespace SkyX { namespace VClouds
 				->setTextureName("_SkyX_VolCloudsData"+Ogre::StringConverter::toString(TexId), Ogre::TEX_TYPE_3D);
 	}
 
-	void DataManager::_updateVolTextureData(Cell ***c, const VolTextureId& TexId, const int& nx, const int& ny, const int& nz)
+	void DataManager::_packVolTextureData(const int& xStart, const int& xEnd)
+	{
+		const Cell *c = mCellsCurrent.data();
+
+		// Texture layout: x fastest, then y, then z
+		for (int z = 0; z < mNz; z++)
+		{
+			for (int y = 0; y < mNy; y++)
+			{
+				Ogre::uint32 *row = &mVolTexStaging[(z*mNy + y)*mNx];
+				for (int x = xStart; x < xEnd; x++)
+				{
+					const Cell& cell = c[getCellIndex(x, y, z, mNy, mNz)];
+					Ogre::PixelUtil::packColour(cell.dens/* TODO!!!! */, cell.light, 0, 0, Ogre::PF_BYTE_RGBA, &row[x]);
+				}
+			}
+		}
+	}
+
+	void DataManager::_uploadVolTextureData(const VolTextureId& TexId)
 	{
 		Ogre::HardwarePixelBufferSharedPtr buffer = mVolTextures[TexId]->getBuffer(0,0);
-		
-		buffer->lock(Ogre::HardwareBuffer::HBL_DISCARD);
-		const Ogre::PixelBox &pb = buffer->getCurrentLock();
-
-                 Ogre::uint32 *pbptr = reinterpret_cast<Ogre::uint32*>(pb.data);
-                 size_t x, y, z;
-
-                 for (z = pb.front; z < pb.back; z++)
-            {
-                for (y = pb.top; y < pb.bottom; y++)
-                {
-                    for (x = pb.left; x < pb.right; x++)
-                    {
-                        Ogre::PixelUtil::packColour (c[x][y][z].dens/* TODO!!!! */, c[x][y][z].light, 0, 0, pb.format, &pbptr[x]);
-                    }
-                    pbptr += pb.rowPitch;
-                }
-                pbptr += pb.getSliceSkip ();
-            }
-
-		buffer->unlock();
+
+		buffer->blitFromMemory(Ogre::PixelBox(mNx, mNy, mNz, Ogre::PF_BYTE_RGBA, mVolTexStaging.data()));
 	}
-}}
\ No newline at end of file
+}}
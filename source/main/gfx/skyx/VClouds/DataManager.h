@@ -28,6 +28,11 @@ http://www.gnu.org/copyleft/lesser.txt.
 
 #include "FastFakeRandom.h"
 
+#include <memory>
+#include <vector>
+
+namespace RoR { class Task; }
+
 namespace SkyX { namespace VClouds{
 
 	class VClouds;
@@ -140,8 +145,30 @@ namespace SkyX { namespace VClouds{
 		 */
 		void forceToUpdateData();
 
+		/** Get the index of a cell in the flat cell array
+		    @param x x Coord
+			@param y y Coord
+			@param z z Coord
+			@param ny Y size
+			@param nz Z size
+			@return Index, cells are stored x-major
+		 */
+		static inline int getCellIndex(const int& x, const int& y, const int& z, const int& ny, const int& nz)
+		{
+			return (x*ny + y)*nz + z;
+		}
+
 	private:
 
+		/** Background simulation stages, see _advanceSimulation(...)
+		 */
+		enum SimStage
+		{
+			SIM_IDLE = -1,
+			SIM_PACK = 4,  // Steps 0-3 are the celullar automata steps
+			SIM_READY = 5
+		};
+
 		/** Initialize data
 		    @param nx X complexity
 			@param ny Y complexity
@@ -149,30 +176,19 @@ namespace SkyX { namespace VClouds{
 		 */
 		void _initData(const int& nx, const int& ny, const int& nz);
 
-		/** Create tridimensional cell array
-			@param nx X size
-			@param ny Y size
-			@param nz Z size
-			@param init Initialize values
-			@return Cell 3d pointer
+		/** Start calculating the next simulation step in the background (main thread)
 		 */
-		Cell *** _create3DCellArray(const int& nx, const int& ny, const int& nz, const bool& init = true);
+		void _startSimulation();
 
-		/** Delete tridimensional cell array
-			@param c Cell pointer to be deleted
-			@param nx X size
-			@param ny Y size
+		/** Launch the next simulation stage once the running one has finished (main thread)
+		    @param wait true to block until the whole simulation step is ready
 		 */
-		void _delete3DCellArray(Cell ***c, const int& nx, const int& ny);
+		void _advanceSimulation(const bool& wait);
 
-		/** Copy 3d cells arrays data
-			@param src Source
-			@param dest Dest
-			@param nx X size
-			@param ny Y size
-			@param nz Z size
-		*/
-		void _copy3DCellArraysData(Cell ***src, Cell ***dest, const int& nx, const int& ny, const int& nz);
+		/** Split a simulation stage into x slabs and run them on the worker pool
+		    @param stage Simulation stage
+		 */
+		void _launchSimStage(const int& stage);
 
 		/** Perform celullar automata simulation
 		    @param nx X size
@@ -181,17 +197,20 @@ namespace SkyX { namespace VClouds{
 			@param step Calculation step. Valid steps are 0,1,2,3.
 			@param xStart x start cell (included)
 			@param xEnd x end cell (not included, until xEnd-1)
+			@param ffRandom Random source of the calling task
 		 */
-		void _performCalculations(const int& nx, const int& ny, const int& nz, const int& step, const int& xStart, const int& xEnd);
+		void _performCalculations(const int& nx, const int& ny, const int& nz, const int& step, const int& xStart, const int& xEnd, FastFakeRandom* ffRandom);
 
-		/** Update volumetric texture data
-		    @param c Cells data
+		/** Pack cells into the volumetric texture staging buffer
+			@param xStart x start cell (included)
+			@param xEnd x end cell (not included, until xEnd-1)
+		 */
+		void _packVolTextureData(const int& xStart, const int& xEnd);
+
+		/** Upload the staging buffer to a volumetric texture
 			@param TexId Texture Id
-		    @param nx X size
-			@param ny Y size
-			@param nz Z size
 		 */
-		void _updateVolTextureData(Cell ***c, const VolTextureId& TexId, const int& nx, const int& ny, const int& nz);
+		void _uploadVolTextureData(const VolTextureId& TexId);
 
 		/** Get continous density at a point
 		    @param c Cells data
@@ -204,7 +223,7 @@ namespace SkyX { namespace VClouds{
 			@param r Radius
 			@param sgtrength Strength
 		 */	
-		const float _getDensityAt(Cell ***c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const int& r, const float& strength) const;
+		const float _getDensityAt(const Cell *c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const int& r, const float& strength) const;
 
 		/** Get discrete density at a point
 		    @param c Cells data
@@ -212,10 +231,10 @@ namespace SkyX { namespace VClouds{
 			@param y y Coord
 			@param z z Coord 
 		 */	
-		const float _getDensityAt(Cell ***c, const int& x, const int& y, const int& z) const;
+		const float _getDensityAt(const Cell *c, const int& x, const int& y, const int& z) const;
 
 		/** Fact funtion
-		    @param c Cells data
+		    @param act Activation flags
 			@param nx X size
 			@param ny Y size
 			@param nz Z size
@@ -223,7 +242,7 @@ namespace SkyX { namespace VClouds{
 			@param y y Coord
 			@param z z Coord 
 		 */
-		const bool _fact(Cell ***c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z) const;
+		const bool _fact(const unsigned char *act, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z) const;
 
 		/** Clear probabilities
 		    @param c Cells data
@@ -232,7 +251,7 @@ namespace SkyX { namespace VClouds{
 			@param nz Z size
 			@param clearData Clear data?
 		 */
-		void _clearProbabilities(Cell*** c, const int& nx, const int& ny, const int& nz, const bool& clearData);
+		void _clearProbabilities(Cell* c, const int& nx, const int& ny, const int& nz, const bool& clearData);
 
 		/** Update probabilities based from the Ellipsoid vector
 		    @param c Cells data
@@ -241,7 +260,7 @@ namespace SkyX { namespace VClouds{
 			@param nz Z size
 			@param delayedResponse false to change wheather conditions over several updates, true to change it at the moment
 		 */
-		void _updateProbabilities(Cell*** c, const int& nx, const int& ny, const int& nz, const bool& delayedResponse);
+		void _updateProbabilities(Cell* c, const int& nx, const int& ny, const int& nz, const bool& delayedResponse);
 
 		/** Get light absorcion factor at a point
 			@param c Cells data
@@ -254,7 +273,7 @@ namespace SkyX { namespace VClouds{
 			@param d Light direction
 			@param att Attenuation factor
 		 */
-		const Ogre::Real _getLightAbsorcionAt(Cell*** c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const Ogre::Vector3& d, const float& att) const;
+		const Ogre::Real _getLightAbsorcionAt(const Cell* c, const int& nx, const int& ny, const int& nz, const int& x, const int& y, const int& z, const Ogre::Vector3& d, const float& att) const;
 
 		/** Create volumetric texture
 			@param TexId Texture Id
@@ -264,16 +283,24 @@ namespace SkyX { namespace VClouds{
 		 */
 		void _createVolTexture(const VolTextureId& TexId, const int& nx, const int& ny, const int& nz);
 
-		/// Simulation data
-		Cell ***mCellsCurrent,
-			 ***mCellsTmp;
+		/// Simulation data, flat x-major arrays (see getCellIndex(...))
+		std::vector<Cell> mCellsCurrent;
+		/// Copy of the activation flags for _fact(...)
+		std::vector<unsigned char> mActTmp;
 
 		/// Current transition
 		float mCurrentTransition;
 		/// Update time
 		float mUpdateTime;
-		/// Current calculation state
-		int mStep, mXStart, mXEnd;
+
+		/// Background simulation stage, see SimStage
+		int mSimStage;
+		/// Worker tasks of the running stage
+		std::vector<std::shared_ptr<RoR::Task>> mSimTasks;
+		/// Sun direction used by the running simulation step
+		Ogre::Vector3 mSimSunDir;
+		/// Packed volumetric texture data of the last simulation step
+		std::vector<Ogre::uint32> mVolTexStaging;
 
 		/// Complexities
 		int mNx, mNy, mNz;
@@ -286,8 +313,8 @@ namespace SkyX { namespace VClouds{
 		/// Has been create(...) already called?
 		bool mCreated;
 
-		/// Fast fake random
-		FastFakeRandom *mFFRandom;
+		/// Fast fake random, one per worker slab
+		std::vector<FastFakeRandom*> mFFRandoms;
 
 		/// Max number of clouds(Ellipsoids)
 		int mMaxNumberOfClouds;
@@ -79,7 +79,7 @@ namespace SkyX { namespace VClouds
 		return Ogre::Vector3(density, 1-density, density);
 	}
 
-    void Ellipsoid::updateProbabilities(DataManager::Cell ***c, const int &nx, const int &ny, const int &nz, const bool& delayedResponse)
+    void Ellipsoid::updateProbabilities(DataManager::Cell *c, const int &nx, const int &ny, const int &nz, const bool& delayedResponse)
 	{
 		int u, v, w, uu, vv;
 
@@ -99,13 +99,13 @@ namespace SkyX { namespace VClouds
 
 					if (length < 1)
 					{
-						c[uu][vv][w].phum = 0.005f;
-						c[uu][vv][w].pext = 0.05f;
-						c[uu][vv][w].pact = 0.01f;
+						c[DataManager::getCellIndex(uu,vv,w,ny,nz)].phum = 0.005f;
+						c[DataManager::getCellIndex(uu,vv,w,ny,nz)].pext = 0.05f;
+						c[DataManager::getCellIndex(uu,vv,w,ny,nz)].pact = 0.01f;
 
 						if (!delayedResponse)
 						{
-							c[uu][vv][w].cld = Ogre::Math::RangeRandom(0,1) > length ? true : false;
+							c[DataManager::getCellIndex(uu,vv,w,ny,nz)].cld = Ogre::Math::RangeRandom(0,1) > length ? true : false;
 						}
 					}
 				}
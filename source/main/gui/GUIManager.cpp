@@ -55,6 +55,7 @@
 #include "GUI_NodeBeamUtils.h"
 #include "GUI_DirectionArrow.h"
 #include "GUI_SimActorStats.h"
+#include "GUI_ProfilerWindow.h"
 #include "GUI_SimPerfStats.h"
 #include "GUI_SurveyMap.h"
 #include "GUI_TextureToolWindow.h"
@@ -91,6 +92,7 @@ struct GuiManagerImpl
     GUI::TextureToolWindow      panel_TextureToolWindow;
     GUI::GameControls           panel_GameControls;
     GUI::NodeBeamUtils          panel_NodeBeamUtils;
+    GUI::ProfilerWindow         panel_ProfilerWindow;
     GUI::LoadingWindow          panel_LoadingWindow;
     GUI::TopMenubar             panel_TopMenubar;
     GUI::ConsoleWindow          panel_ConsoleWindow;
@@ -114,6 +116,7 @@ void GUIManager::SetVisible_LoadingWindow       (bool v) { m_impl->panel_Loading
 void GUIManager::SetVisible_Console             (bool v) { m_impl->panel_ConsoleWindow      .SetVisible(v); }
 void GUIManager::SetVisible_GameSettings        (bool v) { m_impl->panel_GameSettings       .SetVisible(v); }
 void GUIManager::SetVisible_NodeBeamUtils       (bool v) { m_impl->panel_NodeBeamUtils      .SetVisible(v); }
+void GUIManager::SetVisible_ProfilerWindow      (bool v) { m_impl->panel_ProfilerWindow     .SetVisible(v); }
 void GUIManager::SetVisible_SimActorStats       (bool v) { m_impl->panel_SimActorStats      .SetVisible(v); }
 void GUIManager::SetVisible_SimPerfStats        (bool v) { m_impl->panel_SimPerfStats       .SetVisible(v); }
 
@@ -131,6 +134,7 @@ bool GUIManager::IsVisible_Console              () { return m_impl->panel_Consol
 bool GUIManager::IsVisible_GameSettings         () { return m_impl->panel_GameSettings       .IsVisible(); }
 bool GUIManager::IsVisible_TopMenubar           () { return m_impl->panel_TopMenubar         .IsVisible(); }
 bool GUIManager::IsVisible_NodeBeamUtils        () { return m_impl->panel_NodeBeamUtils      .IsVisible(); }
+bool GUIManager::IsVisible_ProfilerWindow       () { return m_impl->panel_ProfilerWindow     .IsVisible(); }
 bool GUIManager::IsVisible_SimActorStats        () { return m_impl->panel_SimActorStats      .IsVisible(); }
 bool GUIManager::IsVisible_SimPerfStats         () { return m_impl->panel_SimPerfStats       .IsVisible(); }
 bool GUIManager::IsVisible_SurveyMap            () { return m_impl->panel_SurveyMap          .IsVisible(); }
@@ -232,6 +236,11 @@ void GUIManager::DrawSimulationGui(float dt)
         m_impl->panel_NodeBeamUtils.Draw();
     }
 
+    if (m_impl->panel_ProfilerWindow.IsVisible())
+    {
+        m_impl->panel_ProfilerWindow.Draw();
+    }
+
     if (m_impl->panel_MessageBox.IsVisible())
     {
         m_impl->panel_MessageBox.Draw();
@@ -82,6 +82,7 @@ public:
     void SetVisible_TextureToolWindow   (bool visible);
     void SetVisible_GameControls        (bool visible);
     void SetVisible_NodeBeamUtils       (bool visible);
+    void SetVisible_ProfilerWindow      (bool visible);
     void SetVisible_LoadingWindow       (bool visible);
     void SetVisible_Console             (bool visible);
     void SetVisible_SimActorStats       (bool visible);
@@ -100,6 +101,7 @@ public:
     bool IsVisible_TextureToolWindow    ();
     bool IsVisible_GameControls         ();
     bool IsVisible_NodeBeamUtils        ();
+    bool IsVisible_ProfilerWindow       ();
     bool IsVisible_LoadingWindow        ();
     bool IsVisible_Console              ();
     bool IsVisible_SimActorStats        ();
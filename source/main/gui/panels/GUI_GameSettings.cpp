@@ -208,6 +208,7 @@ void GameSettings::Draw()
         {
             DrawGIntBox(App::sim_replay_length, _LC("GameSettings", "Replay length"));
             DrawGIntBox(App::sim_replay_stepping, _LC("GameSettings", "Replay stepping"));
+            DrawGCheckbox(App::sim_replay_spill, _LC("GameSettings", "Store older replay frames on disk"));
         }
 
         DrawGCheckbox(App::sim_realistic_commands, _LC("GameSettings", "Realistic forward commands"));
@@ -325,6 +326,16 @@ void GameSettings::Draw()
             ImGui::PopItemWidth();
         }
 
+        DrawGCheckbox(App::gfx_flexbody_lod,     _LC("GameSettings", "Flexbody level of detail"));
+        if (App::gfx_flexbody_lod->GetBool())
+        {
+            ImGui::PushItemWidth(125.f); // Width includes [+/-] buttons
+            DrawGFloatBox(App::gfx_flexbody_lod_near, _LC("GameSettings", "Flexbody LOD: full rate within (m)"));
+            DrawGFloatBox(App::gfx_flexbody_lod_far,  _LC("GameSettings", "Flexbody LOD: rigid beyond (m)"));
+            DrawGIntSlider(App::gfx_flexbody_lod_max_skip, _LC("GameSettings", "Flexbody LOD: max skipped frames"), 0, 10);
+            ImGui::PopItemWidth();
+        }
+
         DrawGCheckbox(App::gfx_enable_videocams, _LC("GameSettings", "Render video cameras"));
         DrawGCheckbox(App::gfx_surveymap_icons,  _LC("GameSettings", "Overview map icons"));
         if (App::gfx_surveymap_icons->GetBool())
@@ -0,0 +1,137 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GUI_ProfilerWindow.h"
+
+#include "Application.h"
+#include "GUIManager.h"
+#include "GUIUtils.h"
+#include "Language.h"
+#include "Profiler.h"
+
+#include <map>
+#include <tuple>
+
+using namespace RoR;
+using namespace GUI;
+
+void ProfilerWindow::Draw()
+{
+    const int flags = ImGuiWindowFlags_NoCollapse;
+    ImGui::SetNextWindowSize(ImVec2(450.f, 500.f), ImGuiCond_FirstUseEver);
+    bool keep_open = true;
+    ImGui::Begin(_LC("Profiler", "Profiler"), &keep_open, flags);
+
+    Profiler* profiler = App::GetProfiler();
+
+    DrawGCheckbox(App::diag_profiler, _LC("Profiler", "Enabled"));
+    if (App::diag_profiler->GetBool())
+    {
+        ImGui::SameLine();
+        if (!profiler->IsCapturing() && ImGui::Button(_LC("Profiler", "Start capture")))
+        {
+            profiler->StartCapture();
+        }
+        else if (profiler->IsCapturing() && ImGui::Button(_LC("Profiler", "Stop and save capture")))
+        {
+            profiler->StopCapture();
+        }
+        if (profiler->IsCapturing())
+        {
+            ImGui::SameLine();
+            ImGui::Text(_LC("Profiler", "%d events"), static_cast<int>(profiler->GetNumCapturedEvents()));
+        }
+    }
+    if (profiler->GetLastCapturePath() != "")
+    {
+        ImGui::TextColored(GRAY_HINT_TEXT, _LC("Profiler", "Last capture: %s"), profiler->GetLastCapturePath().c_str());
+    }
+    ImGui::Separator();
+
+    // Sum up zones per thread, keyed by nesting depth, name and ID; keep order of first appearance.
+    std::vector<ProfilerEvent> const& events = profiler->GetFrameEvents();
+    std::map<std::tuple<int, const char*, int>, size_t> lookup;
+    size_t i = 0;
+    while (i < events.size())
+    {
+        const int thread = events[i].pe_thread;
+        m_rows.clear();
+        lookup.clear();
+        for (; i < events.size() && events[i].pe_thread == thread; i++)
+        {
+            ProfilerEvent const& ev = events[i];
+            auto key = std::make_tuple(ev.pe_depth, ev.pe_name, ev.pe_id);
+            auto found = lookup.find(key);
+            if (found == lookup.end())
+            {
+                lookup.insert(std::make_pair(key, m_rows.size()));
+                ZoneRow row;
+                row.zr_name = ev.pe_name;
+                row.zr_id = ev.pe_id;
+                row.zr_depth = ev.pe_depth;
+                row.zr_count = 1;
+                row.zr_total_us = ev.pe_duration_us;
+                m_rows.push_back(row);
+            }
+            else
+            {
+                m_rows[found->second].zr_count++;
+                m_rows[found->second].zr_total_us += ev.pe_duration_us;
+            }
+        }
+
+        char title[50];
+        snprintf(title, 50, "%s %d", (thread == profiler->GetMainThreadIndex()) ? "Main" : "Worker", thread);
+        if (ImGui::CollapsingHeader(title, ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            ImGui::PushID(thread);
+            this->DrawThread(m_rows);
+            ImGui::PopID();
+        }
+    }
+
+    App::GetGuiManager()->RequestGuiCaptureKeyboard(ImGui::IsWindowHovered());
+    ImGui::End();
+    if (!keep_open)
+    {
+        this->SetVisible(false);
+    }
+}
+
+void ProfilerWindow::DrawThread(std::vector<ZoneRow> const& rows)
+{
+    ImGui::Columns(3);
+    for (ZoneRow const& row: rows)
+    {
+        ImGui::Indent(row.zr_depth * 10.f + 1.f);
+        if (row.zr_id != -1)
+            ImGui::Text("%s #%d", row.zr_name, row.zr_id);
+        else
+            ImGui::Text("%s", row.zr_name);
+        ImGui::Unindent(row.zr_depth * 10.f + 1.f);
+        ImGui::NextColumn();
+        ImGui::Text("%.3f ms", row.zr_total_us / 1000.f);
+        ImGui::NextColumn();
+        ImGui::TextColored(GRAY_HINT_TEXT, "x%d", row.zr_count);
+        ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+}
@@ -0,0 +1,60 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "Application.h"
+#include "OgreImGui.h"
+
+#include <vector>
+
+namespace RoR {
+namespace GUI {
+
+/// Displays zones collected by `RoR::Profiler` in the last frame, summed per thread.
+class ProfilerWindow
+{
+public:
+    void Draw();
+
+    bool IsVisible() const { return m_is_visible; }
+    void SetVisible(bool v) { m_is_visible = v; }
+
+private:
+    struct ZoneRow
+    {
+        const char* zr_name;
+        int         zr_id;
+        int         zr_depth;
+        int         zr_count;
+        int64_t     zr_total_us;
+    };
+
+    void DrawThread(std::vector<ZoneRow> const& rows);
+
+    bool                 m_is_visible = false;
+    std::vector<ZoneRow> m_rows; //!< Reused between frames.
+
+    const ImVec4 GRAY_HINT_TEXT = ImVec4(0.62f, 0.62f, 0.61f, 1.f);
+};
+
+} // namespace GUI
+} // namespace RoR
@@ -514,6 +514,12 @@ void TopMenubar::Update()
                 }
             }
 
+            if (ImGui::Button(_LC("TopMenubar", "Profiler")))
+            {
+                App::GetGuiManager()->SetVisible_ProfilerWindow(true);
+                m_open_menu = TopMenu::TOPMENU_NONE;
+            }
+
             ImGui::Separator();
             ImGui::TextColored(GRAY_HINT_TEXT, _LC("TopMenubar", "Pre-spawn diag. options:"));
 
@@ -44,11 +44,13 @@
 #include "OutGauge.h"
 #include "OverlayWrapper.h"
 #include "PlatformUtils.h"
+#include "Profiler.h"
 #include "RoRVersion.h"
 #include "ScriptEngine.h"
 #include "Skidmark.h"
 #include "SoundScriptManager.h"
 #include "TerrainManager.h"
+#include "TerrainObjectManager.h"
 #include "Utils.h"
 #include <Overlay/OgreOverlaySystem.h>
 #include <ctime>
@@ -94,6 +96,7 @@ int main(int argc, char *argv[])
         App::sys_cache_dir     ->SetStr(PathCombine(App::sys_user_dir->GetStr(), "cache"));
         App::sys_savegames_dir ->SetStr(PathCombine(App::sys_user_dir->GetStr(), "savegames"));
         App::sys_screenshot_dir->SetStr(PathCombine(App::sys_user_dir->GetStr(), "screenshots"));
+        App::sys_profiler_dir  ->SetStr(PathCombine(App::sys_user_dir->GetStr(), "profiler"));
 
         // Load RoR.cfg - updates cvars
         App::GetConsole()->LoadConfig();
@@ -753,6 +756,7 @@ int main(int argc, char *argv[])
             // Process input events
             if (dt != 0.f)
             {
+                ROR_PROFILE_ZONE("Input");
                 App::GetInputEngine()->Capture();
                 App::GetInputEngine()->updateKeyBounces(dt);
 
@@ -818,6 +822,7 @@ int main(int argc, char *argv[])
             App::GetGuiManager()->NewImGuiFrame(dt);
             if (App::app_state->GetEnum<AppState>() == AppState::SIMULATION)
             {
+                ROR_PROFILE_ZONE("Early GUI");
                 App::GetGuiManager()->DrawSimulationGui(dt);
                 for (auto actor : App::GetGameContext()->GetActorManager()->GetActors())
                 {
@@ -868,6 +873,14 @@ int main(int argc, char *argv[])
                 App::GetGfxScene()->BufferSimulationData();
             }
 
+            // Terrain object paging - adds/removes collisions, the previous physics task must be finished
+            if (App::app_state->GetEnum<AppState>() == AppState::SIMULATION && App::GetSimTerrain() &&
+                App::sim_object_paging->GetBool())
+            {
+                App::GetGameContext()->GetActorManager()->SyncWithSimThread();
+                App::GetSimTerrain()->getObjectManager()->UpdateObjectPaging();
+            }
+
             // Advance simulation
             if (App::sim_state->GetEnum<SimState>() == SimState::RUNNING)
             {
@@ -892,6 +905,7 @@ int main(int argc, char *argv[])
             }
             else
             {
+                ROR_PROFILE_ZONE("Render");
                 App::GetAppContext()->GetOgreRoot()->renderOneFrame();
                 if (!render_window->isActive() && render_window->isVisible())
                 {
@@ -901,6 +915,8 @@ int main(int argc, char *argv[])
 
             App::GetGuiManager()->ApplyGuiCaptureKeyboard();
 
+            App::GetProfiler()->EndFrame();
+
         } // End of main rendering/input loop
 
 #ifndef _DEBUG
@@ -96,6 +96,9 @@ Actor::~Actor()
     }
 #endif // USE_OPENAL
     StopAllSounds();
+#ifdef USE_OPENAL
+    App::GetSoundScriptManager()->removeActorRouting(ar_instance_id);
+#endif // USE_OPENAL
 
     if (ar_engine != nullptr)
     {
@@ -321,6 +324,7 @@ void Actor::ScaleActor(float value)
     updateSlideNodePositions();
 
     m_gfx_actor->ScaleActor(relpos, value);
+    m_gfx_actor->InvalidateSimSnapshot();
 
 }
 
@@ -1151,6 +1155,7 @@ void Actor::ResetAngle(float rot)
 
     this->UpdateBoundingBoxes();
     calculateAveragePosition();
+    m_gfx_actor->InvalidateSimSnapshot();
 }
 
 void Actor::UpdateInitPosition()
@@ -1242,6 +1247,7 @@ void Actor::ResetPosition(Vector3 translation, bool setInitPosition)
 
     this->UpdateBoundingBoxes();
     calculateAveragePosition();
+    m_gfx_actor->InvalidateSimSnapshot();
 }
 
 void Actor::HandleMouseMove(int node, Vector3 pos, float force)
@@ -1525,6 +1531,7 @@ void Actor::SyncReset(bool reset_position)
         ar_nodes[i].Velocity = Vector3::ZERO;
         ar_nodes[i].Forces = Vector3::ZERO;
     }
+    m_gfx_actor->InvalidateSimSnapshot();
 
     for (int i = 0; i < ar_num_beams; i++)
     {
@@ -1751,7 +1758,7 @@ void Actor::SearchBeamDefaults()
     this->CalcForcesEulerPrepare(true);
     for (int i = 0; i < ar_nb_skip_steps; i++)
     {
-        this->CalcForcesEulerCompute(i == 0, ar_nb_skip_steps);
+        this->CalcForcesEulerCompute(i == 0, ar_nb_skip_steps, IWater::GetWavesClock());
         if (m_ongoing_reset)
             break;
     }
@@ -1766,7 +1773,7 @@ void Actor::SearchBeamDefaults()
     int sum_broken = 0;
     for (int k = 0; k < ar_nb_measure_steps; k++)
     {
-        this->CalcForcesEulerCompute(false, ar_nb_measure_steps);
+        this->CalcForcesEulerCompute(false, ar_nb_measure_steps, IWater::GetWavesClock());
         for (int i = 0; i < ar_num_nodes; i++)
         {
             float v = ar_nodes[i].Velocity.length();
@@ -2871,7 +2878,7 @@ void Actor::updateSkidmarks()
             }
             if (n->nd_avg_collision_slip > 6.f && n->nd_last_collision_slip.squaredLength() > 9.f)
             {
-                m_skid_trails[i]->update(n->AbsPosition, j, n->nd_avg_collision_slip, n->nd_last_collision_gm->name);
+                m_skid_trails[i]->update(n->AbsPosition, j, n->nd_avg_collision_slip, n->nd_last_collision_gm);
                 return;
             }
         }
@@ -42,6 +42,7 @@ class Actor : public ZeroedMemoryAllocator
     friend class ActorSpawner;
     friend class ActorManager;
     friend class GfxActor; // Temporary until all visuals are moved there. ~ only_a_ptr, 2018
+    friend class ActorBenchmark; // Micro-benchmarks, see 'source/microbenchmarks/Bench_Physics.cpp'
 public:
 
     enum class SimState
@@ -377,12 +378,12 @@ public:
 private:
 
     bool              CalcForcesEulerPrepare(bool doUpdate); 
-    void              CalcAircraftForces(bool doUpdate);   
-    void              CalcForcesEulerCompute(bool doUpdate, int num_steps); 
+    void              CalcAircraftForces(bool doUpdate, float waves_time);
+    void              CalcForcesEulerCompute(bool doUpdate, int num_steps, float waves_time); //!< `waves_time` = wave clock of this substep, see `IWater`
     void              CalcAnimators(const int flag_state, float &cstate, int &div, float timer, const float lower_limit, const float upper_limit, const float option3); 
     void              CalcBeams(bool trigger_hooks);       
     void              CalcBeamsInterActor();               
-    void              CalcBuoyance(bool doUpdate);         
+    void              CalcBuoyance(bool doUpdate, float waves_time);
     void              CalcCommands(bool doUpdate);         
     void              CalcCabCollisions();                 
     void              CalcDifferentials();                 
@@ -391,7 +392,7 @@ private:
     void              CalcHooks();                         
     void              CalcHydros();                        
     void              CalcMouse();                         
-    void              CalcNodes();                         
+    void              CalcNodes(float waves_time);
     void              CalcReplay();                        
     void              CalcRopes();                         
     void              CalcShocks(bool doUpdate, int num_steps); 
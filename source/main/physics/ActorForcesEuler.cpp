@@ -41,13 +41,13 @@
 using namespace Ogre;
 using namespace RoR;
 
-void Actor::CalcForcesEulerCompute(bool doUpdate, int num_steps)
+void Actor::CalcForcesEulerCompute(bool doUpdate, int num_steps, float waves_time)
 {
-    this->CalcNodes(); // must be done directly after the inter truck collisions are handled
+    this->CalcNodes(waves_time); // must be done directly after the inter truck collisions are handled
     this->CalcReplay();
-    this->CalcAircraftForces(doUpdate);
+    this->CalcAircraftForces(doUpdate, waves_time);
     this->CalcFuseDrag();
-    this->CalcBuoyance(doUpdate);
+    this->CalcBuoyance(doUpdate, waves_time);
     this->CalcDifferentials();
     this->CalcWheels(doUpdate, num_steps);
     this->CalcShocks(doUpdate, num_steps);
@@ -96,7 +96,7 @@ void Actor::CalcMouse()
     }
 }
 
-void Actor::CalcAircraftForces(bool doUpdate)
+void Actor::CalcAircraftForces(bool doUpdate, float waves_time)
 {
     //airbrake forces
     for (Airbrake* ab: ar_airbrakes)
@@ -110,7 +110,7 @@ void Actor::CalcAircraftForces(bool doUpdate)
     //screwprop forces
     for (int i = 0; i < ar_num_screwprops; i++)
         if (ar_screwprops[i])
-            ar_screwprops[i]->updateForces(doUpdate);
+            ar_screwprops[i]->updateForces(doUpdate, waves_time);
 
     //wing forces
     for (int i = 0; i < ar_num_wings; i++)
@@ -144,15 +144,11 @@ void Actor::CalcFuseDrag()
     }
 }
 
-void Actor::CalcBuoyance(bool doUpdate)
+void Actor::CalcBuoyance(bool doUpdate, float waves_time)
 {
     if (ar_num_buoycabs && App::GetSimTerrain()->getWater())
     {
-        for (int i = 0; i < ar_num_buoycabs; i++)
-        {
-            int tmpv = ar_buoycabs[i] * 3;
-            m_buoyance->computeNodeForce(&ar_nodes[ar_cabs[tmpv]], &ar_nodes[ar_cabs[tmpv + 1]], &ar_nodes[ar_cabs[tmpv + 2]], doUpdate == 1, ar_buoycab_types[i]);
-        }
+        m_buoyance->computeCabForces(ar_nodes, ar_cabs, ar_buoycabs, ar_buoycab_types, ar_num_buoycabs, ar_bounding_box, doUpdate, waves_time);
     }
 }
 
@@ -1511,7 +1507,7 @@ void Actor::CalcBeamsInterActor()
     }
 }
 
-void Actor::CalcNodes()
+void Actor::CalcNodes(float waves_time)
 {
     const auto water = App::GetSimTerrain()->getWater();
     const float gravity = App::GetSimTerrain()->getGravity();
@@ -1588,7 +1584,7 @@ void Actor::CalcNodes()
 
         if (water)
         {
-            const bool is_under_water = water->IsUnderWater(ar_nodes[i].AbsPosition);
+            const bool is_under_water = water->IsUnderWater(ar_nodes[i].AbsPosition, waves_time);
             if (is_under_water)
             {
                 m_water_contact = true;
@@ -35,15 +35,18 @@
 #include "DynamicCollisions.h"
 #include "EngineSim.h"
 #include "GameContext.h"
+#include "GfxActor.h"
 #include "GfxScene.h"
 #include "GUIManager.h"
 #include "Console.h"
 #include "GUI_TopMenubar.h"
 #include "InputEngine.h"
+#include "IWater.h"
 #include "Language.h"
 #include "MovableText.h"
 #include "Network.h"
 #include "PointColDetector.h"
+#include "Profiler.h"
 #include "Replay.h"
 #include "RigDef_Validator.h"
 #include "ActorSpawner.h"
@@ -263,12 +266,14 @@ void ActorManager::SetupActor(Actor* actor, ActorSpawnRequest rq, std::shared_pt
     {
         actor->GetGfxActor()->UpdateSimDataBuffer(); // Initial fill of sim data buffers
 
-        actor->GetGfxActor()->UpdateFlexbodies(); // Push tasks to threadpool
-        actor->GetGfxActor()->UpdateWheelVisuals(); // Push tasks to threadpool
+        actor->GetGfxActor()->UpdateFlexbodies(); // Queue jobs
+        actor->GetGfxActor()->UpdateWheelVisuals(); // Queue jobs
+        App::GetGfxScene()->StartDeformationJobs(); // Push tasks to threadpool
         actor->GetGfxActor()->UpdateCabMesh();
         actor->GetGfxActor()->UpdateWingMeshes();
         actor->GetGfxActor()->UpdateProps(0.f, false);
-        actor->GetGfxActor()->FinishWheelUpdates(); // Sync tasks from threadpool
+        App::GetGfxScene()->FinishDeformationJobs(); // Sync tasks from threadpool
+        actor->GetGfxActor()->FinishWheelUpdates();
         actor->GetGfxActor()->FinishFlexbodyTasks(); // Sync tasks from threadpool
     }
 
@@ -993,12 +998,17 @@ void ActorManager::UpdateActors(Actor* player_actor)
     m_dt_remainder = dt - (m_physics_steps * PHYSICS_DT);
     dt = PHYSICS_DT * m_physics_steps;
 
-    this->SyncWithSimThread();
+    ROR_PROFILE_ZONE("ActorManager::UpdateActors");
+    {
+        ROR_PROFILE_ZONE("Wait for physics");
+        this->SyncWithSimThread();
+    }
 
     this->UpdateSleepingState(player_actor, dt);
 
     for (auto actor : m_actors)
     {
+        ROR_PROFILE_ZONE_ID("Actor update", actor->ar_instance_id);
         actor->HandleInputEvents(dt);
         actor->HandleAngelScriptEvents(dt);
 
@@ -1062,6 +1072,7 @@ void ActorManager::UpdateActors(Actor* player_actor)
         }
     }
 
+    m_sim_task_waves_time = IWater::GetWavesClock();
     auto func = std::function<void()>([this]()
         {
             this->UpdatePhysicsSimulation();
@@ -1088,26 +1099,32 @@ Actor* ActorManager::GetActorById(int actor_id)
 
 void ActorManager::UpdatePhysicsSimulation()
 {
+    ROR_PROFILE_ZONE("Physics");
     for (auto actor : m_actors)
     {
         actor->UpdatePhysicsOrigin();
     }
     for (int i = 0; i < m_physics_steps; i++)
     {
+        ROR_PROFILE_ZONE("Physics step");
+        const float waves_time = m_sim_task_waves_time + i * PHYSICS_DT;
         {
+            ROR_PROFILE_ZONE("Forces");
             std::vector<std::function<void()>> tasks;
             for (auto actor : m_actors)
             {
                 if (actor->ar_update_physics = actor->CalcForcesEulerPrepare(i == 0))
                 {
-                    auto func = std::function<void()>([this, i, actor]()
+                    auto func = std::function<void()>([this, i, actor, waves_time]()
                         {
-                            actor->CalcForcesEulerCompute(i == 0, m_physics_steps);
+                            ROR_PROFILE_ZONE_ID("Actor forces", actor->ar_instance_id);
+                            actor->CalcForcesEulerCompute(i == 0, m_physics_steps, waves_time);
                         });
                     tasks.push_back(func);
                 }
             }
             App::GetThreadPool()->Parallelize(tasks);
+            ROR_PROFILE_ZONE("Inter-actor beams");
             for (auto actor : m_actors)
             {
                 if (actor->ar_update_physics)
@@ -1117,6 +1134,7 @@ void ActorManager::UpdatePhysicsSimulation()
             }
         }
         {
+            ROR_PROFILE_ZONE("Inter-actor collisions");
             std::vector<std::function<void()>> tasks;
             for (auto actor : m_actors)
             {
@@ -1125,6 +1143,7 @@ void ActorManager::UpdatePhysicsSimulation()
                 {
                     auto func = std::function<void()>([this, actor]()
                         {
+                            ROR_PROFILE_ZONE_ID("Actor collisions", actor->ar_instance_id);
                             actor->m_inter_point_col_detector->UpdateInterPoint();
                             if (actor->ar_collision_relevant)
                             {
@@ -1161,6 +1180,25 @@ void ActorManager::UpdatePhysicsSimulation()
             actor->ar_top_speed = std::max(actor->ar_top_speed, actor->ar_nodes[0].Velocity.length());
         }
     }
+    {
+        // Snapshot sim data (nodes and all other `SimBuffer` fields) for gfx while we're still on the worker thread;
+        // the main thread then only flips buffers in `GfxActor::UpdateSimDataBuffer()`
+        ROR_PROFILE_ZONE("Sim snapshots");
+        std::vector<std::function<void()>> tasks;
+        for (auto actor : m_actors)
+        {
+            if (actor->ar_sim_state < Actor::SimState::LOCAL_SLEEPING)
+            {
+                auto func = std::function<void()>([actor]()
+                    {
+                        ROR_PROFILE_ZONE_ID("Actor snapshot", actor->ar_instance_id);
+                        actor->GetGfxActor()->UpdateSimSnapshot();
+                    });
+                tasks.push_back(func);
+            }
+        }
+        App::GetThreadPool()->Parallelize(tasks);
+    }
 }
 
 void ActorManager::SyncWithSimThread()
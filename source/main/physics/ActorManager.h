@@ -130,6 +130,7 @@ private:
     float               m_simulation_time        = 0.f;   //!< Amount of time the physics simulation is going to be advanced
     bool                m_simulation_paused      = false;
     float               m_total_sim_time         = 0.f;
+    float               m_sim_task_waves_time    = 0.f;   //!< Wave clock when the running physics task was started; substeps advance it by PHYSICS_DT
 
     // Utils
     std::unique_ptr<ThreadPool> m_sim_thread_pool;
@@ -23,23 +23,26 @@
 #include "Application.h"
 
 #include <Ogre.h>
+#include <map>
+#include <mutex>
 
 using namespace Ogre;
 using namespace RoR;
 
+static std::mutex                                           g_airfoil_tables_mutex;
+static std::map<std::string, std::weak_ptr<AirfoilTable>>   g_airfoil_tables;
+
 Airfoil::Airfoil(Ogre::String const& fname)
 {
-    for (int i = 0; i < 3601; i++) //init in case of bad things
-    {
-        cl[i] = 0;
-        cd[i] = 0;
-        cm[i] = 0;
-    }
-    char line[1024];
-    //we load directly X-Plane AFL file format!!!
-    bool process = false;
-    bool neg = true;
-    int lastia = -1;
+    m_table = Airfoil::FetchTable(fname);
+}
+
+Airfoil::~Airfoil()
+{
+}
+
+std::shared_ptr<const AirfoilTable> Airfoil::FetchTable(Ogre::String const& fname)
+{
     ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
 
     String group = "";
@@ -53,16 +56,48 @@ Airfoil::Airfoil(Ogre::String const& fname)
     if (group == "")
     {
         LOG(String("Airfoil error: could not load airfoil ")+fname);
-        return;
+        return std::make_shared<AirfoilTable>(); // All zero
+    }
+
+    // Profiles are keyed per group - mods may ship different files under one name.
+    const std::string key = group + "/" + fname;
+
+    std::lock_guard<std::mutex> lock(g_airfoil_tables_mutex);
+    std::shared_ptr<AirfoilTable> table = g_airfoil_tables[key].lock();
+    if (!table)
+    {
+        table = Airfoil::LoadTable(fname, group);
+        g_airfoil_tables[key] = table;
+
+        // Drop entries of tables which were released meanwhile.
+        for (auto itor = g_airfoil_tables.begin(); itor != g_airfoil_tables.end(); )
+        {
+            if (itor->second.expired())
+                itor = g_airfoil_tables.erase(itor);
+            else
+                ++itor;
+        }
     }
+    return table;
+}
+
+std::shared_ptr<AirfoilTable> Airfoil::LoadTable(Ogre::String const& fname, Ogre::String const& group)
+{
+    std::shared_ptr<AirfoilTable> table = std::make_shared<AirfoilTable>(); // Value-initialized = all zero, in case of bad things
+    AirfoilTable::Entry* entries = table->entries;
 
-    DataStreamPtr ds = rgm.openResource(fname, group);
+    char line[1024];
+    //we load directly X-Plane AFL file format!!!
+    bool process = false;
+    bool neg = true;
+    int lastia = -1;
+
+    DataStreamPtr ds = ResourceGroupManager::getSingleton().openResource(fname, group);
     while (!ds->eof())
     {
         size_t ll = ds->readLine(line, 1023);
         if (ll == 0)
             continue;
-        //		fscanf(fd," %[^\n\r]",line);
         if (!strncmp("alpha", line, 5))
         {
             process = true;
@@ -78,28 +113,30 @@ Airfoil::Airfoil(Ogre::String const& fname)
             if (a == 0 && b == 0)
                 neg = false;
             int ia = (a * 10 + b) + 1800;
+            if (ia < 0 || ia >= AirfoilTable::NUM_ENTRIES)
+                continue;
             if (ia == 3600) { process = false; };
-            cl[ia] = l;
-            cd[ia] = d;
-            cm[ia] = m;
+            entries[ia].cl = l;
+            entries[ia].cd = d;
+            entries[ia].cm = m;
             if (lastia != -1 && ia - lastia > 1)
             {
                 //we have to interpolate previous elements (linear interpolation)
-                int i;
-                for (i = 0; i < ia - lastia - 1; i++)
+                AirfoilTable::Entry const& e0 = entries[lastia];
+                AirfoilTable::Entry const& e1 = entries[ia];
+                for (int i = 0; i < ia - lastia - 1; i++)
                 {
-                    cl[lastia + 1 + i] = cl[lastia] + (float)(i + 1) * (cl[ia] - cl[lastia]) / (float)(ia - lastia);
-                    cd[lastia + 1 + i] = cd[lastia] + (float)(i + 1) * (cd[ia] - cd[lastia]) / (float)(ia - lastia);
-                    cm[lastia + 1 + i] = cm[lastia] + (float)(i + 1) * (cm[ia] - cm[lastia]) / (float)(ia - lastia);
+                    entries[lastia + 1 + i].cl = e0.cl + (float)(i + 1) * (e1.cl - e0.cl) / (float)(ia - lastia);
+                    entries[lastia + 1 + i].cd = e0.cd + (float)(i + 1) * (e1.cd - e0.cd) / (float)(ia - lastia);
+                    entries[lastia + 1 + i].cm = e0.cm + (float)(i + 1) * (e1.cm - e0.cm) / (float)(ia - lastia);
                 }
             }
             lastia = ia;
         }
     }
-}
 
-Airfoil::~Airfoil()
-{
+    entries[AirfoilTable::NUM_ENTRIES] = entries[AirfoilTable::NUM_ENTRIES - 1];
+    return table;
 }
 
 void Airfoil::getparams(float a, float cratio, float cdef, float* ocl, float* ocd, float* ocm)
@@ -122,7 +159,8 @@ void Airfoil::getparams(float a, float cratio, float cdef, float* ocl, float* oc
     float sign = 1.0;
     if (cdef < 0)
         sign = -1.0;
-    *ocl = cl[ia] - 0.66 * sign * (1.0 - cratio) * sqrt(fabs(cdef));
-    *ocd = cd[dia] + 0.00015 * (1.0 - cratio) * cdef * cdef;
-    *ocm = cm[ia] + 0.20 * sign * (1.0 - cratio) * sqrt(fabs(cdef));
+    AirfoilTable::Entry const* entries = m_table->entries;
+    *ocl = entries[ia].cl - 0.66 * sign * (1.0 - cratio) * sqrt(fabs(cdef));
+    *ocd = entries[dia].cd + 0.00015 * (1.0 - cratio) * cdef * cdef;
+    *ocm = entries[ia].cm + 0.20 * sign * (1.0 - cratio) * sqrt(fabs(cdef));
 }
@@ -22,25 +22,44 @@
 
 #include "Application.h"
 
+#include <memory>
+
 namespace RoR {
 
+/// Lift/drag/moment coefficients of one airfoil profile, sampled every 0.1 degree from -180 to 180.
+/// Immutable once loaded; shared by all `Airfoil` instances using the same file.
+struct AirfoilTable
+{
+    static const int NUM_ENTRIES = 3601;
+
+    struct Entry
+    {
+        float cl, cd, cm; //!< Interleaved, so one lookup touches one cache line.
+    };
+
+    Entry entries[NUM_ENTRIES + 1]; //!< One extra entry (copy of the last) so `[i + 1]` is always valid for interpolation.
+};
+
 /// Represents an airfoil http://en.wikipedia.org/wiki/Airfoil
 class Airfoil : public ZeroedMemoryAllocator
 {
 public:
 
-    /// Parses the airfoil from file.
+    /// Looks up the airfoil table, parsing the file only if no other instance uses it.
     /// @param fname File name (X-Plane's .AFL file format)
     Airfoil(Ogre::String const& fname);
     ~Airfoil();
 
     void getparams(float a, float cratio, float cdef, float* ocl, float* ocd, float* ocm);
 
+    /// Process-wide cache, keyed by resource group and file name. Tables are released with their last `Airfoil`.
+    static std::shared_ptr<const AirfoilTable> FetchTable(Ogre::String const& fname);
+
 private:
 
-    float cl[3601];
-    float cd[3601];
-    float cm[3601];
+    static std::shared_ptr<AirfoilTable> LoadTable(Ogre::String const& fname, Ogre::String const& group);
+
+    std::shared_ptr<const AirfoilTable> m_table;
 };
 
 } // namespace RoR
@@ -35,6 +35,9 @@
 #include "ScriptEngine.h"
 #include "TerrainManager.h"
 
+#include <cstdio>
+#include <cstring>
+
 using namespace RoR;
 
 // some gcc fixes
@@ -115,6 +118,21 @@ unsigned int sbox[] =
 using namespace Ogre;
 using namespace RoR;
 
+const char* Collisions::BAKED_CACHE_SIGNATURE = "RoRColl";
+
+// FNV-1a, for detecting damaged baked collision cache files
+static const uint32_t CACHE_CHECKSUM_SEED = 2166136261u;
+
+static uint32_t CacheChecksum(uint32_t hash, const void* data, size_t len)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < len; i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
 Collisions::Collisions(Ogre::Vector3 terrn_size):
       debugMode(false)
     , debugmo(nullptr)
@@ -144,6 +162,10 @@ Collisions::Collisions(Ogre::Vector3 terrn_size):
 
 Collisions::~Collisions()
 {
+    if (!m_baked_cache_path.empty())
+    {
+        this->saveCollisionCache(); // Object paging keeps the cache until the terrain is unloaded
+    }
     if (landuse) delete landuse;
 }
 
@@ -343,23 +365,50 @@ void Collisions::setupLandUse(const char *configfile)
 
 void Collisions::removeCollisionBox(int number)
 {
-    if (number > -1 && number < m_collision_boxes.size())
+    if (number > -1 && number < m_collision_boxes.size() && m_collision_boxes[number].enabled)
     {
         m_collision_boxes[number].enabled = false;
         if (m_collision_boxes[number].eventsourcenum >= 0 && m_collision_boxes[number].eventsourcenum < free_eventsource)
         {
             eventsources[m_collision_boxes[number].eventsourcenum].enabled = false;
         }
-        // Is it worth to update the hashmap? ~ ulteq 01/19
+
+        // Unregister from the index - terrain object paging removes boxes routinely.
+        int cell_lo_x, cell_lo_z, cell_hi_x, cell_hi_z;
+        this->getCellRange(AxisAlignedBox(m_collision_boxes[number].lo, m_collision_boxes[number].hi), cell_lo_x, cell_lo_z, cell_hi_x, cell_hi_z);
+        for (int i = cell_lo_x; i <= cell_hi_x; i++)
+        {
+            for (int j = cell_lo_z; j <= cell_hi_z; j++)
+            {
+                hash_remove(i, j, number);
+            }
+        }
+
+        // Recycle the slot; event boxes keep theirs, event sources refer to them by index.
+        if (m_collision_boxes[number].eventsourcenum < 0)
+        {
+            m_free_collision_boxes.push_back(number);
+        }
     }
 }
 
 void Collisions::removeCollisionTri(int number)
 {
-    if (number > -1 && number < m_collision_tris.size())
+    if (number > -1 && number < m_collision_tris.size() && m_collision_tris[number].enabled)
     {
         m_collision_tris[number].enabled = false;
-        // Is it worth to update the hashmap? ~ ulteq 01/19
+
+        // Unregister from the index and recycle the slot - terrain object paging removes tris routinely.
+        int cell_lo_x, cell_lo_z, cell_hi_x, cell_hi_z;
+        this->getCellRange(m_collision_tris[number].aab, cell_lo_x, cell_lo_z, cell_hi_x, cell_hi_z);
+        for (int i = cell_lo_x; i <= cell_hi_x; i++)
+        {
+            for (int j = cell_lo_z; j <= cell_hi_z; j++)
+            {
+                hash_remove(i, j, number + hash_coll_element_t::ELEMENT_TRI_BASE_INDEX);
+            }
+        }
+        m_free_collision_tris.push_back(number);
     }
 }
 
@@ -391,6 +440,24 @@ void Collisions::hash_add(int cell_x, int cell_z, int value, float h)
     hashtable_height[pos] = std::max(hashtable_height[pos], h);
 }
 
+void Collisions::hash_remove(int cell_x, int cell_z, int value)
+{
+    unsigned int cell_id = (cell_x << 16) + cell_z;
+    unsigned int pos    = hashfunc(cell_id);
+
+    // Order of elements doesn't matter - swap with last and pop.
+    std::vector<hash_coll_element_t>& elements = hashtable[pos];
+    for (size_t k = 0; k < elements.size(); k++)
+    {
+        if (elements[k].cell_id == cell_id && elements[k].element_index == value)
+        {
+            elements[k] = elements.back();
+            elements.pop_back();
+            return;
+        }
+    }
+}
+
 int Collisions::hash_find(int cell_x, int cell_z)
 {
     unsigned int cellid = (cell_x << 16) + cell_z;
@@ -401,10 +468,15 @@ int Collisions::hash_find(int cell_x, int cell_z)
 
 int Collisions::addCollisionBox(SceneNode *tenode, bool rotating, bool virt, Vector3 pos, Ogre::Vector3 rot, Ogre::Vector3 l, Ogre::Vector3 h, Ogre::Vector3 sr, const Ogre::String &eventname, const Ogre::String &instancename, bool forcecam, Ogre::Vector3 campos, Ogre::Vector3 sc /* = Vector3::UNIT_SCALE */, Ogre::Vector3 dr /* = Vector3::ZERO */, CollisionEventFilter event_filter /* = EVENT_ALL */, int scripthandler /* = -1 */)
 {
-    Quaternion rotation  = Quaternion(Degree(rot.x), Vector3::UNIT_X) * Quaternion(Degree(rot.y), Vector3::UNIT_Y) * Quaternion(Degree(rot.z), Vector3::UNIT_Z);
-    Quaternion direction = Quaternion(Degree(dr.x), Vector3::UNIT_X) * Quaternion(Degree(dr.y), Vector3::UNIT_Y) * Quaternion(Degree(dr.z), Vector3::UNIT_Z);
-    int coll_box_index = this->GetNumCollisionBoxes();
     collision_box_t coll_box;
+    Collisions::buildCollisionBox(rotating, virt, pos, rot, l, h, sr, forcecam, campos, sc, event_filter, coll_box);
+    Quaternion direction = Quaternion(Degree(dr.x), Vector3::UNIT_X) * Quaternion(Degree(dr.y), Vector3::UNIT_Y) * Quaternion(Degree(dr.z), Vector3::UNIT_Z);
+    return this->registerCollisionBox(coll_box, direction, tenode, eventname, instancename, scripthandler);
+}
+
+void Collisions::buildCollisionBox(bool rotating, bool virt, Vector3 pos, Ogre::Vector3 rot, Ogre::Vector3 l, Ogre::Vector3 h, Ogre::Vector3 sr, bool forcecam, Ogre::Vector3 campos, Ogre::Vector3 sc, CollisionEventFilter event_filter, collision_box_t& coll_box)
+{
+    Quaternion rotation  = Quaternion(Degree(rot.x), Vector3::UNIT_X) * Quaternion(Degree(rot.y), Vector3::UNIT_Y) * Quaternion(Degree(rot.z), Vector3::UNIT_Z);
 
     coll_box.enabled = true;
     
@@ -443,21 +515,6 @@ int Collisions::addCollisionBox(SceneNode *tenode, bool rotating, bool virt, Vec
 
     coll_box.eventsourcenum = -1;
 
-    if (!eventname.empty())
-    {
-        //LOG("COLL: adding "+TOSTRING(free_eventsource)+" "+String(instancename)+" "+String(eventname));
-        // this is event-generating
-        strcpy(eventsources[free_eventsource].boxname, eventname.c_str());
-        strcpy(eventsources[free_eventsource].instancename, instancename.c_str());
-        eventsources[free_eventsource].scripthandler = scripthandler;
-        eventsources[free_eventsource].cbox = coll_box_index;
-        eventsources[free_eventsource].snode = tenode;
-        eventsources[free_eventsource].direction = direction;
-        eventsources[free_eventsource].enabled = true;
-        coll_box.eventsourcenum = free_eventsource;
-        free_eventsource++;
-    }
-
     // next, global rotate
     if (fabs(rot.x) < 0.0001f && fabs(rot.y) < 0.0001f && fabs(rot.z) < 0.0001f)
     {
@@ -472,69 +529,99 @@ int Collisions::addCollisionBox(SceneNode *tenode, bool rotating, bool virt, Vec
         coll_box.unrot = rotation.Inverse();
     }
 
-    SceneNode *debugsn = 0;
-    
-    if (debugMode)
-    {
-        debugsn = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
-    }
-
     // set raw box
-    // 8 points of a cube
-    Vector3 cube_points[8];
     if (coll_box.selfrotated || coll_box.refined)
     {
-        cube_points[0] = Ogre::Vector3(l.x, l.y, l.z) * sc;
-        cube_points[1] = Ogre::Vector3(h.x, l.y, l.z) * sc;
-        cube_points[2] = Ogre::Vector3(l.x, h.y, l.z) * sc;
-        cube_points[3] = Ogre::Vector3(h.x, h.y, l.z) * sc;
-        cube_points[4] = Ogre::Vector3(l.x, l.y, h.z) * sc;
-        cube_points[5] = Ogre::Vector3(h.x, l.y, h.z) * sc;
-        cube_points[6] = Ogre::Vector3(l.x, h.y, h.z) * sc;
-        cube_points[7] = Ogre::Vector3(h.x, h.y, h.z) * sc;
-        
-        // rotate box
-        if (coll_box.selfrotated)
-            for (int i=0; i < 8; i++)
-            {
-                cube_points[i]=cube_points[i]-coll_box.selfcenter;
-                cube_points[i]=coll_box.selfrot*cube_points[i];
-                cube_points[i]=cube_points[i]+coll_box.selfcenter;
-            }
-            if (coll_box.refined)
-            {
-                for (int i=0; i < 8; i++)
-                {
-                    cube_points[i] = coll_box.rot * cube_points[i];
-                }
-            }
-            // find min/max
-            coll_box.lo = cube_points[0];
-            coll_box.hi = cube_points[0];
-            for (int i=1; i < 8; i++)
-            {
-                coll_box.lo.makeFloor(cube_points[i]);
-                coll_box.hi.makeCeil(cube_points[i]);
-            }
-            // set absolute coords
-            coll_box.lo += pos;
-            coll_box.hi += pos;
+        Vector3 cube_points[8];
+        Collisions::getCollisionBoxCorners(coll_box, cube_points);
+        // find min/max
+        coll_box.lo = cube_points[0];
+        coll_box.hi = cube_points[0];
+        for (int i=1; i < 8; i++)
+        {
+            coll_box.lo.makeFloor(cube_points[i]);
+            coll_box.hi.makeCeil(cube_points[i]);
+        }
+        // set absolute coords
+        coll_box.lo += pos;
+        coll_box.hi += pos;
     } else
     {
         // unrefined box
         coll_box.lo = pos + coll_box.relo;
         coll_box.hi = pos + coll_box.rehi;
-        Vector3 d = (coll_box.rehi - coll_box.relo);
-        cube_points[0] = coll_box.relo;
-        cube_points[1] = coll_box.relo;	cube_points[1].x += d.x;
-        cube_points[2] = coll_box.relo;                          cube_points[2].y += d.y;
-        cube_points[3] = coll_box.relo; cube_points[3].x += d.x; cube_points[3].y += d.y;
-        cube_points[4] = coll_box.relo;                                                   cube_points[4].z += d.z;
-        cube_points[5] = coll_box.relo; cube_points[5].x += d.x;                          cube_points[5].z += d.z;
-        cube_points[6] = coll_box.relo; cube_points[6].y += d.y;                          cube_points[6].z += d.z;
-        cube_points[7] = coll_box.relo; cube_points[7].x += d.x; cube_points[7].y += d.y; cube_points[7].z += d.z;
+    }
+}
+
+void Collisions::getCollisionBoxCorners(collision_box_t const& coll_box, Ogre::Vector3* cube_points)
+{
+    // 8 points of a cube, relative to the box center
+    Vector3 l = coll_box.relo;
+    Vector3 h = coll_box.rehi;
+    cube_points[0] = Ogre::Vector3(l.x, l.y, l.z);
+    cube_points[1] = Ogre::Vector3(h.x, l.y, l.z);
+    cube_points[2] = Ogre::Vector3(l.x, h.y, l.z);
+    cube_points[3] = Ogre::Vector3(h.x, h.y, l.z);
+    cube_points[4] = Ogre::Vector3(l.x, l.y, h.z);
+    cube_points[5] = Ogre::Vector3(h.x, l.y, h.z);
+    cube_points[6] = Ogre::Vector3(l.x, h.y, h.z);
+    cube_points[7] = Ogre::Vector3(h.x, h.y, h.z);
+
+    // rotate box
+    if (coll_box.selfrotated)
+    {
+        for (int i=0; i < 8; i++)
+        {
+            cube_points[i]=cube_points[i]-coll_box.selfcenter;
+            cube_points[i]=coll_box.selfrot*cube_points[i];
+            cube_points[i]=cube_points[i]+coll_box.selfcenter;
+        }
+    }
+    if (coll_box.refined)
+    {
+        for (int i=0; i < 8; i++)
+        {
+            cube_points[i] = coll_box.rot * cube_points[i];
+        }
+    }
+}
+
+int Collisions::registerCollisionBox(collision_box_t coll_box, Ogre::Quaternion direction, Ogre::SceneNode* tenode, const Ogre::String& eventname, const Ogre::String& instancename, int scripthandler)
+{
+    int coll_box_index = this->GetNumCollisionBoxes();
+    if (eventname.empty() && !m_free_collision_boxes.empty())
+    {
+        coll_box_index = m_free_collision_boxes.back();
+        m_free_collision_boxes.pop_back();
+    }
+
+    if (!eventname.empty())
+    {
+        //LOG("COLL: adding "+TOSTRING(free_eventsource)+" "+String(instancename)+" "+String(eventname));
+        // this is event-generating
+        strcpy(eventsources[free_eventsource].boxname, eventname.c_str());
+        strcpy(eventsources[free_eventsource].instancename, instancename.c_str());
+        eventsources[free_eventsource].scripthandler = scripthandler;
+        eventsources[free_eventsource].cbox = coll_box_index;
+        eventsources[free_eventsource].snode = tenode;
+        eventsources[free_eventsource].direction = direction;
+        eventsources[free_eventsource].enabled = true;
+        coll_box.eventsourcenum = free_eventsource;
+        free_eventsource++;
     }
 
+    SceneNode *debugsn = 0;
+    
+    if (debugMode)
+    {
+        debugsn = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
+    }
+
+    const Vector3 pos = coll_box.center;
+    const bool virt = coll_box.virt;
+    Vector3 cube_points[8];
+    Collisions::getCollisionBoxCorners(coll_box, cube_points);
+
     if (debugsn)
     {
         debugsn->setPosition(pos);
@@ -651,14 +738,37 @@ int Collisions::addCollisionBox(SceneNode *tenode, bool rotating, bool virt, Vec
     }
 
     m_collision_aab.merge(AxisAlignedBox(coll_box.lo, coll_box.hi));
-    m_collision_boxes.push_back(coll_box);
+    if (coll_box_index == this->GetNumCollisionBoxes())
+        m_collision_boxes.push_back(coll_box);
+    else
+        m_collision_boxes[coll_box_index] = coll_box;
     return coll_box_index;
 }
 
 int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model_t* gm)
 {
-    int new_tri_index = this->GetNumCollisionTris();
     collision_tri_t new_tri;
+    Collisions::buildCollisionTri(p1, p2, p3, gm, new_tri);
+
+    // register this collision tri in the index
+    int cell_lo_x, cell_lo_z, cell_hi_x, cell_hi_z;
+    this->getCellRange(new_tri.aab, cell_lo_x, cell_lo_z, cell_hi_x, cell_hi_z);
+    return this->registerCollisionTri(new_tri, cell_lo_x, cell_lo_z, cell_hi_x, cell_hi_z);
+}
+
+void Collisions::addCollisionTris(std::vector<collision_tri_t> const& tris, std::vector<int>& out_ids)
+{
+    out_ids.reserve(out_ids.size() + tris.size());
+    for (collision_tri_t const& tri : tris)
+    {
+        int cell_lo_x, cell_lo_z, cell_hi_x, cell_hi_z;
+        this->getCellRange(tri.aab, cell_lo_x, cell_lo_z, cell_hi_x, cell_hi_z);
+        out_ids.push_back(this->registerCollisionTri(tri, cell_lo_x, cell_lo_z, cell_hi_x, cell_hi_z));
+    }
+}
+
+void Collisions::buildCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model_t* gm, collision_tri_t& new_tri)
+{
     new_tri.a=p1;
     new_tri.b=p2;
     new_tri.c=p3;
@@ -677,25 +787,43 @@ int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model
     new_tri.forward=new_tri.reverse.Inverse();
 
     // compute tri AAB
+    new_tri.aab.setNull();
     new_tri.aab.merge(p1);
     new_tri.aab.merge(p2);
     new_tri.aab.merge(p3);
     new_tri.aab.setMinimum(new_tri.aab.getMinimum() - 0.1f);
     new_tri.aab.setMaximum(new_tri.aab.getMaximum() + 0.1f);
-    
-    // register this collision tri in the index
-    Ogre::Vector3 ilo(new_tri.aab.getMinimum() / Ogre::Real(CELL_SIZE));
-    Ogre::Vector3 ihi(new_tri.aab.getMaximum() / Ogre::Real(CELL_SIZE));
-    
+}
+
+void Collisions::getCellRange(AxisAlignedBox const& aab, int& cell_lo_x, int& cell_lo_z, int& cell_hi_x, int& cell_hi_z)
+{
+    Ogre::Vector3 ilo(aab.getMinimum() / Ogre::Real(CELL_SIZE));
+    Ogre::Vector3 ihi(aab.getMaximum() / Ogre::Real(CELL_SIZE));
+
     // clamp between 0 and MAXIMUM_CELL;
     ilo.makeCeil(Ogre::Vector3(0.0f));
     ilo.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
     ihi.makeCeil(Ogre::Vector3(0.0f));
     ihi.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
-    
-    for (int i = ilo.x; i <= ihi.x; i++)
+
+    cell_lo_x = ilo.x;
+    cell_lo_z = ilo.z;
+    cell_hi_x = ihi.x;
+    cell_hi_z = ihi.z;
+}
+
+int Collisions::registerCollisionTri(collision_tri_t const& new_tri, int cell_lo_x, int cell_lo_z, int cell_hi_x, int cell_hi_z)
+{
+    int new_tri_index = this->GetNumCollisionTris();
+    if (!m_free_collision_tris.empty())
     {
-        for (int j = ilo.z; j<=ihi.z; j++)
+        new_tri_index = m_free_collision_tris.back();
+        m_free_collision_tris.pop_back();
+    }
+
+    for (int i = cell_lo_x; i <= cell_hi_x; i++)
+    {
+        for (int j = cell_lo_z; j <= cell_hi_z; j++)
         {
             hash_add(i, j, new_tri_index + hash_coll_element_t::ELEMENT_TRI_BASE_INDEX, new_tri.aab.getMaximum().y);
         }
@@ -703,13 +831,16 @@ int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model
     
     if (debugMode)
     {
-        debugmo->position(p1);
-        debugmo->position(p2);
-        debugmo->position(p3);
+        debugmo->position(new_tri.a);
+        debugmo->position(new_tri.b);
+        debugmo->position(new_tri.c);
     }
 
     m_collision_aab.merge(new_tri.aab);
-    m_collision_tris.push_back(new_tri);
+    if (new_tri_index == this->GetNumCollisionTris())
+        m_collision_tris.push_back(new_tri);
+    else
+        m_collision_tris[new_tri_index] = new_tri;
     return new_tri_index;
 }
 
@@ -1293,6 +1424,10 @@ bool Collisions::isInside(Vector3 pos, collision_box_t *cbox, float border)
 
 bool Collisions::groundCollision(node_t *node, float dt)
 {
+    // Quick reject for nodes well above the terrain, i.e. aircraft
+    if (node->AbsPosition.y > App::GetSimTerrain()->GetMaxHeightAt(node->AbsPosition.x, node->AbsPosition.z))
+        return false;
+
     Real v = App::GetSimTerrain()->GetHeightAt(node->AbsPosition.x, node->AbsPosition.z);
     if (v > node->AbsPosition.y)
     {
@@ -1518,15 +1653,55 @@ int Collisions::createCollisionDebugVisualization()
 
 int Collisions::addCollisionMesh(Ogre::String meshname, Ogre::Vector3 pos, Ogre::Quaternion q, Ogre::Vector3 scale, ground_model_t *gm, std::vector<int> *collTris)
 {
-    // normal, non virtual collision box
-    Entity *ent = App::GetGfxScene()->GetSceneManager()->createEntity(meshname);
-    ent->setMaterialName("tracks/debug/collision/mesh");
-
     if (!gm)
     {
         gm = getGroundModelByString("concrete");
     }
 
+    // Look up the baked triangles - the key is the mesh name followed by the mesh file fingerprint and the raw placement.
+    std::string bake_key;
+    if (!m_baked_cache_path.empty() && !this->getMeshFingerprint(meshname).empty())
+    {
+        const float placement[] = { pos.x, pos.y, pos.z, q.w, q.x, q.y, q.z, scale.x, scale.y, scale.z };
+        bake_key = meshname;
+        bake_key.push_back('\0');
+        bake_key.append(this->getMeshFingerprint(meshname));
+        bake_key.append(reinterpret_cast<const char*>(placement), sizeof(placement));
+
+        auto found = m_baked_meshes.find(bake_key);
+        if (found != m_baked_meshes.end())
+        {
+            found->second.used = true;
+            for (uint32_t i = found->second.first_tri; i < found->second.first_tri + found->second.num_tris; i++)
+            {
+                baked_tri_t const& baked = m_baked_tris[i];
+                collision_tri_t tri;
+                tri.a = Vector3(baked.a);
+                tri.b = Vector3(baked.b);
+                tri.c = Vector3(baked.c);
+                tri.aab = AxisAlignedBox(Vector3(baked.aab_min), Vector3(baked.aab_max));
+                for (int row = 0; row < 3; row++)
+                {
+                    for (int col = 0; col < 3; col++)
+                    {
+                        tri.forward[row][col] = baked.forward[row * 3 + col];
+                        tri.reverse[row][col] = baked.reverse[row * 3 + col];
+                    }
+                }
+                tri.gm = gm;
+                tri.enabled = true;
+                int triID = this->registerCollisionTri(tri, baked.cell_lo_x, baked.cell_lo_z, baked.cell_hi_x, baked.cell_hi_z);
+                if (collTris)
+                    collTris->push_back(triID);
+            }
+            return 0;
+        }
+    }
+
+    // normal, non virtual collision box
+    Entity *ent = App::GetGfxScene()->GetSceneManager()->createEntity(meshname);
+    ent->setMaterialName("tracks/debug/collision/mesh");
+
     size_t vertex_count,index_count;
     Vector3* vertices;
     unsigned* indices;
@@ -1535,11 +1710,27 @@ int Collisions::addCollisionMesh(Ogre::String meshname, Ogre::Vector3 pos, Ogre:
 
     //LOG(LML_NORMAL,"Vertices in mesh: %u",vertex_count);
     //LOG(LML_NORMAL,"Triangles in mesh: %u",index_count / 3);
+    std::vector<int> tri_ids; // Not necessarily contiguous, slots of removed tris get reused
     for (int i=0; i<(int)index_count/3; i++)
     {
         int triID = addCollisionTri(vertices[indices[i*3]], vertices[indices[i*3+1]], vertices[indices[i*3+2]], gm);
         if (collTris)
             collTris->push_back(triID);
+        tri_ids.push_back(triID);
+    }
+
+    if (!bake_key.empty())
+    {
+        baked_mesh_t& baked_mesh = m_baked_meshes[bake_key];
+        baked_mesh.first_tri = static_cast<uint32_t>(m_baked_tris.size());
+        baked_mesh.num_tris = static_cast<uint32_t>(tri_ids.size());
+        baked_mesh.used = true;
+        m_baked_tris.resize(m_baked_tris.size() + baked_mesh.num_tris);
+        for (uint32_t i = 0; i < baked_mesh.num_tris; i++)
+        {
+            this->bakeCollisionTri(m_collision_tris[tri_ids[i]], m_baked_tris[baked_mesh.first_tri + i]);
+        }
+        m_baked_cache_dirty = true;
     }
 
     delete[] vertices;
@@ -1687,8 +1878,205 @@ void Collisions::getMeshInformation(Mesh* mesh,size_t &vertex_count,Vector3* &ve
     }
 }
 
+void Collisions::loadCollisionCache(std::string const& terrain_hash)
+{
+    if (debugMode)
+        return; // The debug visualization needs the mesh entities
+
+    m_baked_cache_path = PathCombine(App::sys_cache_dir->GetStr(), "collisions_" + terrain_hash + ".bin");
+    m_baked_cache_dirty = true; // Until proven otherwise
+
+    FILE* file = fopen(m_baked_cache_path.c_str(), "rb");
+    if (file == nullptr)
+        return; // Not baked yet
+
+    char signature[8] = {};
+    uint32_t header[4] = {}; // version, num meshes, num tris, checksum of everything after the header
+    bool ok = fread(signature, sizeof(signature), 1, file) == 1
+           && fread(header, sizeof(header), 1, file) == 1
+           && strncmp(signature, BAKED_CACHE_SIGNATURE, sizeof(signature)) == 0
+           && header[0] == BAKED_CACHE_VERSION;
+
+    uint32_t checksum = CACHE_CHECKSUM_SEED;
+    for (uint32_t i = 0; ok && i < header[1]; i++)
+    {
+        uint32_t key_len = 0;
+        baked_mesh_t baked_mesh;
+        ok = fread(&key_len, sizeof(key_len), 1, file) == 1 && key_len < 10000;
+        std::string key(ok ? key_len : 0, '\0');
+        ok = ok && (key_len == 0 || fread(&key[0], key_len, 1, file) == 1)
+                && fread(&baked_mesh.first_tri, sizeof(uint32_t), 1, file) == 1
+                && fread(&baked_mesh.num_tris, sizeof(uint32_t), 1, file) == 1
+                && baked_mesh.first_tri + baked_mesh.num_tris <= header[2];
+        if (ok)
+        {
+            checksum = CacheChecksum(checksum, &key_len, sizeof(key_len));
+            checksum = CacheChecksum(checksum, key.data(), key_len);
+            checksum = CacheChecksum(checksum, &baked_mesh.first_tri, sizeof(uint32_t));
+            checksum = CacheChecksum(checksum, &baked_mesh.num_tris, sizeof(uint32_t));
+            m_baked_meshes[key] = baked_mesh;
+        }
+    }
+
+    if (ok)
+    {
+        m_baked_tris.resize(header[2]);
+        ok = header[2] == 0 || fread(m_baked_tris.data(), sizeof(baked_tri_t), header[2], file) == header[2];
+        checksum = CacheChecksum(checksum, m_baked_tris.data(), m_baked_tris.size() * sizeof(baked_tri_t));
+        ok = ok && checksum == header[3];
+    }
+    fclose(file);
+
+    if (ok)
+    {
+        m_baked_cache_dirty = false;
+        m_collision_tris.reserve(m_collision_tris.size() + m_baked_tris.size());
+        LOG("COLL: Loaded baked collision meshes from " + m_baked_cache_path);
+    }
+    else
+    {
+        m_baked_meshes.clear();
+        m_baked_tris.clear();
+        LOG("COLL: Ignoring invalid baked collision cache " + m_baked_cache_path);
+    }
+}
+
+void Collisions::saveCollisionCache()
+{
+    // Leave out meshes which the terrain no longer uses.
+    // With object paging, unused meshes may just belong to pages which weren't visited.
+    const bool keep_unused = App::sim_object_paging->GetBool();
+    std::vector<std::pair<std::string const*, baked_mesh_t>> used_meshes;
+    uint32_t num_tris = 0;
+    for (auto& entry: m_baked_meshes)
+    {
+        if (!entry.second.used && !keep_unused)
+        {
+            m_baked_cache_dirty = true;
+            continue;
+        }
+        baked_mesh_t saved = entry.second;
+        saved.first_tri = num_tris;
+        num_tris += saved.num_tris;
+        used_meshes.push_back(std::make_pair(&entry.first, saved));
+    }
+
+    if (!m_baked_cache_dirty)
+        return;
+
+    FILE* file = fopen(m_baked_cache_path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        LOG("COLL: Failed to open " + m_baked_cache_path + " for writing");
+        return;
+    }
+
+    // The checksum goes into the header, so it's computed in a separate pass
+    uint32_t checksum = CACHE_CHECKSUM_SEED;
+    for (auto& used: used_meshes)
+    {
+        const uint32_t key_len = static_cast<uint32_t>(used.first->size());
+        checksum = CacheChecksum(checksum, &key_len, sizeof(key_len));
+        checksum = CacheChecksum(checksum, used.first->data(), key_len);
+        checksum = CacheChecksum(checksum, &used.second.first_tri, sizeof(uint32_t));
+        checksum = CacheChecksum(checksum, &used.second.num_tris, sizeof(uint32_t));
+    }
+    for (auto& used: used_meshes)
+    {
+        const baked_mesh_t& source = m_baked_meshes[*used.first];
+        checksum = CacheChecksum(checksum, m_baked_tris.data() + source.first_tri, source.num_tris * sizeof(baked_tri_t));
+    }
+
+    char signature[8] = {};
+    strncpy(signature, BAKED_CACHE_SIGNATURE, sizeof(signature));
+    const uint32_t header[4] = { BAKED_CACHE_VERSION, static_cast<uint32_t>(used_meshes.size()), num_tris, checksum };
+    bool ok = fwrite(signature, sizeof(signature), 1, file) == 1
+           && fwrite(header, sizeof(header), 1, file) == 1;
+
+    for (auto& used: used_meshes)
+    {
+        const uint32_t key_len = static_cast<uint32_t>(used.first->size());
+        ok = ok && fwrite(&key_len, sizeof(key_len), 1, file) == 1
+                && fwrite(used.first->data(), key_len, 1, file) == 1
+                && fwrite(&used.second.first_tri, sizeof(uint32_t), 1, file) == 1
+                && fwrite(&used.second.num_tris, sizeof(uint32_t), 1, file) == 1;
+    }
+    for (auto& used: used_meshes)
+    {
+        const baked_mesh_t& source = m_baked_meshes[*used.first];
+        ok = ok && (source.num_tris == 0
+                    || fwrite(&m_baked_tris[source.first_tri], sizeof(baked_tri_t), source.num_tris, file) == source.num_tris);
+    }
+    fclose(file);
+
+    if (!ok)
+    {
+        LOG("COLL: Failed to write " + m_baked_cache_path);
+        remove(m_baked_cache_path.c_str());
+    }
+}
+
+std::string const& Collisions::getMeshFingerprint(std::string const& meshname)
+{
+    auto found = m_mesh_fingerprints.find(meshname);
+    if (found != m_mesh_fingerprints.end())
+        return found->second;
+
+    // Edited meshes must not hit stale baked triangles. Hashing the contents would mean reading
+    // every mesh file on each load, which is what the cache avoids, so size and time have to do.
+    std::string& fingerprint = m_mesh_fingerprints[meshname];
+    try
+    {
+        ResourceGroupManager& rgm = ResourceGroupManager::getSingleton();
+        const String group = rgm.findGroupContainingResource(meshname);
+        FileInfoListPtr files = rgm.findResourceFileInfo(group, meshname);
+        if (!files->empty())
+        {
+            const uint64_t info[3] = {
+                static_cast<uint64_t>(files->front().uncompressedSize),
+                static_cast<uint64_t>(files->front().compressedSize),
+                static_cast<uint64_t>(rgm.resourceModifiedTime(group, meshname)) };
+            fingerprint.assign(reinterpret_cast<const char*>(info), sizeof(info));
+        }
+    }
+    catch (Ogre::Exception&) // Not found - `addCollisionMesh()` will report it
+    {
+    }
+    return fingerprint;
+}
+
+void Collisions::bakeCollisionTri(collision_tri_t const& tri, baked_tri_t& out)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        out.a[i] = tri.a[i];
+        out.b[i] = tri.b[i];
+        out.c[i] = tri.c[i];
+        out.aab_min[i] = tri.aab.getMinimum()[i];
+        out.aab_max[i] = tri.aab.getMaximum()[i];
+        for (int col = 0; col < 3; col++)
+        {
+            out.forward[i * 3 + col] = tri.forward[i][col];
+            out.reverse[i * 3 + col] = tri.reverse[i][col];
+        }
+    }
+    this->getCellRange(tri.aab, out.cell_lo_x, out.cell_lo_z, out.cell_hi_x, out.cell_hi_z);
+}
+
 void Collisions::finishLoadingTerrain()
 {
+    if (!m_baked_cache_path.empty() && !App::sim_object_paging->GetBool())
+    {
+        this->saveCollisionCache();
+
+        // Objects spawned later by scripts are not cached.
+        m_baked_cache_path.clear();
+        m_baked_meshes.clear();
+        m_baked_tris.clear();
+        m_baked_tris.shrink_to_fit();
+        m_mesh_fingerprints.clear();
+    }
+
     if (debugMode)
     {
         SceneNode *debugsn = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
@@ -25,7 +25,9 @@
 #include "Application.h"
 #include "SimData.h" // for collision_box_t
 
+#include <cstdint>
 #include <mutex>
+#include <unordered_map>
 #include <Ogre.h>
 
 namespace RoR {
@@ -54,6 +56,18 @@ public:
         FX_PARTICLE
     };
 
+    struct collision_tri_t
+    {
+        Ogre::Vector3 a;
+        Ogre::Vector3 b;
+        Ogre::Vector3 c;
+        Ogre::AxisAlignedBox aab;
+        Ogre::Matrix3 forward;
+        Ogre::Matrix3 reverse;
+        ground_model_t* gm;
+        bool enabled;
+    };
+
     Collisions(Ogre::Vector3 terrn_size);
     ~Collisions();
 
@@ -79,18 +93,42 @@ private:
         int element_index;
     };
 
-    struct collision_tri_t
+    /// Baked collision mesh cache
+    /// --------------------------
+    /// Triangles produced by `addCollisionMesh()` are stored transformed, with precomputed matrices and cell range,
+    /// in a per-terrain file in 'sys_cache_dir'. Next time the terrain loads, meshes found in the cache
+    /// are appended to `m_collision_tris` directly, without creating an entity or inverting matrices.
+    struct baked_tri_t
     {
-        Ogre::Vector3 a;
-        Ogre::Vector3 b;
-        Ogre::Vector3 c;
-        Ogre::AxisAlignedBox aab;
-        Ogre::Matrix3 forward;
-        Ogre::Matrix3 reverse;
-        ground_model_t* gm;
-        bool enabled;
+        float a[3], b[3], c[3];
+        float aab_min[3], aab_max[3];
+        float forward[9], reverse[9]; // Row-major
+        int32_t cell_lo_x, cell_lo_z, cell_hi_x, cell_hi_z;
     };
 
+    struct baked_mesh_t
+    {
+        uint32_t first_tri = 0; // Index to `m_baked_tris`
+        uint32_t num_tris = 0;
+        bool used = false;      // Only meshes used by the current load are saved back.
+    };
+
+    static const char*    BAKED_CACHE_SIGNATURE;
+    static const uint32_t BAKED_CACHE_VERSION = 2;
+
+    std::string m_baked_cache_path;  // Empty if the cache is disabled.
+    bool        m_baked_cache_dirty = false;
+    std::vector<baked_tri_t> m_baked_tris;
+    std::unordered_map<std::string, baked_mesh_t> m_baked_meshes; // Key = mesh name + mesh file fingerprint + raw placement, see `addCollisionMesh()`
+    std::unordered_map<std::string, std::string> m_mesh_fingerprints; // Key = mesh name, see `getMeshFingerprint()`
+
+    void saveCollisionCache();
+    std::string const& getMeshFingerprint(std::string const& meshname); //!< Size and modification time of the mesh file; empty if not found.
+    void bakeCollisionTri(collision_tri_t const& tri, baked_tri_t& out);
+    static void getCollisionBoxCorners(collision_box_t const& coll_box, Ogre::Vector3* cube_points); //!< 8 corners, rotated, relative to `collision_box_t::center`
+    void getCellRange(Ogre::AxisAlignedBox const& aab, int& cell_lo_x, int& cell_lo_z, int& cell_hi_x, int& cell_hi_z);
+    int registerCollisionTri(collision_tri_t const& new_tri, int cell_lo_x, int cell_lo_z, int cell_hi_x, int cell_hi_z);
+
     static const int LATEST_GROUND_MODEL_VERSION = 3;
     static const int MAX_EVENT_SOURCE = 500;
 
@@ -111,6 +149,8 @@ private:
 
     // collision tris pool;
     std::vector<collision_tri_t> m_collision_tris; // Formerly MAX_COLLISION_TRIS = 100000
+    std::vector<int> m_free_collision_tris; // Slots of removed tris, reused by `registerCollisionTri()`
+    std::vector<int> m_free_collision_boxes; // Slots of removed boxes without event source, reused by `addCollisionBox()`
 
     Ogre::AxisAlignedBox m_collision_aab; // Tight bounding box around all collision meshes
 
@@ -139,6 +179,7 @@ private:
     const Ogre::Vector3 m_terrain_size;
 
     void hash_add(int cell_x, int cell_z, int value, float h);
+    void hash_remove(int cell_x, int cell_z, int value);
     int hash_find(int cell_x, int cell_z); /// Returns index to 'hashtable'
     unsigned int hashfunc(unsigned int cellid);
     void parseGroundConfig(Ogre::ConfigFile* cfg, Ogre::String groundModel = "");
@@ -168,10 +209,15 @@ public:
     bool nodeCollision(node_t* node, float dt, bool envokeScriptCallbacks = true);
 
     void finishLoadingTerrain();
+    void loadCollisionCache(std::string const& terrain_hash); //!< Enables the baked collision mesh cache; call before adding meshes.
 
     int addCollisionBox(Ogre::SceneNode* tenode, bool rotating, bool virt, Ogre::Vector3 pos, Ogre::Vector3 rot, Ogre::Vector3 l, Ogre::Vector3 h, Ogre::Vector3 sr, const Ogre::String& eventname, const Ogre::String& instancename, bool forcecam, Ogre::Vector3 campos, Ogre::Vector3 sc = Ogre::Vector3::UNIT_SCALE, Ogre::Vector3 dr = Ogre::Vector3::ZERO, CollisionEventFilter event_filter = EVENT_ALL, int scripthandler = -1);
+    int registerCollisionBox(collision_box_t coll_box, Ogre::Quaternion direction, Ogre::SceneNode* tenode, const Ogre::String& eventname, const Ogre::String& instancename, int scripthandler = -1); //!< Inserts a box from `buildCollisionBox()`
+    static void buildCollisionBox(bool rotating, bool virt, Ogre::Vector3 pos, Ogre::Vector3 rot, Ogre::Vector3 l, Ogre::Vector3 h, Ogre::Vector3 sr, bool forcecam, Ogre::Vector3 campos, Ogre::Vector3 sc, CollisionEventFilter event_filter, collision_box_t& out); //!< Thread-safe, doesn't register the box.
     int addCollisionMesh(Ogre::String meshname, Ogre::Vector3 pos, Ogre::Quaternion q, Ogre::Vector3 scale, ground_model_t* gm = 0, std::vector<int>* collTris = 0);
     int addCollisionTri(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, ground_model_t* gm);
+    void addCollisionTris(std::vector<collision_tri_t> const& tris, std::vector<int>& out_ids); //!< Bulk insert of tris from `buildCollisionTri()`
+    static void buildCollisionTri(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, ground_model_t* gm, collision_tri_t& out); //!< Thread-safe, doesn't register the tri.
     int createCollisionDebugVisualization();
     void removeCollisionBox(int number);
     void removeCollisionTri(int number);
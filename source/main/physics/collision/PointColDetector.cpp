@@ -24,9 +24,22 @@
 #include "ActorManager.h"
 #include "GameContext.h"
 
+#include <algorithm>
+#include <cfloat>
+
 using namespace Ogre;
 using namespace RoR;
 
+const float PointColDetector::REBUILD_AREA_RATIO = 2.f;
+
+static inline float GetBoxArea(const float* min, const float* max)
+{
+    const float dx = max[0] - min[0];
+    const float dy = max[1] - min[1];
+    const float dz = max[2] - min[2];
+    return 2.f * (dx * dy + dy * dz + dz * dx);
+}
+
 void PointColDetector::UpdateIntraPoint(bool contactables)
 {
     int contacters_size = contactables ? m_actor->ar_num_contactable_nodes : m_actor->ar_num_contacters;
@@ -38,9 +51,7 @@ void PointColDetector::UpdateIntraPoint(bool contactables)
         update_structures_for_contacters(contactables);
     }
 
-    m_kdtree[0].ref = NULL;
-    m_kdtree[0].begin = 0;
-    m_kdtree[0].end = -m_object_list_size;
+    m_needs_refit = true;
 }
 
 void PointColDetector::UpdateInterPoint(bool ignorestate)
@@ -82,17 +93,15 @@ void PointColDetector::UpdateInterPoint(bool ignorestate)
         update_structures_for_contacters(false);
     }
 
-    m_kdtree[0].ref = NULL;
-    m_kdtree[0].begin = 0;
-    m_kdtree[0].end = -m_object_list_size;
+    m_needs_refit = true;
 }
 
 void PointColDetector::update_structures_for_contacters(bool ignoreinternal)
 {
-    m_ref_list.resize(m_object_list_size);
     m_pointid_list.resize(m_object_list_size);
+    m_point_src.resize(m_object_list_size);
 
-    // Insert all contacters into the list of points to consider when building the kdtree
+    // Insert all contacters into the list of points to consider when building the BVH
     int refi = 0;
     for (auto actor : m_collision_partners)
     {
@@ -104,14 +113,13 @@ void PointColDetector::update_structures_for_contacters(bool ignoreinternal)
             {
                 m_pointid_list[refi].actor = actor;
                 m_pointid_list[refi].node_id = i;
-                m_ref_list[refi].pidref = &m_pointid_list[refi];
-                m_ref_list[refi].point = actor->ar_nodes[i].AbsPosition.ptr();
+                m_point_src[refi] = &actor->ar_nodes[i].AbsPosition;
                 refi++;
             }
         }
     }
 
-    m_kdtree.resize(std::max(1.0, std::pow(2, std::ceil(std::log2(m_object_list_size)) + 1)));
+    m_needs_rebuild = true;
 }
 
 void PointColDetector::query(const Vector3 &vec1, const Vector3 &vec2, const Vector3 &vec3, float enlargeBB)
@@ -143,187 +151,218 @@ void PointColDetector::query(const Vector3 &vec1, const Vector3 &vec2, const Vec
     m_bbmax += enlargeBB;
 
     hit_list.clear();
-    queryrec(0, 0);
-}
 
-void PointColDetector::queryrec(int kdindex, int axis)
-{
-    for (;;)
+    if (m_needs_rebuild)
     {
-        if (m_kdtree[kdindex].end < 0)
-        {
-            build_kdtree_incr(axis, kdindex);
-        }
+        this->build_bvh();
+    }
+    else if (m_needs_refit)
+    {
+        this->refit_bvh();
+    }
+
+    if (m_bvh.empty())
+    {
+        return;
+    }
 
-        if (m_kdtree[kdindex].ref != NULL)
+    // Iterative traversal, nearer-to-root nodes first
+    int stack[MAX_DEPTH];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0)
+    {
+        const bvhnode_t& node = m_bvh[stack[--stack_size]];
+        if (m_bbmax.x < node.min[0] || m_bbmin.x > node.max[0] ||
+            m_bbmax.y < node.min[1] || m_bbmin.y > node.max[1] ||
+            m_bbmax.z < node.min[2] || m_bbmin.z > node.max[2])
         {
-            const float *point = m_kdtree[kdindex].ref->point;
-            if (point[0] >= m_bbmin.x && point[0] <= m_bbmax.x &&
-                point[1] >= m_bbmin.y && point[1] <= m_bbmax.y &&
-                point[2] >= m_bbmin.z && point[2] <= m_bbmax.z)
-            {
-                hit_list.push_back(m_kdtree[kdindex].ref->pidref);
-            }
-            return;
+            continue;
         }
 
-        if (m_bbmax[axis] >= m_kdtree[kdindex].middle)
+        if (node.count > 0)
         {
-            if (m_bbmin[axis] > m_kdtree[kdindex].max)
+            const int end = node.first + node.count;
+            for (int i = node.first; i < end; i++)
             {
-                return;
-            }
-
-            int newaxis = axis + 1;
-
-            if (newaxis >= 3)
-            {
-                newaxis = 0;
-            }
-
-            int newindex = kdindex + kdindex + 1;
-
-            if (m_bbmin[axis] <= m_kdtree[kdindex].middle)
-            {
-                queryrec(newindex, newaxis);
+                if (m_point_x[i] >= m_bbmin.x && m_point_x[i] <= m_bbmax.x &&
+                    m_point_y[i] >= m_bbmin.y && m_point_y[i] <= m_bbmax.y &&
+                    m_point_z[i] >= m_bbmin.z && m_point_z[i] <= m_bbmax.z)
+                {
+                    hit_list.push_back(&m_pointid_list[i]);
+                }
             }
-
-            kdindex = newindex + 1;
-            axis = newaxis;
         }
         else
         {
-            if (m_bbmax[axis] < m_kdtree[kdindex].min)
-            {
-                return;
-            }
-
-            kdindex = 2 * kdindex + 1;
-            axis++;
-
-            if (axis >= 3)
-            {
-                axis = 0;
-            }
+            stack[stack_size++] = node.first + 1;
+            stack[stack_size++] = node.first;
         }
     }
 }
 
-void PointColDetector::build_kdtree_incr(int axis, int index)
+void PointColDetector::gather_points()
 {
-    int end = -m_kdtree[index].end;
-    m_kdtree[index].end = end;
-    int begin = m_kdtree[index].begin;
-    int median;
-    int slice_size = end - begin;
-    if (slice_size != 1)
+    m_point_x.resize(m_object_list_size);
+    m_point_y.resize(m_object_list_size);
+    m_point_z.resize(m_object_list_size);
+    for (int i = 0; i < m_object_list_size; i++)
     {
-        int newindex=index+index+1;
-        if (slice_size == 2)
-        {
-            median = begin+1;
-            if (m_ref_list[begin].point[axis] > m_ref_list[median].point[axis])
-            {
-                std::swap(m_ref_list[begin], m_ref_list[median]);
-            }
+        m_point_x[i] = m_point_src[i]->x;
+        m_point_y[i] = m_point_src[i]->y;
+        m_point_z[i] = m_point_src[i]->z;
+    }
+}
+
+void PointColDetector::build_bvh()
+{
+    m_needs_rebuild = false;
+    m_needs_refit = false;
+    m_bvh.clear();
+    m_built_leaf_area = 0.f;
 
-            m_kdtree[index].min = m_ref_list[begin].point[axis];
-            m_kdtree[index].max = m_ref_list[median].point[axis];
-            m_kdtree[index].middle = m_kdtree[index].max;
-            m_kdtree[index].ref = NULL;
+    this->gather_points();
+    if (m_object_list_size <= 0)
+    {
+        return;
+    }
+
+    const float* coords[3] = { m_point_x.data(), m_point_y.data(), m_point_z.data() };
+    std::vector<int> order(m_object_list_size);
+    for (int i = 0; i < m_object_list_size; i++)
+    {
+        order[i] = i;
+    }
 
-            axis++;
-            if (axis >= 3)
+    // Top-down median split along the longest axis; each entry is {node, begin, end}.
+    int stack[MAX_DEPTH][3];
+    int stack_size = 0;
+    m_bvh.push_back(bvhnode_t());
+    stack[stack_size][0] = 0;
+    stack[stack_size][1] = 0;
+    stack[stack_size][2] = m_object_list_size;
+    stack_size++;
+    while (stack_size > 0)
+    {
+        stack_size--;
+        const int index = stack[stack_size][0];
+        const int begin = stack[stack_size][1];
+        const int end = stack[stack_size][2];
+
+        float bmin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float bmax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (int i = begin; i < end; i++)
+        {
+            for (int axis = 0; axis < 3; axis++)
             {
-                axis = 0;
+                bmin[axis] = std::min(bmin[axis], coords[axis][order[i]]);
+                bmax[axis] = std::max(bmax[axis], coords[axis][order[i]]);
             }
-
-            m_kdtree[newindex].ref = &m_ref_list[begin];
-            m_kdtree[newindex].middle = m_kdtree[newindex].ref->point[axis];
-            m_kdtree[newindex].min = m_kdtree[newindex].middle;
-            m_kdtree[newindex].max = m_kdtree[newindex].middle;
-            m_kdtree[newindex].end = median;
-            newindex++;
-
-            m_kdtree[newindex].ref = &m_ref_list[median];
-            m_kdtree[newindex].middle = m_kdtree[newindex].ref->point[axis];
-            m_kdtree[newindex].min = m_kdtree[newindex].middle;
-            m_kdtree[newindex].max = m_kdtree[newindex].middle;
-            m_kdtree[newindex].end = end;
-            return;
         }
-        else
+        for (int axis = 0; axis < 3; axis++)
         {
-            median = begin + (slice_size / 2);
-            partintwo(begin, median, end, axis, m_kdtree[index].min, m_kdtree[index].max);
+            m_bvh[index].min[axis] = bmin[axis];
+            m_bvh[index].max[axis] = bmax[axis];
         }
 
-        m_kdtree[index].middle = m_ref_list[median].point[axis];
-        m_kdtree[index].ref = NULL;
-
-        m_kdtree[newindex].begin = begin;
-        m_kdtree[newindex].end = -median;
+        if (end - begin <= LEAF_SIZE)
+        {
+            m_bvh[index].first = begin;
+            m_bvh[index].count = end - begin;
+            continue;
+        }
 
-        newindex++;
-        m_kdtree[newindex].begin = median;
-        m_kdtree[newindex].end = -end;
+        int split_axis = 0;
+        for (int axis = 1; axis < 3; axis++)
+        {
+            if (bmax[axis] - bmin[axis] > bmax[split_axis] - bmin[split_axis])
+            {
+                split_axis = axis;
+            }
+        }
+        const float* split_coords = coords[split_axis];
+        const int median = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + median, order.begin() + end,
+            [split_coords](int a, int b) { return split_coords[a] < split_coords[b]; });
+
+        const int left = static_cast<int>(m_bvh.size());
+        m_bvh.resize(m_bvh.size() + 2);
+        m_bvh[index].first = left;
+        m_bvh[index].count = 0;
+
+        stack[stack_size][0] = left;
+        stack[stack_size][1] = begin;
+        stack[stack_size][2] = median;
+        stack_size++;
+        stack[stack_size][0] = left + 1;
+        stack[stack_size][1] = median;
+        stack[stack_size][2] = end;
+        stack_size++;
+    }
 
+    // Store the points in leaf order, so every leaf is a contiguous range
+    std::vector<pointid_t> pointid_list(m_object_list_size);
+    std::vector<const Ogre::Vector3*> point_src(m_object_list_size);
+    for (int i = 0; i < m_object_list_size; i++)
+    {
+        pointid_list[i] = m_pointid_list[order[i]];
+        point_src[i] = m_point_src[order[i]];
     }
-    else
+    m_pointid_list.swap(pointid_list);
+    m_point_src.swap(point_src);
+    this->gather_points();
+
+    for (const bvhnode_t& node: m_bvh)
     {
-        m_kdtree[index].ref = &m_ref_list[begin];
-        m_kdtree[index].middle = m_kdtree[index].ref->point[axis];
-        m_kdtree[index].min = m_kdtree[index].middle;
-        m_kdtree[index].max = m_kdtree[index].middle;
+        if (node.count > 0)
+        {
+            m_built_leaf_area += GetBoxArea(node.min, node.max);
+        }
     }
 }
 
-void PointColDetector::partintwo(const int start, const int median, const int end, const int axis, float &minex, float &maxex)
+void PointColDetector::refit_bvh()
 {
-    int i, j, l, m;
-    int k = median;
-    l = start;
-    m = end - 1;
+    m_needs_refit = false;
+    this->gather_points();
 
-    float x = m_ref_list[k].point[axis];
-    while (l < m)
+    // Children are always stored after their parent - a reverse sweep updates them first.
+    float leaf_area = 0.f;
+    for (int i = static_cast<int>(m_bvh.size()) - 1; i >= 0; i--)
     {
-        i = l;
-        j = m;
-        while (!(j < k || k < i))
+        bvhnode_t& node = m_bvh[i];
+        if (node.count > 0)
         {
-            while (m_ref_list[i].point[axis] < x)
-            {
-                i++;
-            }
-            while (x < m_ref_list[j].point[axis])
+            const int end = node.first + node.count;
+            node.min[0] = node.max[0] = m_point_x[node.first];
+            node.min[1] = node.max[1] = m_point_y[node.first];
+            node.min[2] = node.max[2] = m_point_z[node.first];
+            for (int j = node.first + 1; j < end; j++)
             {
-                j--;
+                node.min[0] = std::min(node.min[0], m_point_x[j]);
+                node.max[0] = std::max(node.max[0], m_point_x[j]);
+                node.min[1] = std::min(node.min[1], m_point_y[j]);
+                node.max[1] = std::max(node.max[1], m_point_y[j]);
+                node.min[2] = std::min(node.min[2], m_point_z[j]);
+                node.max[2] = std::max(node.max[2], m_point_z[j]);
             }
-
-            std::swap(m_ref_list[i], m_ref_list[j]);
-            i++;
-            j--;
+            leaf_area += GetBoxArea(node.min, node.max);
         }
-        if (j < k)
-        {
-            l = i;
-        }
-        if (k < i)
+        else
         {
-            m = j;
+            const bvhnode_t& left = m_bvh[node.first];
+            const bvhnode_t& right = m_bvh[node.first + 1];
+            for (int axis = 0; axis < 3; axis++)
+            {
+                node.min[axis] = std::min(left.min[axis], right.min[axis]);
+                node.max[axis] = std::max(left.max[axis], right.max[axis]);
+            }
         }
-        x = m_ref_list[k].point[axis];
     }
 
-    minex = x;
-    maxex = x;
-    for (int i = start; i < median; ++i)
-    {
-        minex = std::min(m_ref_list[i].point[axis], minex);
-    }
-    for (int i = median+1; i < end; ++i)
+    // Points moved relative to each other (i.e. actors passing by) - the tree got loose
+    if (leaf_area > m_built_leaf_area * REBUILD_AREA_RATIO + 1.f)
     {
-        maxex = std::max(maxex, m_ref_list[i].point[axis]);
+        this->build_bvh();
     }
 }
@@ -35,7 +35,8 @@ public:
 
     std::vector<pointid_t*> hit_list;
 
-    PointColDetector(Actor* actor): m_actor(actor), m_object_list_size(-1) {};
+    PointColDetector(Actor* actor)
+        : m_actor(actor), m_object_list_size(-1), m_built_leaf_area(0.f), m_needs_rebuild(true), m_needs_refit(false) {};
 
     void UpdateIntraPoint(bool contactables = false);
     void UpdateInterPoint(bool ignorestate = false);
@@ -43,36 +44,39 @@ public:
 
 private:
 
-    struct refelem_t
-    {
-        pointid_t* pidref;
-        const float* point;
-    };
+    static const int   LEAF_SIZE = 8;             //!< Max. points per BVH leaf
+    static const int   MAX_DEPTH = 64;            //!< Traversal stack size; median splits keep the depth near log2(points / LEAF_SIZE)
+    static const float REBUILD_AREA_RATIO;        //!< Rebuild instead of refit when leaf boxes grow this much since the last build
 
-    struct kdnode_t
+    /// Flattened BVH node; the children of an inner node are stored next to each other, after their parent.
+    struct bvhnode_t
     {
-        float min;
-        int end;
-        float max;
-        refelem_t* ref;
-        float middle;
-        int begin;
+        float min[3];
+        float max[3];
+        int   first; //!< Leaf: first point; inner node: left child (right child is `first + 1`)
+        int   count; //!< Leaf: number of points; inner node: 0
     };
 
     Actor*                 m_actor;
     std::vector<Actor*>    m_linked_actors;
     std::vector<Actor*>    m_collision_partners;
-    std::vector<refelem_t> m_ref_list;
-    std::vector<pointid_t> m_pointid_list;
-    std::vector<kdnode_t>  m_kdtree;
+    std::vector<pointid_t> m_pointid_list;     //!< In BVH leaf order
+    std::vector<const Ogre::Vector3*> m_point_src; //!< Node positions to gather from, in BVH leaf order
+    std::vector<float>     m_point_x;          //!< Gathered positions (SoA), in BVH leaf order
+    std::vector<float>     m_point_y;
+    std::vector<float>     m_point_z;
+    std::vector<bvhnode_t> m_bvh;
     Ogre::Vector3          m_bbmin;
     Ogre::Vector3          m_bbmax;
     int                    m_object_list_size;
+    float                  m_built_leaf_area;  //!< Total leaf surface area right after the last build
+    bool                   m_needs_rebuild;    //!< The set of points changed
+    bool                   m_needs_refit;      //!< The points moved; refit is done by the first query
 
-    void queryrec(int kdindex, int axis);
-    void build_kdtree_incr(int axis, int index);
-    void partintwo(const int start, const int median, const int end, const int axis, float& minex, float& maxex);
     void update_structures_for_contacters(bool ignoreinternal);
+    void gather_points();
+    void build_bvh();
+    void refit_bvh();
 };
 
 } // namespace RoR
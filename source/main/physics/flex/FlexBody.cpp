@@ -31,6 +31,9 @@
 
 #include <Ogre.h>
 
+#include <algorithm>
+#include <limits>
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -62,6 +65,11 @@ FlexBody::FlexBody(
     , m_dst_pos(nullptr)
     , m_src_colors(nullptr)
     , m_gfx_actor(gfx_actor)
+    , m_lod_rigid(false)
+    , m_lod_deformed(false)
+    , m_lod_skipped_frames(0)
+    , m_lod_ref_orientation(Ogre::Quaternion::IDENTITY)
+    , m_lod_rigid_orientation(Ogre::Quaternion::IDENTITY)
 {
 
     Ogre::Vector3* vertices = nullptr;
@@ -511,6 +519,8 @@ FlexBody::FlexBody(
 
     if (vertices != nullptr) { free(vertices); }
 
+    m_kernel.Build(m_locators, m_src_normals, m_vertex_count);
+
 #ifdef FLEXBODY_LOG_LOADING_TIMES
     char stats[1000];
     sprintf(stats, "FLEXBODY (%s) ready, stats:"
@@ -606,6 +616,100 @@ void FlexBody::printMeshInfo(Mesh* mesh)
     }
 }
 
+void FlexBody::DeformKernel::Build(Locator_t const* locators, Ogre::Vector3 const* src_normals, size_t count)
+{
+    // Sort vertices by their node triple, so that each node-frame basis is computed only once
+    std::vector<int> order(count);
+    for (int i=0; i<(int)count; i++)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [locators](int a, int b)
+        {
+            const Locator_t& la = locators[a];
+            const Locator_t& lb = locators[b];
+            if (la.ref != lb.ref) return la.ref < lb.ref;
+            if (la.nx  != lb.nx)  return la.nx  < lb.nx;
+            return la.ny < lb.ny;
+        });
+
+    frames.clear();
+    slot_vertex = order;
+    for (int c=0; c<3; c++)
+    {
+        coords[c].resize(count);
+        normals[c].resize(count);
+        out_pos[c].resize(count);
+        out_normals[c].resize(count);
+    }
+
+    for (int slot=0; slot<(int)count; slot++)
+    {
+        const Locator_t& loc = locators[order[slot]];
+        if (frames.empty() ||
+            frames.back().ref != loc.ref || frames.back().nx != loc.nx || frames.back().ny != loc.ny)
+        {
+            LocatorFrame frame;
+            frame.ref = loc.ref;
+            frame.nx = loc.nx;
+            frame.ny = loc.ny;
+            frame.first_slot = slot;
+            frame.num_slots = 0;
+            frames.push_back(frame);
+        }
+        frames.back().num_slots++;
+
+        coords[0][slot] = loc.coords.x;
+        coords[1][slot] = loc.coords.y;
+        coords[2][slot] = loc.coords.z;
+        normals[0][slot] = src_normals[order[slot]].x;
+        normals[1][slot] = src_normals[order[slot]].y;
+        normals[2][slot] = src_normals[order[slot]].z;
+    }
+}
+
+void FlexBody::DeformKernel::Compute(GfxActor::SimBuffer::NodeSB const* nodes, Ogre::Vector3 const& center)
+{
+    const float* const cx = coords[0].data();
+    const float* const cy = coords[1].data();
+    const float* const cz = coords[2].data();
+    const float* const sx = normals[0].data();
+    const float* const sy = normals[1].data();
+    const float* const sz = normals[2].data();
+    float* const px = out_pos[0].data();
+    float* const py = out_pos[1].data();
+    float* const pz = out_pos[2].data();
+    float* const nx = out_normals[0].data();
+    float* const ny = out_normals[1].data();
+    float* const nz = out_normals[2].data();
+
+    for (const LocatorFrame& frame: frames)
+    {
+        // Node-frame basis - shared by all vertices of the frame
+        const Vector3 diffX = nodes[frame.nx].AbsPosition - nodes[frame.ref].AbsPosition;
+        const Vector3 diffY = nodes[frame.ny].AbsPosition - nodes[frame.ref].AbsPosition;
+        const Vector3 nCross = fast_normalise(diffX.crossProduct(diffY));
+        const Vector3 origin = nodes[frame.ref].AbsPosition - center;
+
+        // Straight-line loop over contiguous floats - meant to be auto-vectorized
+        const int end = frame.first_slot + frame.num_slots;
+        for (int k = frame.first_slot; k < end; k++)
+        {
+            px[k] = origin.x + diffX.x * cx[k] + diffY.x * cy[k] + nCross.x * cz[k];
+            py[k] = origin.y + diffX.y * cx[k] + diffY.y * cy[k] + nCross.y * cz[k];
+            pz[k] = origin.z + diffX.z * cx[k] + diffY.z * cy[k] + nCross.z * cz[k];
+
+            const float wx = diffX.x * sx[k] + diffY.x * sy[k] + nCross.x * sz[k];
+            const float wy = diffX.y * sx[k] + diffY.y * sy[k] + nCross.y * sz[k];
+            const float wz = diffX.z * sx[k] + diffY.z * sy[k] + nCross.z * sz[k];
+            const float inv_len = 1.f / std::sqrt(wx * wx + wy * wy + wz * wz);
+            nx[k] = wx * inv_len;
+            ny[k] = wy * inv_len;
+            nz[k] = wz * inv_len;
+        }
+    }
+}
+
 void FlexBody::ComputeFlexbody()
 {
     if (m_has_texture_blend) updateBlend();
@@ -630,28 +734,131 @@ void FlexBody::ComputeFlexbody()
         m_flexit_center = nodes[0].AbsPosition;
     }
 
-    for (int i=0; i<(int)m_vertex_count; i++)
+    m_lod_rigid = false;
+    m_lod_deformed = true;
+    m_lod_ref_orientation = this->CalcRefFrameOrientation();
+
+    m_kernel.Compute(nodes, m_flexit_center);
+
+    const float* const px = m_kernel.out_pos[0].data();
+    const float* const py = m_kernel.out_pos[1].data();
+    const float* const pz = m_kernel.out_pos[2].data();
+    const float* const nx = m_kernel.out_normals[0].data();
+    const float* const ny = m_kernel.out_normals[1].data();
+    const float* const nz = m_kernel.out_normals[2].data();
+
+    // Scatter back to mesh vertex order
+    const int* const slot_vertex = m_kernel.slot_vertex.data();
+    for (int k=0; k<(int)m_vertex_count; k++)
     {
-        Vector3 diffX = nodes[m_locators[i].nx].AbsPosition - nodes[m_locators[i].ref].AbsPosition;
-        Vector3 diffY = nodes[m_locators[i].ny].AbsPosition - nodes[m_locators[i].ref].AbsPosition;
-        Vector3 nCross = fast_normalise(diffX.crossProduct(diffY)); //nCross.normalise();
+        const int i = slot_vertex[k];
+        m_dst_pos[i].x = px[k];
+        m_dst_pos[i].y = py[k];
+        m_dst_pos[i].z = pz[k];
+        m_dst_normals[i].x = nx[k];
+        m_dst_normals[i].y = ny[k];
+        m_dst_normals[i].z = nz[k];
+    }
 
-        m_dst_pos[i].x = diffX.x * m_locators[i].coords.x + diffY.x * m_locators[i].coords.y + nCross.x * m_locators[i].coords.z;
-        m_dst_pos[i].y = diffX.y * m_locators[i].coords.x + diffY.y * m_locators[i].coords.y + nCross.y * m_locators[i].coords.z;
-        m_dst_pos[i].z = diffX.z * m_locators[i].coords.x + diffY.z * m_locators[i].coords.y + nCross.z * m_locators[i].coords.z;
+    // Bounds of the deformed mesh, for the LOD visibility test
+    Vector3 bounds_min(std::numeric_limits<float>::max());
+    Vector3 bounds_max(-std::numeric_limits<float>::max());
+    for (int k = 0; k < (int)m_vertex_count; k++)
+    {
+        bounds_min.x = std::min(bounds_min.x, px[k]);
+        bounds_min.y = std::min(bounds_min.y, py[k]);
+        bounds_min.z = std::min(bounds_min.z, pz[k]);
+        bounds_max.x = std::max(bounds_max.x, px[k]);
+        bounds_max.y = std::max(bounds_max.y, py[k]);
+        bounds_max.z = std::max(bounds_max.z, pz[k]);
+    }
+    if (m_vertex_count > 0)
+        m_lod_bounds.setExtents(bounds_min, bounds_max);
+    else
+        m_lod_bounds.setNull();
+}
 
-        m_dst_pos[i] += nodes[m_locators[i].ref].AbsPosition - m_flexit_center;
+Ogre::Quaternion FlexBody::CalcRefFrameOrientation()
+{
+    if (m_node_center < 0)
+    {
+        return Ogre::Quaternion::IDENTITY;
+    }
+
+    RoR::GfxActor::SimBuffer::NodeSB* nodes = m_gfx_actor->GetSimNodeBuffer();
+    Vector3 diffX = nodes[m_node_x].AbsPosition - nodes[m_node_center].AbsPosition;
+    Vector3 diffY = nodes[m_node_y].AbsPosition - nodes[m_node_center].AbsPosition;
+    Vector3 normal = fast_normalise(diffY.crossProduct(diffX));
+    Vector3 refX = fast_normalise(diffX);
+    Vector3 refY = refX.crossProduct(normal);
+    return Quaternion(refX, normal, refY);
+}
+
+void FlexBody::CalcRigidPlacement(Ogre::Vector3& out_center, Ogre::Quaternion& out_rotation)
+{
+    RoR::GfxActor::SimBuffer::NodeSB* nodes = m_gfx_actor->GetSimNodeBuffer();
+
+    if (m_node_center >= 0)
+    {
+        Vector3 diffX = nodes[m_node_x].AbsPosition - nodes[m_node_center].AbsPosition;
+        Vector3 diffY = nodes[m_node_y].AbsPosition - nodes[m_node_center].AbsPosition;
+        Vector3 flexit_normal = fast_normalise(diffY.crossProduct(diffX));
+
+        out_center = nodes[m_node_center].AbsPosition + m_center_offset.x * diffX + m_center_offset.y * diffY;
+        out_center += m_center_offset.z * flexit_normal;
+    }
+    else
+    {
+        out_center = nodes[0].AbsPosition;
+    }
+
+    // Vertices were deformed in world orientation - rotate them by the frame's rotation since then.
+    out_rotation = this->CalcRefFrameOrientation() * m_lod_ref_orientation.Inverse();
+}
 
-        m_dst_normals[i].x = diffX.x * m_src_normals[i].x + diffY.x * m_src_normals[i].y + nCross.x * m_src_normals[i].z;
-        m_dst_normals[i].y = diffX.y * m_src_normals[i].x + diffY.y * m_src_normals[i].y + nCross.y * m_src_normals[i].z;
-        m_dst_normals[i].z = diffX.z * m_src_normals[i].x + diffY.z * m_src_normals[i].y + nCross.z * m_src_normals[i].z;
+void FlexBody::ComputeFlexbodyRigid()
+{
+    this->CalcRigidPlacement(m_flexit_center, m_lod_rigid_orientation);
+    m_lod_rigid = true;
+}
 
-        m_dst_normals[i] = fast_normalise(m_dst_normals[i]);
+bool FlexBody::IsLodUpdateDue(int interval)
+{
+    if (++m_lod_skipped_frames >= interval)
+    {
+        m_lod_skipped_frames = 0;
+        return true;
     }
+    return false;
+}
+
+Ogre::AxisAlignedBox FlexBody::GetWorldBounds()
+{
+    Ogre::Vector3 center;
+    Ogre::Quaternion rotation;
+    this->CalcRigidPlacement(center, rotation);
+
+    Ogre::Matrix4 transform;
+    transform.makeTransform(center, Ogre::Vector3::UNIT_SCALE, rotation);
+    Ogre::AxisAlignedBox bounds = m_lod_bounds;
+    bounds.transform(transform);
+    return bounds;
+}
+
+bool FlexBody::IsCastingShadows() const
+{
+    return m_scene_entity->getCastShadows();
 }
 
 void FlexBody::UpdateFlexbodyVertexBuffers()
 {
+    if (m_lod_rigid)
+    {
+        m_scene_node->setPosition(m_flexit_center);
+        m_scene_node->setOrientation(m_lod_rigid_orientation);
+        return;
+    }
+
     Vector3 *ppt = m_dst_pos;
     Vector3 *npt = m_dst_normals;
     if (m_uses_shared_vertex_data)
@@ -676,6 +883,7 @@ void FlexBody::UpdateFlexbodyVertexBuffers()
     }
 
     m_scene_node->setPosition(m_flexit_center);
+    m_scene_node->setOrientation(Ogre::Quaternion::IDENTITY);
 }
 
 void FlexBody::reset()
@@ -23,6 +23,7 @@
 
 #include "RigDef_Prerequisites.h"
 #include "Application.h"
+#include "GfxActor.h"
 #include "Locator_t.h"
 
 #include <OgreVector3.h>
@@ -30,6 +31,8 @@
 #include <OgreHardwareVertexBuffer.h>
 #include <OgreMesh.h>
 
+#include <vector>
+
 namespace RoR {
 
 /// Flexbody = A deformable mesh; updated on CPU every frame, then uploaded to video memory
@@ -65,16 +68,52 @@ public:
     int getCameraMode() { return m_camera_mode; };
 
     void ComputeFlexbody(); //!< Updates mesh deformation; works on CPU using local copy of vertex data.
+    void ComputeFlexbodyRigid(); //!< LOD fallback; moves the last deformed mesh along with the reference node frame, no deformation.
     void UpdateFlexbodyVertexBuffers();
 
+    /// Flexbody LOD: counts frames since the last full update
+    /// @return True if the full update is due (and resets the counter).
+    bool IsLodUpdateDue(int interval);
+    bool IsDeformed() const { return m_lod_deformed; } //!< Was `ComputeFlexbody()` run at least once?
+    bool IsCastingShadows() const;
+    Ogre::AxisAlignedBox GetWorldBounds(); //!< Bounds of the last deformed mesh, placed by the current reference node frame
+
     void setVisible(bool visible);
 
     void SetFlexbodyCastShadow(bool val);
 
     int size() { return static_cast<int>(m_vertex_count); };
 
+    /// Vertices sharing one ref/nx/ny node triple; the node-frame basis is computed once per frame.
+    struct LocatorFrame
+    {
+        int ref;
+        int nx;
+        int ny;
+        int first_slot; //!< Index into the SoA kernel arrays
+        int num_slots;
+    };
+
+    /// Deformation kernel data - Structure of Arrays, sorted by node triple (see `LocatorFrame`).
+    /// Works on plain arrays only, so it runs without a mesh or render system (see 'Bench_Physics.cpp').
+    struct DeformKernel
+    {
+        void Build(Locator_t const* locators, Ogre::Vector3 const* src_normals, size_t count);
+        void Compute(GfxActor::SimBuffer::NodeSB const* nodes, Ogre::Vector3 const& center); //!< Fills `out_pos` (relative to `center`) and `out_normals`
+
+        std::vector<LocatorFrame> frames;
+        std::vector<int>          slot_vertex;    //!< Kernel slot -> vertex index
+        std::vector<float>        coords[3];      //!< Locator coords per slot (x, y, z)
+        std::vector<float>        normals[3];     //!< Source normals in node-frame basis per slot (x, y, z)
+        std::vector<float>        out_pos[3];     //!< Kernel output per slot (x, y, z)
+        std::vector<float>        out_normals[3]; //!< Kernel output per slot (x, y, z)
+    };
+
 private:
 
+    Ogre::Quaternion CalcRefFrameOrientation();
+    void CalcRigidPlacement(Ogre::Vector3& out_center, Ogre::Quaternion& out_rotation); //!< Where `ComputeFlexbodyRigid()` puts the last deformed mesh
+
     RoR::GfxActor*    m_gfx_actor;
     size_t            m_vertex_count;
     Ogre::Vector3     m_flexit_center; //!< Updated per frame
@@ -85,6 +124,8 @@ private:
     Ogre::ARGB*       m_src_colors;
     Locator_t*        m_locators; //!< 1 loc per vertex
 
+    DeformKernel      m_kernel;
+
     int               m_node_center;
     int               m_node_x;
     int               m_node_y;
@@ -93,6 +134,14 @@ private:
     Ogre::Entity*     m_scene_entity;
     int               m_camera_mode; //!< Visibility control {-2 = always, -1 = 3rdPerson only, 0+ = cinecam index}
 
+    // LOD
+    bool              m_lod_rigid;             //!< Last update was `ComputeFlexbodyRigid()`; only scene node is moved
+    bool              m_lod_deformed;
+    int               m_lod_skipped_frames;
+    Ogre::Quaternion  m_lod_ref_orientation;   //!< Reference node frame at the last full update
+    Ogre::Quaternion  m_lod_rigid_orientation; //!< Rotation since the last full update
+    Ogre::AxisAlignedBox m_lod_bounds;         //!< Deformed mesh bounds at the last full update, relative to `m_flexit_center`
+
     int                                 m_shared_buf_num_verts;
     Ogre::HardwareVertexBufferSharedPtr m_shared_vbuf_pos;
     Ogre::HardwareVertexBufferSharedPtr m_shared_vbuf_norm;
@@ -62,6 +62,8 @@ public:
 
     void setVisible(bool visible) {} // Nothing to do here
 
+    int size() { return static_cast<int>(m_mesh->sharedVertexData->vertexCount); }
+
 private:
 
     struct FlexMeshVertex
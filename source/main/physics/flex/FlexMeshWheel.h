@@ -50,6 +50,8 @@ public:
 
     void setVisible(bool visible);
 
+    int size() { return static_cast<int>(m_vertex_count); }
+
 private:
 
     FlexMeshWheel( // Use FlexFactory
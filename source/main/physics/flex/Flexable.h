@@ -35,6 +35,8 @@ public:
     virtual Ogre::Vector3 flexitFinal() = 0;
 
     virtual void setVisible(bool visible) = 0;
+
+    virtual int size() = 0; //!< Vertex count; estimated cost of `flexitCompute()`
 };
 
 } // namespace RoR
@@ -28,14 +28,19 @@
 #include "TerrainManager.h"
 #include "Water.h"
 
+#include <algorithm>
+
 using namespace Ogre;
 using namespace RoR;
 
+const float Buoyance::SPLASH_DEPTH = 0.1f;
+
 Buoyance::Buoyance(DustPool* splash, DustPool* ripple) :
     splashp(splash),
     ripplep(ripple),
     sink(0),
-    update(false)
+    update(false),
+    m_waves_time(0.f)
 {
 }
 
@@ -63,9 +68,12 @@ Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vecto
     if (type != BUOY_DRAGONLY)
     {
         //compute pression prism points
-        Vector3 ap = a + (App::GetSimTerrain()->getWater()->CalcWavesHeight(a) - a.y) * 9810 * normal;
-        Vector3 bp = b + (App::GetSimTerrain()->getWater()->CalcWavesHeight(b) - b.y) * 9810 * normal;
-        Vector3 cp = c + (App::GetSimTerrain()->getWater()->CalcWavesHeight(c) - c.y) * 9810 * normal;
+        const Vector3 pts[3] = { a, b, c };
+        float wh[3];
+        App::GetSimTerrain()->getWater()->CalcWavesHeightBatch(pts, wh, 3, m_waves_time);
+        Vector3 ap = a + (wh[0] - a.y) * 9810 * normal;
+        Vector3 bp = b + (wh[1] - b.y) * 9810 * normal;
+        Vector3 cp = c + (wh[2] - c.y) * 9810 * normal;
         //find centroid
         Vector3 ctd = (a + b + c + ap + bp + cp) / 6.0;
         //compute volume
@@ -85,7 +93,7 @@ Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vecto
         //take in account the wave speed
         //compute center
         Vector3 tc = (a + b + c) / 3.0;
-        vel = vel - App::GetSimTerrain()->getWater()->CalcWavesVelocity(tc);
+        vel = vel - App::GetSimTerrain()->getWater()->CalcWavesVelocity(tc, m_waves_time);
         float vell = vel.length();
         if (vell > 0.01)
         {
@@ -103,13 +111,13 @@ Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vecto
                     if (fxdir.y < 0)
                         fxdir.y = -fxdir.y;
 
-                    if (App::GetSimTerrain()->getWater()->CalcWavesHeight(a) - a.y < 0.1)
+                    if (App::GetSimTerrain()->getWater()->CalcWavesHeight(a, m_waves_time) - a.y < SPLASH_DEPTH)
                         splashp->malloc(a, fxdir);
 
-                    else if (App::GetSimTerrain()->getWater()->CalcWavesHeight(b) - b.y < 0.1)
+                    else if (App::GetSimTerrain()->getWater()->CalcWavesHeight(b, m_waves_time) - b.y < SPLASH_DEPTH)
                         splashp->malloc(b, fxdir);
 
-                    else if (App::GetSimTerrain()->getWater()->CalcWavesHeight(c) - c.y < 0.1)
+                    else if (App::GetSimTerrain()->getWater()->CalcWavesHeight(c, m_waves_time) - c.y < SPLASH_DEPTH)
                         splashp->malloc(c, fxdir);
                 }
             }
@@ -124,7 +132,7 @@ Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vecto
 //compute pressure and drag forces on a random triangle
 Vector3 Buoyance::computePressureForce(Vector3 a, Vector3 b, Vector3 c, Vector3 vel, int type)
 {
-    float wha = App::GetSimTerrain()->getWater()->CalcWavesHeight((a + b + c) / 3.0);
+    float wha = App::GetSimTerrain()->getWater()->CalcWavesHeight((a + b + c) / 3.0, m_waves_time);
     //check if fully emerged
     if (a.y > wha && b.y > wha && c.y > wha)
         return Vector3::ZERO;
@@ -178,9 +186,10 @@ Vector3 Buoyance::computePressureForce(Vector3 a, Vector3 b, Vector3 c, Vector3
 
 void Buoyance::computeNodeForce(node_t* a, node_t* b, node_t* c, bool doUpdate, int type)
 {
-    if (a->AbsPosition.y > App::GetSimTerrain()->getWater()->CalcWavesHeight(a->AbsPosition) &&
-        b->AbsPosition.y > App::GetSimTerrain()->getWater()->CalcWavesHeight(b->AbsPosition) &&
-        c->AbsPosition.y > App::GetSimTerrain()->getWater()->CalcWavesHeight(c->AbsPosition))
+    const Vector3 pts[3] = { a->AbsPosition, b->AbsPosition, c->AbsPosition };
+    float wh[3];
+    App::GetSimTerrain()->getWater()->CalcWavesHeightBatch(pts, wh, 3, m_waves_time);
+    if (pts[0].y > wh[0] && pts[1].y > wh[1] && pts[2].y > wh[2])
         return;
 
     update = doUpdate;
@@ -209,3 +218,100 @@ void Buoyance::computeNodeForce(node_t* a, node_t* b, node_t* c, bool doUpdate,
     b->Forces += computePressureForce(b->AbsPosition, mbc, m, vel, type) + computePressureForce(b->AbsPosition, m, mab, vel, type);
     c->Forces += computePressureForce(c->AbsPosition, mca, m, vel, type) + computePressureForce(c->AbsPosition, m, mbc, vel, type);
 }
+
+void Buoyance::computeNodeForceSubmerged(node_t* a, node_t* b, node_t* c, int type)
+{
+    IWater* water = App::GetSimTerrain()->getWater();
+
+    // Same split as `computeNodeForce()`: the medians divide the triangle into 6 parts of equal surface
+    const Vector3 m = (a->AbsPosition + b->AbsPosition + c->AbsPosition) / 3.0;
+    const Vector3 mab = (a->AbsPosition + b->AbsPosition) / 2.0;
+    const Vector3 mbc = (b->AbsPosition + c->AbsPosition) / 2.0;
+    const Vector3 mca = (c->AbsPosition + a->AbsPosition) / 2.0;
+
+    Vector3 normal = (b->AbsPosition - a->AbsPosition).crossProduct(c->AbsPosition - a->AbsPosition);
+    const float len = normal.length();
+    const float surf = len / 12.0; // surface of one part
+    if (surf * 2.0 < 0.00001)
+        return;
+    normal = normal / len;
+
+    Vector3 fa = Vector3::ZERO;
+    Vector3 fb = Vector3::ZERO;
+    Vector3 fc = Vector3::ZERO;
+
+    if (type != BUOY_DRAGONLY && !sink)
+    {
+        const Vector3 pts[7] = { a->AbsPosition, b->AbsPosition, c->AbsPosition, mab, mbc, mca, m };
+        float depth[7];
+        water->CalcWavesHeightBatch(pts, depth, 7, m_waves_time);
+        for (int i = 0; i < 7; i++)
+            depth[i] -= pts[i].y;
+
+        // closed form of the pressure prism volume from `computePressureForceSub()`: -surface * 9810 * mean depth
+        const float coef = -9810.0 * surf / 3.0;
+        fa = (coef * (2 * depth[0] + depth[3] + depth[5] + 2 * depth[6])) * normal;
+        fb = (coef * (2 * depth[1] + depth[4] + depth[3] + 2 * depth[6])) * normal;
+        fc = (coef * (2 * depth[2] + depth[5] + depth[4] + 2 * depth[6])) * normal;
+    }
+
+    if (type != BUOY_DRAGLESS)
+    {
+        //drag, with the wave speed taken at the center for all parts
+        Vector3 vel = (a->Velocity + b->Velocity + c->Velocity) / 3.0 - water->CalcWavesVelocity(m, m_waves_time);
+        float vell = vel.length();
+        if (vell > 0.01)
+        {
+            float cosaoa = fabs(normal.dotProduct(vel / vell));
+            Vector3 drg = (-500.0 * surf * vell * vell * cosaoa) * normal;
+            if (normal.dotProduct(vel / vell) < 0)
+                drg = -drg;
+            //each node gets two parts
+            fa += 2.0 * drg;
+            fb += 2.0 * drg;
+            fc += 2.0 * drg;
+        }
+    }
+
+    a->Forces += fa;
+    b->Forces += fb;
+    c->Forces += fc;
+}
+
+void Buoyance::computeCabForces(node_t* nodes, const int* cabs, const int* buoycabs, const int* buoycab_types, int num_buoycabs, AxisAlignedBox const& bbox, bool doUpdate, float waves_time)
+{
+    m_waves_time = waves_time;
+
+    IWater* water = App::GetSimTerrain()->getWater();
+    const float water_height = water->GetStaticWaterHeight();
+    const float max_ampl = water->GetWavesMaxAmplitude();
+    const float dry_above = water_height + max_ampl;
+    const float submerged_below = water_height - max_ampl - SPLASH_DEPTH;
+
+    //whole actor out of water?
+    if (bbox.getMinimum().y > dry_above)
+        return;
+
+    for (int i = 0; i < num_buoycabs; i++)
+    {
+        int tmpv = buoycabs[i] * 3;
+        node_t* a = &nodes[cabs[tmpv]];
+        node_t* b = &nodes[cabs[tmpv + 1]];
+        node_t* c = &nodes[cabs[tmpv + 2]];
+        const float min_y = std::min(a->AbsPosition.y, std::min(b->AbsPosition.y, c->AbsPosition.y));
+        const float max_y = std::max(a->AbsPosition.y, std::max(b->AbsPosition.y, c->AbsPosition.y));
+
+        if (min_y > dry_above)
+        {
+            continue; // above the highest possible wave
+        }
+        else if (max_y < submerged_below)
+        {
+            this->computeNodeForceSubmerged(a, b, c, buoycab_types[i]); // below the lowest possible wave
+        }
+        else
+        {
+            this->computeNodeForce(a, b, c, doUpdate, buoycab_types[i]);
+        }
+    }
+}
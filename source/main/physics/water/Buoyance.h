@@ -22,6 +22,8 @@
 
 #include "Application.h"
 
+#include <OgreAxisAlignedBox.h>
+
 namespace RoR {
 
 class Buoyance
@@ -31,14 +33,22 @@ public:
     Buoyance(DustPool* splash, DustPool* ripple);
     ~Buoyance();
 
+    /// Classifies buoyant cab triangles against the wave amplitude bounds and applies forces accordingly
+    void computeCabForces(node_t* nodes, const int* cabs, const int* buoycabs, const int* buoycab_types, int num_buoycabs, Ogre::AxisAlignedBox const& bbox, bool doUpdate, float waves_time);
+
     void computeNodeForce(node_t *a, node_t *b, node_t *c, bool doUpdate, int type);
 
     enum { BUOY_NORMAL, BUOY_DRAGONLY, BUOY_DRAGLESS };
 
     bool sink;
 
+    static const float SPLASH_DEPTH; //!< Vertices closer to the surface emit splash particles
+
 private:
 
+    //closed-form forces on a triangle which is entirely under water
+    void computeNodeForceSubmerged(node_t* a, node_t* b, node_t* c, int type);
+
     //compute tetrahedron volume
     inline float computeVolume(Ogre::Vector3 o, Ogre::Vector3 a, Ogre::Vector3 b, Ogre::Vector3 c);
 
@@ -50,6 +60,7 @@ private:
     
     DustPool *splashp, *ripplep;
     bool update;
+    float m_waves_time; //!< Wave clock of the current physics substep, set by `computeCabForces()`
 };
 
 } // namespace RoRs
@@ -45,12 +45,12 @@ Screwprop::Screwprop(node_t* nodes, int noderef, int nodeback, int nodeup, float
     reset();
 }
 
-void Screwprop::updateForces(int update)
+void Screwprop::updateForces(int update, float waves_time)
 {
     if (!App::GetSimTerrain()->getWater())
         return;
 
-    float depth = App::GetSimTerrain()->getWater()->CalcWavesHeight(nodes[noderef].AbsPosition) - nodes[noderef].AbsPosition.y;
+    float depth = App::GetSimTerrain()->getWater()->CalcWavesHeight(nodes[noderef].AbsPosition, waves_time) - nodes[noderef].AbsPosition.y;
     if (depth < 0)
         return; //out of water!
     Vector3 dir = nodes[nodeback].RelPosition - nodes[noderef].RelPosition;
@@ -30,7 +30,7 @@ public:
 
     Screwprop( node_t *nd, int nr, int nb, int nu, float power, int trucknum);
 
-    void updateForces(int update);
+    void updateForces(int update, float waves_time);
     void setThrottle(float val);
     void setRudder(float val);
     float getThrottle();
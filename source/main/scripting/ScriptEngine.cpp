@@ -51,6 +51,7 @@
 #include "OgreAngelscript.h"
 #include "OgreScriptBuilder.h"
 #include "PlatformUtils.h"
+#include "Profiler.h"
 #include "ScriptEvents.h"
 #include "VehicleAI.h"
 
@@ -390,6 +391,8 @@ void ScriptEngine::msgCallback(const AngelScript::asSMessageInfo *msg)
 
 int ScriptEngine::framestep(Real dt)
 {
+    ROR_PROFILE_ZONE("Scripts");
+
     // Check if we need to execute any strings
     std::vector<String> tmpQueue;
     stringExecutionQueue.pull(tmpQueue);
@@ -49,12 +49,17 @@ void Console::CVarSetupBuiltins()
     App::sim_replay_enabled      = this->CVarCreate("sim_replay_enabled",      "Replay mode",                CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::sim_replay_length       = this->CVarCreate("sim_replay_length",       "Replay length",              CVAR_ARCHIVE | CVAR_TYPE_INT,     "200");
     App::sim_replay_stepping     = this->CVarCreate("sim_replay_stepping",     "Replay Steps per second",    CVAR_ARCHIVE | CVAR_TYPE_INT,     "1000");
+    App::sim_replay_spill        = this->CVarCreate("sim_replay_spill",        "Replay disk spill",          CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::sim_realistic_commands  = this->CVarCreate("sim_realistic_commands",  "Realistic forward commands", CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::sim_races_enabled       = this->CVarCreate("sim_races_enabled",       "Races",                      CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::sim_no_collisions       = this->CVarCreate("sim_no_collisions",       "DisableCollisions",          CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::sim_no_self_collisions  = this->CVarCreate("sim_no_self_collisions",  "DisableSelfCollisions",      CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::sim_gearbox_mode        = this->CVarCreate("sim_gearbox_mode",        "GearboxMode",                CVAR_ARCHIVE | CVAR_TYPE_INT);
     App::sim_soft_reset_mode     = this->CVarCreate("sim_soft_reset_mode",     "",                                          CVAR_TYPE_BOOL,    "false");
+    App::sim_collision_cache     = this->CVarCreate("sim_collision_cache",     "Collision mesh cache",       CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
+    App::sim_object_paging       = this->CVarCreate("sim_object_paging",       "Terrain object paging",      CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::sim_object_page_radius  = this->CVarCreate("sim_object_page_radius",  "Terrain object page radius", CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "1000");
+    App::sim_object_page_budget  = this->CVarCreate("sim_object_page_budget",  "Terrain object page budget", CVAR_ARCHIVE | CVAR_TYPE_INT,     "100");
 
     App::mp_state                = this->CVarCreate("mp_state",                "",                                          CVAR_TYPE_INT,     "0"/*(int)MpState::DISABLED*/);
     App::mp_join_on_startup      = this->CVarCreate("mp_join_on_startup",      "Auto connect",               CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
@@ -96,6 +101,7 @@ void Console::CVarSetupBuiltins()
     App::diag_hide_nodes         = this->CVarCreate("diag_hide_nodes",         "Hide nodes",                 CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::diag_physics_dt         = this->CVarCreate("diag_physics_dt",          "PhysicsTimeStep",           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "0.0005");
     App::diag_terrn_log_roads    = this->CVarCreate("diag_terrn_log_roads",    "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::diag_profiler           = this->CVarCreate("diag_profiler",           "",                           CVAR_TYPE_BOOL,                   "false");
 
     App::sys_process_dir         = this->CVarCreate("sys_process_dir",         "",                           0);
     App::sys_user_dir            = this->CVarCreate("sys_user_dir",            "",                           0);
@@ -171,9 +177,14 @@ void Console::CVarSetupBuiltins()
     App::gfx_speedo_digital      = this->CVarCreate("gfx_speedo_digital",      "DigitalSpeedo",              CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::gfx_speedo_imperial     = this->CVarCreate("gfx_speedo_imperial",     "gfx_speedo_imperial",        CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::gfx_flexbody_cache      = this->CVarCreate("gfx_flexbody_cache",      "Flexbody_UseCache",          CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::gfx_flexbody_lod        = this->CVarCreate("gfx_flexbody_lod",        "Flexbody LOD",               CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::gfx_flexbody_lod_near   = this->CVarCreate("gfx_flexbody_lod_near",   "Flexbody LOD near",          CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "40");
+    App::gfx_flexbody_lod_far    = this->CVarCreate("gfx_flexbody_lod_far",    "Flexbody LOD far",           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "250");
+    App::gfx_flexbody_lod_max_skip=this->CVarCreate("gfx_flexbody_lod_max_skip","Flexbody LOD max skip",     CVAR_ARCHIVE | CVAR_TYPE_INT,     "4");
     App::gfx_reduce_shadows      = this->CVarCreate("gfx_reduce_shadows",      "Shadow optimizations",       CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::gfx_enable_rtshaders    = this->CVarCreate("gfx_enable_rtshaders",    "Use RTShader System",        CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::gfx_classic_shaders     = this->CVarCreate("gfx_classic_shaders",     "Classic material shaders",   CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::gfx_object_batching     = this->CVarCreate("gfx_object_batching",     "Batch terrain objects",      CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
 
 
 }
@@ -145,6 +145,9 @@ void TerrainEditor::UpdateInputEvents(float dt)
     }
     if (m_object_index != -1 && update)
     {
+        // Batched objects have no entity of their own, give it back so the object can be moved
+        App::GetSimTerrain()->getObjectManager()->UnbatchObject(object_list[m_object_index].node);
+
         String ssmsg = _L("Selected object: [") + TOSTRING(m_object_index) + "/" + TOSTRING(object_list.size()) + "] (" + object_list[m_object_index].name + ")";
         App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_NOTICE, ssmsg, "infromation.png", 2000, false);
         if (m_object_tracking)
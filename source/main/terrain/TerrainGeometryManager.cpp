@@ -242,6 +242,152 @@ float TerrainGeometryManager::getHeightAt(float x, float z)
     return getHeightAtTerrainPosition(tx, ty);
 }
 
+float TerrainGeometryManager::getMaxHeightAt(float x, float z)
+{
+    if (m_height_pyramid.empty())
+        return this->getHeightAt(x, z);
+
+    float tx = (x - mBase - mPos.x) / ((mSize - 1) *  mScale);
+    float ty = (z + mBase - mPos.z) / ((mSize - 1) * -mScale);
+
+    if (tx <= 0.0f || ty <= 0.0f || tx >= 1.0f || ty >= 1.0f)
+        return terrainManager->GetDef().water_bottom_height;
+
+    const int level = std::min(MAX_HEIGHT_BOUNDS_LEVEL, (int)m_height_pyramid.size() - 1);
+    const HeightBoundsLevel& lvl = m_height_pyramid[level];
+    const int cell_x = std::min(static_cast<int>(tx * (mSize - 1)) >> level, lvl.size - 1);
+    const int cell_z = std::min(static_cast<int>(ty * (mSize - 1)) >> level, lvl.size - 1);
+    return lvl.bounds[cell_z * lvl.size + cell_x].max;
+}
+
+bool TerrainGeometryManager::intersectsSegment(Ogre::Vector3 const& a, Ogre::Vector3 const& b)
+{
+    if (m_height_pyramid.empty())
+        return std::min(a.y, b.y) < this->getHeightAt(a.x, a.z); // Flat terrain
+
+    // Convert to heightmap grid space, height stays as-is
+    const Vector3 ga((a.x - mBase - mPos.x) / mScale, a.y, (mPos.z - mBase - a.z) / mScale);
+    const Vector3 gb((b.x - mBase - mPos.x) / mScale, b.y, (mPos.z - mBase - b.z) / mScale);
+    return this->intersectsHeightNode((int)m_height_pyramid.size() - 1, 0, 0, ga, gb);
+}
+
+static bool ClipSegmentToSlab(float origin, float dir, float lo, float hi, float& t0, float& t1)
+{
+    if (std::abs(dir) < 1e-6f)
+        return origin >= lo && origin <= hi;
+
+    float ta = (lo - origin) / dir;
+    float tb = (hi - origin) / dir;
+    if (ta > tb)
+        std::swap(ta, tb);
+    t0 = std::max(t0, ta);
+    t1 = std::min(t1, tb);
+    return t0 <= t1;
+}
+
+bool TerrainGeometryManager::intersectsHeightNode(int level, int cell_x, int cell_z, Ogre::Vector3 const& ga, Ogre::Vector3 const& gb)
+{
+    const HeightBoundsLevel& lvl = m_height_pyramid[level];
+    if (cell_x >= lvl.size || cell_z >= lvl.size)
+        return false;
+
+    // Clip the segment to the area of this node
+    const Vector3 dir = gb - ga;
+    float t0 = 0.f;
+    float t1 = 1.f;
+    if (!ClipSegmentToSlab(ga.x, dir.x, (float)(cell_x << level), (float)((cell_x + 1) << level), t0, t1) ||
+        !ClipSegmentToSlab(ga.z, dir.z, (float)(cell_z << level), (float)((cell_z + 1) << level), t0, t1))
+    {
+        return false;
+    }
+
+    const HeightBounds& hb = lvl.bounds[cell_z * lvl.size + cell_x];
+    const float y0 = ga.y + dir.y * t0;
+    const float y1 = ga.y + dir.y * t1;
+    if (std::min(y0, y1) > hb.max)
+        return false; // Passes above everything in this node
+
+    if (level > 0)
+    {
+        for (int i = 0; i < 4; i++)
+        {
+            if (this->intersectsHeightNode(level - 1, cell_x * 2 + (i & 1), cell_z * 2 + (i >> 1), ga, gb))
+                return true;
+        }
+        return false;
+    }
+
+    if (std::max(y0, y1) < hb.min)
+        return true; // Passes below everything in this cell
+
+    // Sample the surface across the cell
+    const float limit = (float)(mSize - 1) - 0.001f;
+    const float factor = 1.f / (float)(mSize - 1);
+    const float samples[] = { t0, (t0 + t1) * 0.5f, t1 };
+    for (float t : samples)
+    {
+        const Vector3 p = ga + dir * t;
+        const float tx = Math::Clamp(p.x, 0.f, limit) * factor;
+        const float ty = Math::Clamp(p.z, 0.f, limit) * factor;
+        if (this->getHeightAtTerrainPosition(tx, ty) > p.y)
+            return true;
+    }
+    return false;
+}
+
+void TerrainGeometryManager::buildHeightPyramid()
+{
+    m_height_pyramid.clear();
+
+    // Level 0: bounds of the 4 corners of each heightmap cell
+    HeightBoundsLevel base;
+    base.size = mSize - 1;
+    base.bounds.resize(base.size * base.size);
+    for (int z = 0; z < base.size; z++)
+    {
+        for (int x = 0; x < base.size; x++)
+        {
+            const float h00 = mHeightData[z       * mSize + x];
+            const float h10 = mHeightData[z       * mSize + x + 1];
+            const float h01 = mHeightData[(z + 1) * mSize + x];
+            const float h11 = mHeightData[(z + 1) * mSize + x + 1];
+            HeightBounds& hb = base.bounds[z * base.size + x];
+            hb.min = std::min(std::min(h00, h10), std::min(h01, h11));
+            hb.max = std::max(std::max(h00, h10), std::max(h01, h11));
+        }
+    }
+    m_height_pyramid.push_back(std::move(base));
+
+    // Next levels: bounds of up to 2x2 cells of the previous level
+    while (m_height_pyramid.back().size > 1)
+    {
+        const HeightBoundsLevel& fine = m_height_pyramid.back();
+        HeightBoundsLevel coarse;
+        coarse.size = (fine.size + 1) / 2;
+        coarse.bounds.resize(coarse.size * coarse.size);
+        for (int z = 0; z < coarse.size; z++)
+        {
+            for (int x = 0; x < coarse.size; x++)
+            {
+                HeightBounds& hb = coarse.bounds[z * coarse.size + x];
+                hb.min = std::numeric_limits<float>::max();
+                hb.max = -std::numeric_limits<float>::max();
+                for (int i = 0; i < 4; i++)
+                {
+                    const int fx = x * 2 + (i & 1);
+                    const int fz = z * 2 + (i >> 1);
+                    if (fx < fine.size && fz < fine.size)
+                    {
+                        hb.min = std::min(hb.min, fine.bounds[fz * fine.size + fx].min);
+                        hb.max = std::max(hb.max, fine.bounds[fz * fine.size + fx].max);
+                    }
+                }
+            }
+        }
+        m_height_pyramid.push_back(std::move(coarse));
+    }
+}
+
 Ogre::Vector3 TerrainGeometryManager::getNormalAt(float x, float y, float z)
 {
     const float precision = 0.1f;
@@ -350,6 +496,11 @@ bool TerrainGeometryManager::InitTerrain(std::string otc_filename)
     }
     mIsFlat = std::abs(mMaxHeight - mMinHeight) < std::numeric_limits<float>::epsilon();
 
+    if (!m_spec->is_flat && !mIsFlat && mSize > 1)
+    {
+        this->buildHeightPyramid();
+    }
+
     if (m_was_new_geometry_generated)
     {
         // update the blend maps
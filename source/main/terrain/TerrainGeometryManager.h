@@ -29,6 +29,8 @@
 #include <Terrain/OgreTerrain.h>
 #include <Terrain/OgreTerrainGroup.h>
 
+#include <vector>
+
 namespace RoR {
 
 /// this class handles all interactions with the Ogre Terrain system
@@ -43,6 +45,8 @@ public:
     Ogre::TerrainGroup* getTerrainGroup() { return m_ogre_terrain_group; };
 
     float getHeightAt(float x, float z);
+    float getMaxHeightAt(float x, float z); //!< Upper bound of the terrain height around the point, O(1).
+    bool  intersectsSegment(Ogre::Vector3 const& a, Ogre::Vector3 const& b); //!< Does the segment pass below the terrain surface?
 
     Ogre::Vector3 getNormalAt(float x, float y, float z);
 
@@ -55,7 +59,25 @@ public:
 
 private:
 
+    /// Min/max height pyramid over `mHeightData`; level 0 = one heightmap cell, each next level halves the resolution.
+    /// Used to reject queries high above the terrain and to skip empty space when tracing segments.
+    struct HeightBounds
+    {
+        float min;
+        float max;
+    };
+
+    struct HeightBoundsLevel
+    {
+        int size; //!< Cells per side
+        std::vector<HeightBounds> bounds;
+    };
+
+    static const int MAX_HEIGHT_BOUNDS_LEVEL = 4; //!< Used by `getMaxHeightAt()` - 16x16 heightmap cells
+
     float getHeightAtTerrainPosition(float x, float z);
+    void  buildHeightPyramid();
+    bool  intersectsHeightNode(int level, int cell_x, int cell_z, Ogre::Vector3 const& ga, Ogre::Vector3 const& gb);
 
     bool getTerrainImage(int x, int y, Ogre::Image& img);
     bool loadTerrainConfig(Ogre::String filename);
@@ -77,6 +99,7 @@ private:
     Ogre::Real mScale;
     Ogre::uint16 mSize;
     float* mHeightData;
+    std::vector<HeightBoundsLevel> m_height_pyramid; //!< Empty for flat terrains
 
     bool  mIsFlat;
     float mMinHeight;
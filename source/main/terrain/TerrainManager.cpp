@@ -37,6 +37,7 @@
 #include "SkyXManager.h"
 #include "TerrainGeometryManager.h"
 #include "TerrainObjectManager.h"
+#include "Utils.h"
 #include "Water.h"
 
 #include <Terrain/OgreTerrainPaging.h>
@@ -182,6 +183,11 @@ TerrainManager* TerrainManager::LoadAndPrepareTerrain(CacheEntry& entry)
 
     loading_window->SetProgress(60, _L("Initializing Collision Subsystem"));
     terrn_mgr->m_collisions = new Collisions(terrn_mgr->getMaxTerrainSize());
+    if (App::sim_collision_cache->GetBool())
+    {
+        terrn_mgr->m_collisions->loadCollisionCache(
+            Utils::Sha1Hash(entry.resource_bundle_path + "/" + entry.fname + "/" + std::to_string(entry.filetime)));
+    }
 
     loading_window->SetProgress(75, _L("Initializing Script Subsystem"));
     App::SetSimTerrain(terrn_mgr.get()); // Hack for GameScript::spawnObject()
@@ -438,6 +444,8 @@ void TerrainManager::initShadows()
 
 void TerrainManager::loadTerrainObjects()
 {
+    m_object_manager->PreloadTObjFiles(m_def.tobj_files);
+
     for (std::string tobj_filename : m_def.tobj_files)
     {
         m_object_manager->LoadTObjFile(tobj_filename);
@@ -502,6 +510,16 @@ float TerrainManager::GetHeightAt(float x, float z)
     return m_geometry_manager->getHeightAt(x, z);
 }
 
+float TerrainManager::GetMaxHeightAt(float x, float z)
+{
+    return m_geometry_manager->getMaxHeightAt(x, z);
+}
+
+bool TerrainManager::IntersectsTerrain(Ogre::Vector3 const& a, Ogre::Vector3 const& b)
+{
+    return m_geometry_manager->intersectsSegment(a, b);
+}
+
 Ogre::Vector3 TerrainManager::GetNormalAt(float x, float y, float z)
 {
     return m_geometry_manager->getNormalAt(x, y, z);
@@ -67,6 +67,8 @@ public:
     bool               HasPredefinedActors();
     void               HandleException(const char* summary);
     float              GetHeightAt(float x, float z);
+    float              GetMaxHeightAt(float x, float z);      //!< Upper bound of the terrain height around the point, O(1)
+    bool               IntersectsTerrain(Ogre::Vector3 const& a, Ogre::Vector3 const& b); //!< Does the segment pass below the terrain surface?
     Ogre::Vector3      GetNormalAt(float x, float y, float z);
 
     static const int UNLIMITED_SIGHTRANGE = 4999;
@@ -22,8 +22,11 @@
 #include "TerrainObjectManager.h"
 
 #include "Application.h"
+#include "Actor.h"
+#include "ActorManager.h"
 #include "AutoPilot.h"
 #include "CacheSystem.h"
+#include "CameraManager.h"
 #include "Collisions.h"
 #include "Console.h"
 #include "ErrorUtils.h"
@@ -36,10 +39,12 @@
 #include "ODefFileFormat.h"
 #include "PlatformUtils.h"
 #include "ProceduralManager.h"
+#include "Profiler.h"
 #include "Road2.h"
 #include "SoundScriptManager.h"
 #include "TerrainGeometryManager.h"
 #include "TerrainManager.h"
+#include "ThreadPool.h"
 #include "TObjFileFormat.h"
 #include "Utils.h"
 #include "WriteTextToTexture.h"
@@ -47,6 +52,10 @@
 #include <RTShaderSystem/OgreRTShaderSystem.h>
 #include <Overlay/OgreFontManager.h>
 
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+
 #ifdef USE_ANGELSCRIPT
 #    include "ExtinguishableFireAffector.h"
 #endif // USE_ANGELSCRIPT
@@ -79,6 +88,13 @@ TerrainObjectManager::~TerrainObjectManager()
         if (mo)
             delete mo;
     }
+    for (auto& page_entry : m_object_pages)
+    {
+        for (PagedObject& pobj : page_entry.second.loaded_objects)
+        {
+            delete pobj.mesh_object;
+        }
+    }
     for (auto geom : m_paged_geometry)
     {
         delete geom->getPageLoader();
@@ -89,6 +105,11 @@ TerrainObjectManager::~TerrainObjectManager()
         App::GetGfxScene()->GetSceneManager()->destroyStaticGeometry("bakeSG");
         m_staticgeometry = nullptr;
     }
+    if (m_batch_geometry != nullptr)
+    {
+        App::GetGfxScene()->GetSceneManager()->destroyStaticGeometry(m_batch_geometry);
+        m_batch_geometry = nullptr;
+    }
     if (m_procedural_mgr != nullptr)
     {
         delete m_procedural_mgr;
@@ -152,27 +173,213 @@ void GenerateGridAndPutToScene(Ogre::Vector3 position)
     n->setVisible(true);
 }
 
-void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
+static std::shared_ptr<TObjFile> ParseTObj(Ogre::DataStreamPtr stream)
 {
-    std::shared_ptr<TObjFile> tobj;
-    try
+    TObjParser parser;
+    parser.Prepare();
+    parser.ProcessOgreStream(stream.get());
+    return parser.Finalize();
+}
+
+static std::shared_ptr<ODefFile> ParseODef(Ogre::DataStreamPtr stream)
+{
+    ODefParser parser;
+    parser.Prepare();
+    parser.ProcessOgreStream(stream.get());
+    return parser.Finalize();
+}
+
+void TerrainObjectManager::PreloadTObjFiles(std::list<std::string> const& tobj_files)
+{
+    // Files are read on the main thread (OGRE resource system), parsed on workers from memory.
+    // Workers also compute the object placements and collision boxes, `LoadTObjFile()` only commits them.
+    // Anything which fails here is simply left for `LoadTObjFile()`/`FetchODef()` to retry and report.
+
+    std::vector<std::string> tobj_names;
+    std::vector<DataStreamPtr> tobj_streams;
+    for (std::string const& tobj_name : tobj_files)
     {
-        DataStreamPtr stream_ptr = ResourceGroupManager::getSingleton().openResource(
-            tobj_name, Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
-        TObjParser parser;
-        parser.Prepare();
-        parser.ProcessOgreStream(stream_ptr.get());
-        tobj = parser.Finalize();
+        try
+        {
+            DataStreamPtr stream_ptr = ResourceGroupManager::getSingleton().openResource(
+                tobj_name, Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+            tobj_streams.push_back(DataStreamPtr(OGRE_NEW MemoryDataStream(stream_ptr)));
+            tobj_names.push_back(tobj_name);
+        }
+        catch (...)
+        {
+        }
     }
-    catch (Ogre::Exception& e)
+
+    std::vector<std::shared_ptr<TObjFile>> tobjs(tobj_streams.size());
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i < tobj_streams.size(); i++)
     {
-        LOG("[RoR|Terrain] Error reading TObj file: " + tobj_name + "\nMessage" + e.getFullDescription());
-        return;
+        tasks.push_back([&tobjs, &tobj_streams, i]()
+            {
+                try { tobjs[i] = ParseTObj(tobj_streams[i]); }
+                catch (...) {}
+            });
     }
-    catch (std::exception& e)
+    App::GetThreadPool()->Parallelize(tasks);
+
+    // Collect ODefs referenced by the objects
+    std::vector<std::string> odef_names;
+    std::vector<DataStreamPtr> odef_streams;
+    std::unordered_set<std::string> odef_names_seen;
+    for (size_t i = 0; i < tobjs.size(); i++)
     {
-        LOG("[RoR|Terrain] Error reading TObj file: " + tobj_name + "\nMessage" + e.what());
-        return;
+        if (!tobjs[i])
+            continue;
+
+        m_tobj_cache[tobj_names[i]] = tobjs[i];
+        m_num_objects_total += tobjs[i]->objects.size();
+        for (TObjEntry const& entry : tobjs[i]->objects)
+        {
+            const std::string odef_name = entry.odef_name;
+            if (m_odef_cache.find(odef_name) != m_odef_cache.end() ||
+                !odef_names_seen.insert(odef_name).second)
+            {
+                continue;
+            }
+
+            try
+            {
+                const std::string filename = odef_name + ".odef";
+                const std::string group_name = ResourceGroupManager::getSingleton().findGroupContainingResource(filename);
+                DataStreamPtr stream_ptr = ResourceGroupManager::getSingleton().openResource(filename, group_name);
+                odef_streams.push_back(DataStreamPtr(OGRE_NEW MemoryDataStream(stream_ptr)));
+                odef_names.push_back(odef_name);
+            }
+            catch (...) // Not found
+            {
+            }
+        }
+    }
+
+    // Parse ODefs - few tasks with many files each, most files are tiny.
+    std::vector<std::shared_ptr<ODefFile>> odefs(odef_streams.size());
+    const size_t num_tasks = std::min(odef_streams.size(), static_cast<size_t>(App::app_num_workers->GetInt() + 1));
+    tasks.clear();
+    for (size_t t = 0; t < num_tasks; t++)
+    {
+        tasks.push_back([&odefs, &odef_streams, t, num_tasks]()
+            {
+                for (size_t i = t; i < odef_streams.size(); i += num_tasks)
+                {
+                    try { odefs[i] = ParseODef(odef_streams[i]); }
+                    catch (...) {}
+                }
+            });
+    }
+    App::GetThreadPool()->Parallelize(tasks);
+
+    for (size_t i = 0; i < odefs.size(); i++)
+    {
+        if (odefs[i])
+            m_odef_cache.insert(std::make_pair(odef_names[i], odefs[i]));
+    }
+
+    // Prepare object placements - the ODef cache is only read from here on.
+    struct PrepareJob
+    {
+        ODefFile* odef;
+        TObjEntry const* entry;
+        std::shared_ptr<PreparedObject>* out;
+    };
+    std::vector<PrepareJob> prepare_jobs;
+    for (size_t i = 0; i < tobjs.size(); i++)
+    {
+        if (!tobjs[i])
+            continue;
+
+        std::vector<std::shared_ptr<PreparedObject>>& prepared = m_tobj_prepared[tobj_names[i]];
+        prepared.clear();
+        prepared.resize(tobjs[i]->objects.size());
+        for (size_t j = 0; j < prepared.size(); j++)
+        {
+            TObjEntry const& entry = tobjs[i]->objects[j];
+            auto odef_itor = m_odef_cache.find(entry.odef_name);
+            if (odef_itor == m_odef_cache.end() || strcmp(entry.type, "grid") == 0)
+                continue; // Left for `LoadTerrainObject()` to handle
+
+            prepared[j] = std::make_shared<PreparedObject>();
+            prepare_jobs.push_back({odef_itor->second.get(), &entry, &prepared[j]});
+        }
+    }
+
+    const size_t num_prepare_tasks = std::min(prepare_jobs.size(), static_cast<size_t>(App::app_num_workers->GetInt() + 1));
+    tasks.clear();
+    for (size_t t = 0; t < num_prepare_tasks; t++)
+    {
+        tasks.push_back([&prepare_jobs, t, num_prepare_tasks]()
+            {
+                for (size_t i = t; i < prepare_jobs.size(); i += num_prepare_tasks)
+                {
+                    PrepareTerrainObject(prepare_jobs[i].odef, *prepare_jobs[i].entry, **prepare_jobs[i].out);
+                }
+            });
+    }
+    App::GetThreadPool()->Parallelize(tasks);
+
+    LogFormat("[RoR|Terrain] Preloaded %d TObj files, %d ODef files and %d object placements",
+        static_cast<int>(m_tobj_cache.size()), static_cast<int>(odefs.size()), static_cast<int>(prepare_jobs.size()));
+}
+
+void TerrainObjectManager::PrepareTerrainObject(ODefFile* odef, TObjEntry const& entry, PreparedObject& out)
+{
+    const Vector3 rot = entry.rotation;
+    out.rotation = Quaternion(Degree(rot.x), Vector3::UNIT_X) * Quaternion(Degree(rot.y), Vector3::UNIT_Y) * Quaternion(Degree(rot.z), Vector3::UNIT_Z);
+
+    out.coll_boxes.resize(odef->collision_boxes.size());
+    out.coll_box_directions.resize(odef->collision_boxes.size());
+    for (size_t i = 0; i < odef->collision_boxes.size(); i++)
+    {
+        ODefCollisionBox const& cbox = odef->collision_boxes[i];
+        Collisions::buildCollisionBox(
+            cbox.is_rotating, cbox.is_virtual, entry.position, entry.rotation,
+            cbox.aabb_min, cbox.aabb_max, cbox.box_rot, cbox.force_cam_pos, cbox.cam_pos,
+            cbox.scale, cbox.event_filter, out.coll_boxes[i]);
+        const Vector3 dr = cbox.direction;
+        out.coll_box_directions[i] = Quaternion(Degree(dr.x), Vector3::UNIT_X) * Quaternion(Degree(dr.y), Vector3::UNIT_Y) * Quaternion(Degree(dr.z), Vector3::UNIT_Z);
+    }
+}
+
+void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
+{
+    std::shared_ptr<TObjFile> tobj;
+    std::vector<std::shared_ptr<PreparedObject>> prepared;
+    auto preloaded = m_tobj_cache.find(tobj_name);
+    if (preloaded != m_tobj_cache.end())
+    {
+        tobj = preloaded->second;
+        m_tobj_cache.erase(preloaded);
+
+        auto prepared_itor = m_tobj_prepared.find(tobj_name);
+        if (prepared_itor != m_tobj_prepared.end())
+        {
+            prepared = std::move(prepared_itor->second);
+            m_tobj_prepared.erase(prepared_itor);
+        }
+    }
+    else
+    {
+        try
+        {
+            DataStreamPtr stream_ptr = ResourceGroupManager::getSingleton().openResource(
+                tobj_name, Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+            tobj = ParseTObj(stream_ptr);
+        }
+        catch (Ogre::Exception& e)
+        {
+            LOG("[RoR|Terrain] Error reading TObj file: " + tobj_name + "\nMessage" + e.getFullDescription());
+            return;
+        }
+        catch (std::exception& e)
+        {
+            LOG("[RoR|Terrain] Error reading TObj file: " + tobj_name + "\nMessage" + e.what());
+            return;
+        }
     }
 
     if (m_procedural_mgr == nullptr)
@@ -218,10 +425,7 @@ void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
     }
 
     // Procedural roads
-    for (ProceduralObject po : tobj->proc_objects)
-    {
-        m_procedural_mgr->addObject(po);
-    }
+    m_procedural_mgr->addObjects(tobj->proc_objects);
 
     // Vehicles
     for (TObjVehicle veh : tobj->vehicles)
@@ -250,10 +454,32 @@ void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
         m_predefined_actors.push_back(p);
     }
 
-    // Entries
-    for (TObjEntry entry : tobj->objects)
+    // Entries - scene graph work, must stay on main thread
+    const bool paging = App::sim_object_paging->GetBool();
+    for (size_t i = 0; i < tobj->objects.size(); i++)
     {
-        this->LoadTerrainObject(entry.odef_name, entry.position, entry.rotation, m_staticgeometry_bake_node, entry.instance_name, entry.type);
+        TObjEntry const& entry = tobj->objects[i];
+        std::shared_ptr<PreparedObject> entry_prepared = (i < prepared.size()) ? prepared[i] : nullptr;
+        if (paging && this->IsPageableObject(entry))
+        {
+            // Instantiated on demand by `UpdateObjectPaging()`
+            const int page_x = static_cast<int>(std::floor(entry.position.x / OBJECT_PAGE_SIZE));
+            const int page_z = static_cast<int>(std::floor(entry.position.z / OBJECT_PAGE_SIZE));
+            ObjectPage& page = m_object_pages[std::make_pair(page_x, page_z)];
+            page.center = Vector3((page_x + 0.5f) * OBJECT_PAGE_SIZE, 0.f, (page_z + 0.5f) * OBJECT_PAGE_SIZE);
+            page.entries.push_back({entry.odef_name, entry.position, entry.rotation, entry_prepared});
+        }
+        else
+        {
+            this->LoadTerrainObject(entry.odef_name, entry.position, entry.rotation, m_staticgeometry_bake_node, entry.instance_name, entry.type,
+                /*enable_collisions:*/true, /*scripthandler:*/-1, /*uniquifyMaterial:*/false, entry_prepared.get());
+        }
+
+        if (m_num_objects_total > 0 && (++m_num_objects_loaded % 500) == 0)
+        {
+            App::GetGuiManager()->GetLoadingWindow()->SetProgress(
+                80 + static_cast<int>(9 * m_num_objects_loaded / m_num_objects_total), _L("Loading Terrain Objects"));
+        }
     }
 
     if (App::diag_terrn_log_roads->GetBool())
@@ -467,6 +693,75 @@ void TerrainObjectManager::PostLoadTerrain()
     {
         LOG("error while baking roads. ignoring.");
     }
+
+    // Batch repeated objects, leave the rest as individual entities
+    if (App::gfx_object_batching->GetBool())
+    {
+        std::unordered_map<std::string, int> usage;
+        for (BatchedObject& bobj : m_batched_objects)
+        {
+            usage[bobj.batch_key]++;
+        }
+        for (BatchedObject& bobj : m_batched_objects)
+        {
+            if (usage[bobj.batch_key] >= BATCH_MIN_INSTANCES)
+            {
+                bobj.node->detachObject(bobj.entity);
+                bobj.batched = true;
+            }
+        }
+    }
+    m_batched_objects.erase(std::remove_if(m_batched_objects.begin(), m_batched_objects.end(),
+        [](BatchedObject& bobj) { return !bobj.batched; }), m_batched_objects.end());
+    if (!m_batched_objects.empty())
+    {
+        this->BuildObjectBatches();
+        LOG("[RoR|Terrain] Batched " + TOSTRING(m_batched_objects.size()) + " static objects");
+    }
+
+    // Paged objects around the start position, the rest follows the camera and actors.
+    this->UpdateObjectPaging(/*max_loads=*/static_cast<int>(m_object_pages.size()));
+}
+
+void TerrainObjectManager::BuildObjectBatches()
+{
+    if (m_batch_geometry == nullptr)
+    {
+        m_batch_geometry = App::GetGfxScene()->GetSceneManager()->createStaticGeometry("batchSG");
+        m_batch_geometry->setCastShadows(true);
+        m_batch_geometry->setRegionDimensions(Vector3(terrainManager->getFarClip() / 2.0f, 10000.0, terrainManager->getFarClip() / 2.0f));
+        m_batch_geometry->setRenderingDistance(terrainManager->getFarClip());
+    }
+
+    m_batch_geometry->reset();
+    for (BatchedObject& bobj : m_batched_objects)
+    {
+        if (bobj.batched)
+        {
+            m_batch_geometry->addEntity(bobj.entity, bobj.node->getPosition(), bobj.node->getOrientation(), bobj.node->getScale());
+        }
+    }
+
+    try
+    {
+        m_batch_geometry->build();
+    }
+    catch (Ogre::Exception& e)
+    {
+        LOG("[RoR|Terrain] Error while batching static objects: " + e.getFullDescription());
+    }
+}
+
+void TerrainObjectManager::UnbatchObject(Ogre::SceneNode* node)
+{
+    auto itor = std::find_if(m_batched_objects.begin(), m_batched_objects.end(),
+        [node](BatchedObject& bobj) { return bobj.node == node; });
+    if (itor == m_batched_objects.end() || !itor->batched)
+        return;
+
+    node->attachObject(itor->entity);
+    itor->batched = false;
+    this->BuildObjectBatches();
 }
 
 void TerrainObjectManager::MoveObjectVisuals(const String& instancename, const Ogre::Vector3& pos)
@@ -493,7 +788,7 @@ void TerrainObjectManager::unloadObject(const String& instancename)
         return;
     }
 
-    StaticObject obj = m_static_objects[instancename];
+    StaticObject& obj = m_static_objects[instancename];
 
     if (!obj.enabled)
         return;
@@ -538,17 +833,14 @@ ODefFile* TerrainObjectManager::FetchODef(std::string const & odef_name)
 
     // Load and parse the file
     Ogre::DataStreamPtr ds = ResourceGroupManager::getSingleton().openResource(filename, group_name);
-    ODefParser parser;
-    parser.Prepare();
-    parser.ProcessOgreStream(ds.get());
-    std::shared_ptr<ODefFile> odef = parser.Finalize();
+    std::shared_ptr<ODefFile> odef = ParseODef(ds);
 
     // Add to cache and return
     m_odef_cache.insert(std::make_pair(odef_name, odef));
     return odef.get();
 }
 
-void TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogre::Vector3& pos, const Ogre::Vector3& rot, Ogre::SceneNode* m_staticgeometry_bake_node, const Ogre::String& instancename, const Ogre::String& type, bool enable_collisions /* = true */, int scripthandler /* = -1 */, bool uniquifyMaterial /* = false */)
+void TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogre::Vector3& pos, const Ogre::Vector3& rot, Ogre::SceneNode* m_staticgeometry_bake_node, const Ogre::String& instancename, const Ogre::String& type, bool enable_collisions /* = true */, int scripthandler /* = -1 */, bool uniquifyMaterial /* = false */, const PreparedObject* prepared /* = nullptr */)
 {
     if (type == "grid")
     {
@@ -580,18 +872,21 @@ void TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
         Str<100> ebuf; ebuf << m_entity_counter++ << "-" << odef->header.mesh_name;
         mo = new MeshObject(odef->header.mesh_name, m_resource_group, ebuf.ToCStr(), tenode);
         mo->getEntity()->setCastShadows(odef->header.cast_shadows);
-        m_mesh_objects.push_back(mo);
+        if (m_loading_page == nullptr)
+            m_mesh_objects.push_back(mo);
     }
 
     tenode->setScale(odef->header.scale);
     tenode->setPosition(pos);
-    Quaternion rotation = Quaternion(Degree(rot.x), Vector3::UNIT_X) * Quaternion(Degree(rot.y), Vector3::UNIT_Y) * Quaternion(Degree(rot.z), Vector3::UNIT_Z);
+    Quaternion rotation = (prepared != nullptr) ? prepared->rotation
+        : Quaternion(Degree(rot.x), Vector3::UNIT_X) * Quaternion(Degree(rot.y), Vector3::UNIT_Y) * Quaternion(Degree(rot.z), Vector3::UNIT_Z);
     tenode->rotate(rotation);
     tenode->pitch(Degree(-90));
     tenode->setVisible(true);
 
-    // register in map
-    StaticObject* obj = &m_static_objects[instancename];
+    // register in map; paged objects are tracked by their page instead
+    StaticObject paged_obj;
+    StaticObject* obj = (m_loading_page != nullptr) ? &paged_obj : &m_static_objects[instancename];
     obj->instanceName = instancename;
     obj->enabled = true;
     obj->sceneNode = tenode;
@@ -653,8 +948,9 @@ void TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
         terrainManager->GetCollisions()->loadGroundModelsConfigFile(gmodel_file);
     }
 
-    this->ProcessODefCollisionBoxes(obj, odef, object);
+    this->ProcessODefCollisionBoxes(obj, odef, object, prepared);
 
+    // Collision meshes need the mesh buffers (or the baked cache), so they're added here
     for (ODefCollisionMesh& cmesh : odef->collision_meshes)
     {
         auto gm = terrainManager->GetCollisions()->getGroundModelByString(cmesh.groundmodel_name);
@@ -867,6 +1163,30 @@ void TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
         sn->attachObject(pointlight);
         sn->attachObject(lflare);
     }
+
+    if (m_loading_page != nullptr)
+    {
+        PagedObject pobj;
+        pobj.node = tenode;
+        pobj.mesh_object = mo;
+        pobj.coll_boxes = obj->collBoxes;
+        pobj.coll_tris = obj->collTris;
+        m_loading_page->loaded_objects.push_back(pobj);
+    }
+    else if (mo && m_staticgeometry == nullptr && instancename.empty() && scripthandler == -1 &&
+             odef->header.cast_shadows && odef->animations.empty() && odef->texture_prints.empty())
+    {
+        // Plain object loaded with the terrain - candidate for batching, see `PostLoadTerrain()`
+        BatchedObject bobj;
+        bobj.node = tenode;
+        bobj.entity = mo->getEntity();
+        bobj.batch_key = odef->header.mesh_name;
+        for (unsigned int i = 0; i < bobj.entity->getNumSubEntities(); i++)
+        {
+            bobj.batch_key += "|" + bobj.entity->getSubEntity(i)->getMaterialName();
+        }
+        m_batched_objects.push_back(bobj);
+    }
 }
 
 bool TerrainObjectManager::UpdateAnimatedObjects(float dt)
@@ -916,6 +1236,157 @@ void TerrainObjectManager::LoadPredefinedActors()
     }
 }
 
+bool TerrainObjectManager::IsPageableObject(TObjEntry const& entry)
+{
+    // Anything which registers itself elsewhere (names, map entities, sounds, lights, events...) is loaded up front.
+    if (entry.instance_name[0] != '\0' || entry.type[0] != '\0')
+        return false;
+
+    ODefFile* odef = this->FetchODef(entry.odef_name);
+    if (odef == nullptr)
+        return false; // Let `LoadTerrainObject()` report it
+
+    if (!odef->localizers.empty() || !odef->sounds.empty() || !odef->groundmodel_files.empty() ||
+        !odef->particle_systems.empty() || !odef->animations.empty() || !odef->texture_prints.empty() ||
+        !odef->spotlights.empty() || !odef->point_lights.empty() || !odef->mat_name_generate.empty())
+    {
+        return false;
+    }
+
+    for (ODefCollisionBox const& cbox : odef->collision_boxes)
+    {
+        if (cbox.is_virtual || !cbox.event_name.empty())
+            return false;
+    }
+
+    return true;
+}
+
+void TerrainObjectManager::LoadObjectPage(ObjectPage& page)
+{
+    m_loading_page = &page;
+    for (ObjectPageEntry const& entry : page.entries)
+    {
+        this->LoadTerrainObject(entry.odef_name, entry.position, entry.rotation, m_staticgeometry_bake_node, "", "",
+            /*enable_collisions:*/true, /*scripthandler:*/-1, /*uniquifyMaterial:*/false, entry.prepared.get());
+    }
+    m_loading_page = nullptr;
+
+    page.loaded = true;
+    m_num_loaded_pages++;
+}
+
+void TerrainObjectManager::UnloadObjectPage(ObjectPage& page)
+{
+    std::unordered_set<SceneNode*> nodes;
+    for (PagedObject& pobj : page.loaded_objects)
+    {
+        for (int tri : pobj.coll_tris)
+        {
+            terrainManager->GetCollisions()->removeCollisionTri(tri);
+        }
+        for (int box : pobj.coll_boxes)
+        {
+            terrainManager->GetCollisions()->removeCollisionBox(box);
+        }
+
+        if (pobj.mesh_object != nullptr)
+        {
+            if (pobj.mesh_object->getEntity() != nullptr)
+            {
+                App::GetGfxScene()->GetSceneManager()->destroyEntity(pobj.mesh_object->getEntity());
+            }
+            delete pobj.mesh_object;
+        }
+
+        App::GetGfxScene()->GetSceneManager()->destroySceneNode(pobj.node);
+        nodes.insert(pobj.node);
+    }
+
+    m_editor_objects.erase(std::remove_if(m_editor_objects.begin(), m_editor_objects.end(),
+                [&nodes](EditorObject& e) { return nodes.count(e.node) != 0; }), m_editor_objects.end());
+
+    page.loaded_objects.clear();
+    page.loaded = false;
+    m_num_loaded_pages--;
+}
+
+void TerrainObjectManager::UpdateObjectPaging(int max_loads)
+{
+    if (m_object_pages.empty())
+        return;
+
+    ROR_PROFILE_ZONE("Object paging");
+
+    // Points of interest - camera for visuals, simulated actors for collisions
+    std::vector<Vector3> actor_positions;
+    for (Actor* actor : App::GetGameContext()->GetActorManager()->GetActors())
+    {
+        if (actor->ar_sim_state == Actor::SimState::LOCAL_SIMULATED)
+        {
+            actor_positions.push_back(actor->getPosition());
+        }
+    }
+    const Vector3 camera_pos = App::GetCameraManager()->GetCameraNode()->getPosition();
+
+    const float radius = App::sim_object_page_radius->GetFloat() + OBJECT_PAGE_SIZE * 0.71f; // Measured from page center
+    const float evict_radius = radius + OBJECT_PAGE_SIZE; // Hysteresis
+    const float actor_radius = OBJECT_PAGE_SIZE * 0.71f + 50.f; // Page the actor is in, plus a margin
+
+    // Pages are few (hundreds), simply test them all.
+    int num_loads = 0;
+    std::vector<std::pair<float, ObjectPage*>> evictable; // Distance to camera, page
+    for (auto& page_entry : m_object_pages)
+    {
+        ObjectPage& page = page_entry.second;
+        Vector3 camera_delta = page.center - camera_pos;
+        camera_delta.y = 0.f;
+        const float camera_dist = camera_delta.length();
+
+        bool actor_inside = false;
+        bool actor_near = false;
+        for (Vector3 const& actor_pos : actor_positions)
+        {
+            Vector3 actor_delta = page.center - actor_pos;
+            actor_delta.y = 0.f;
+            const float actor_dist = actor_delta.length();
+            actor_inside = actor_inside || (actor_dist < actor_radius);
+            actor_near = actor_near || (actor_dist < radius);
+        }
+
+        if (!page.loaded)
+        {
+            if (actor_inside) // Load right away, the actor may be colliding with it already.
+            {
+                this->LoadObjectPage(page);
+            }
+            else if ((camera_dist < radius || actor_near) && num_loads < max_loads)
+            {
+                this->LoadObjectPage(page);
+                num_loads++;
+            }
+        }
+        else if (!actor_inside && camera_dist > evict_radius)
+        {
+            evictable.push_back(std::make_pair(camera_dist, &page));
+        }
+    }
+
+    // Evict farthest pages while over budget
+    const int budget = std::max(1, App::sim_object_page_budget->GetInt());
+    if (m_num_loaded_pages > budget && !evictable.empty())
+    {
+        std::sort(evictable.begin(), evictable.end(),
+            [](std::pair<float, ObjectPage*> const& a, std::pair<float, ObjectPage*> const& b) { return a.first > b.first; });
+        for (auto& evict : evictable)
+        {
+            if (m_num_loaded_pages <= budget)
+                break;
+            this->UnloadObjectPage(*evict.second);
+        }
+    }
+}
+
 bool TerrainObjectManager::UpdateTerrainObjects(float dt)
 {
     for (auto geom : m_paged_geometry)
@@ -928,10 +1399,11 @@ bool TerrainObjectManager::UpdateTerrainObjects(float dt)
     return true;
 }
 
-void TerrainObjectManager::ProcessODefCollisionBoxes(StaticObject* obj, ODefFile* odef, const EditorObject& params)
+void TerrainObjectManager::ProcessODefCollisionBoxes(StaticObject* obj, ODefFile* odef, const EditorObject& params, const PreparedObject* prepared)
 {
-    for (ODefCollisionBox& cbox : odef->collision_boxes)
+    for (size_t i = 0; i < odef->collision_boxes.size(); i++)
     {
+        ODefCollisionBox& cbox = odef->collision_boxes[i];
         bool race_event = !params.instance_name.compare(0, 10, "checkpoint") ||
                           !params.instance_name.compare(0,  4, "race");
 
@@ -945,11 +1417,15 @@ void TerrainObjectManager::ProcessODefCollisionBoxes(StaticObject* obj, ODefFile
                 continue;
             }
 
-            int boxnum = terrainManager->GetCollisions()->addCollisionBox(
-                params.node, cbox.is_rotating, cbox.is_virtual, params.position, params.rotation,
-                cbox.aabb_min, cbox.aabb_max, cbox.box_rot, cbox.event_name,
-                params.instance_name, cbox.force_cam_pos, cbox.cam_pos,
-                cbox.scale, cbox.direction, cbox.event_filter, params.script_handler);
+            int boxnum = (prepared != nullptr)
+                ? terrainManager->GetCollisions()->registerCollisionBox(
+                    prepared->coll_boxes[i], prepared->coll_box_directions[i], params.node,
+                    cbox.event_name, params.instance_name, params.script_handler)
+                : terrainManager->GetCollisions()->addCollisionBox(
+                    params.node, cbox.is_rotating, cbox.is_virtual, params.position, params.rotation,
+                    cbox.aabb_min, cbox.aabb_max, cbox.box_rot, cbox.event_name,
+                    params.instance_name, cbox.force_cam_pos, cbox.cam_pos,
+                    cbox.scale, cbox.direction, cbox.event_filter, params.script_handler);
 
             obj->collBoxes.push_back(boxnum);
 
@@ -24,6 +24,8 @@
 #include "Application.h"
 
 #include "ODefFileFormat.h"
+#include "SimData.h"
+#include "TObjFileFormat.h"
 
 #include "BatchPage.h"
 #include "GrassLoader.h"
@@ -34,6 +36,7 @@
 #include "TreeLoader2D.h"
 #include "TreeLoader3D.h"
 
+#include <list>
 #include <map>
 #include <unordered_map>
 
@@ -66,13 +69,23 @@ public:
         int id;
     };
 
+    /// Placement of a TObj entry, computed on worker threads by `PreloadTObjFiles()`,
+    /// so that `LoadTerrainObject()` only creates the scene node and registers the collisions.
+    struct PreparedObject
+    {
+        Ogre::Quaternion rotation;                        //!< From the TObj euler angles
+        std::vector<collision_box_t> coll_boxes;          //!< Parallel to `ODefFile::collision_boxes`
+        std::vector<Ogre::Quaternion> coll_box_directions;
+    };
+
     TerrainObjectManager(TerrainManager* terrainManager);
     ~TerrainObjectManager();
 
     std::vector<EditorObject>& GetEditorObjects() { return m_editor_objects; }
     std::vector<MapEntity>& GetMapEntities() { return m_map_entities; }
+    void           PreloadTObjFiles(std::list<std::string> const& tobj_files); //!< Parses TObj files and their ODefs on worker threads.
     void           LoadTObjFile(Ogre::String filename);
-    void           LoadTerrainObject(const Ogre::String& name, const Ogre::Vector3& pos, const Ogre::Vector3& rot, Ogre::SceneNode* m_staticgeometry_bake_node, const Ogre::String& instancename, const Ogre::String& type, bool enable_collisions = true, int scripthandler = -1, bool uniquifyMaterial = false);
+    void           LoadTerrainObject(const Ogre::String& name, const Ogre::Vector3& pos, const Ogre::Vector3& rot, Ogre::SceneNode* m_staticgeometry_bake_node, const Ogre::String& instancename, const Ogre::String& type, bool enable_collisions = true, int scripthandler = -1, bool uniquifyMaterial = false, const PreparedObject* prepared = nullptr);
     void           MoveObjectVisuals(const Ogre::String& instancename, const Ogre::Vector3& pos);
     void           unloadObject(const Ogre::String& instancename);
     void           LoadTelepoints();
@@ -80,6 +93,8 @@ public:
     bool           HasPredefinedActors() { return !m_predefined_actors.empty(); };
     void           PostLoadTerrain();
     bool           UpdateTerrainObjects(float dt);
+    void           UpdateObjectPaging(int max_loads = MAX_PAGE_LOADS_PER_FRAME); //!< Modifies collisions - call while physics is halted.
+    void           UnbatchObject(Ogre::SceneNode* node); //!< Restores the individual entity of a batched object, i.e. for the terrain editor.
 
     void ProcessTree(
         float yawfrom, float yawto,
@@ -143,10 +158,67 @@ protected:
         std::vector<int> collTris;
     };
 
+    /// Object paging (cvar 'sim_object_paging')
+    /// Plain static objects from TObj files (mesh and collisions only, no name/type/sounds/lights/particles/events)
+    /// are sorted into square pages and only instantiated within 'sim_object_page_radius' of the camera or a simulated actor.
+    /// Pages out of range stay loaded until more than 'sim_object_page_budget' pages are loaded; pages with an actor inside are never evicted.
+    struct PagedObject
+    {
+        Ogre::SceneNode* node = nullptr;
+        MeshObject* mesh_object = nullptr; //!< Owned by the page, not listed in `m_mesh_objects`
+        std::vector<int> coll_boxes;
+        std::vector<int> coll_tris;
+    };
+
+    struct ObjectPageEntry
+    {
+        std::string odef_name;
+        Ogre::Vector3 position;
+        Ogre::Vector3 rotation;
+        std::shared_ptr<PreparedObject> prepared; //!< Null if not preloaded
+    };
+
+    struct ObjectPage
+    {
+        Ogre::Vector3 center = Ogre::Vector3::ZERO; //!< Y is unused
+        std::vector<ObjectPageEntry> entries;
+        std::vector<PagedObject> loaded_objects;
+        bool loaded = false;
+    };
+
+    static const int OBJECT_PAGE_SIZE = 250; //!< Meters
+    static const int MAX_PAGE_LOADS_PER_FRAME = 1; //!< Pages with an actor inside are loaded regardless.
+
+    /// Object batching (cvar 'gfx_object_batching')
+    /// Unnamed TObj objects whose mesh+material is placed at least BATCH_MIN_INSTANCES times are merged into
+    /// the regions of a static geometry by `PostLoadTerrain()`, cutting one draw call per object.
+    /// The entities are kept (detached) so the batch can be rebuilt when the terrain editor picks one of the objects.
+    struct BatchedObject
+    {
+        Ogre::SceneNode* node = nullptr;
+        Ogre::Entity* entity = nullptr;
+        std::string batch_key; //!< Mesh name + material names
+        bool batched = false;
+    };
+
+    static const int BATCH_MIN_INSTANCES = 10;
+
     // ODef processing functions
 
     RoR::ODefFile* FetchODef(std::string const & odef_name);
-    void           ProcessODefCollisionBoxes(StaticObject* obj, ODefFile* odef, const EditorObject& params);
+
+    void           ProcessODefCollisionBoxes(StaticObject* obj, ODefFile* odef, const EditorObject& params, const PreparedObject* prepared);
+    static void    PrepareTerrainObject(ODefFile* odef, TObjEntry const& entry, PreparedObject& out); //!< Thread-safe
+
+    // Object paging functions
+
+    bool           IsPageableObject(TObjEntry const& entry);
+    void           LoadObjectPage(ObjectPage& page);
+    void           UnloadObjectPage(ObjectPage& page);
+
+    // Object batching functions
+
+    void           BuildObjectBatches();
 
     // Misc functions
 
@@ -156,14 +228,23 @@ protected:
 
     std::vector<localizer_t> localizers;
     std::unordered_map<std::string, std::shared_ptr<RoR::ODefFile>> m_odef_cache;
+    std::unordered_map<std::string, std::shared_ptr<TObjFile>> m_tobj_cache; //!< Filled by `PreloadTObjFiles()`, consumed by `LoadTObjFile()`
+    std::unordered_map<std::string, std::vector<std::shared_ptr<PreparedObject>>> m_tobj_prepared; //!< Parallel to `TObjFile::objects`, filled by `PreloadTObjFiles()`
+    size_t                                m_num_objects_total = 0;  //!< Loading progress, see `PreloadTObjFiles()`
+    size_t                                m_num_objects_loaded = 0;
     std::map<std::string, StaticObject>   m_static_objects;
     std::vector<EditorObject>             m_editor_objects;
     std::vector<PredefinedActor>          m_predefined_actors;
     std::vector<AnimatedObject>           m_animated_objects;
     std::vector<MeshObject*>              m_mesh_objects;
     std::vector<MapEntity>                m_map_entities;
+    std::map<std::pair<int, int>, ObjectPage> m_object_pages; //!< Key = page X, Z
+    ObjectPage*                           m_loading_page = nullptr; //!< Set while `LoadObjectPage()` runs, see `LoadTerrainObject()`
+    int                                   m_num_loaded_pages = 0;
+    std::vector<BatchedObject>            m_batched_objects; //!< Batch candidates until `PostLoadTerrain()`, batched objects afterwards
     TerrainManager*           terrainManager;
     Ogre::StaticGeometry*     m_staticgeometry;
+    Ogre::StaticGeometry*     m_batch_geometry = nullptr;
     ProceduralManager*        m_procedural_mgr;
     Ogre::SceneNode*          m_staticgeometry_bake_node;
     int                       m_entity_counter = 0;
@@ -66,6 +66,14 @@ class Task
         m_finish_cv.wait(lock, [this]{ return m_is_finished; });
     }
 
+    /// Check whether the task has finished, without blocking.
+    bool is_finished() const
+    {
+        // task_mutex is locked while the task is running, see join()
+        std::unique_lock<std::mutex> lock(m_task_mutex, std::try_to_lock);
+        return lock.owns_lock() && m_is_finished;
+    }
+
     private:
     // Only constructable by friend class ThreadPool
     Task(std::function<void()> task_func) : m_task_func(task_func) {}
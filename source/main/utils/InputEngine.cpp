@@ -26,6 +26,8 @@
 #include "GUIManager.h"
 #include "Language.h"
 
+#include <algorithm>
+
 using namespace RoR;
 
 const char* mOISDeviceType[6] = {"Unknown Device", "Keyboard", "Mouse", "JoyStick", "Tablet", "Other Device"};
@@ -405,10 +407,16 @@ InputEngine::InputEngine() :
     , mMouse(0)
     , mappingLoaded(false)
     , uniqueCounter(0)
+    , events_dirty(false)
 {
     for (int i = 0; i < MAX_JOYSTICKS; i++)
         mJoy[i] = 0;
 
+    std::fill(keyState, keyState + NUM_KEYS, false);
+    std::fill(key_times, key_times + NUM_KEYS, 0.f);
+    std::fill(event_times, event_times + EV_MODE_LAST, 0.f);
+    std::fill(event_values, event_values + EV_MODE_LAST, 0.f);
+
     LOG("*** Loading OIS ***");
 
     initAllKeys();
@@ -649,6 +657,8 @@ void InputEngine::Capture()
             mJoy[i]->capture();
         }
     }
+
+    this->resolveEvents();
 }
 
 void InputEngine::windowResized(Ogre::RenderWindow* rw)
@@ -694,12 +704,14 @@ void InputEngine::ProcessJoystickEvent(const OIS::JoyStickEvent& arg)
 /* --- Key Events ------------------------------------------ */
 void InputEngine::ProcessKeyPress(const OIS::KeyEvent& arg)
 {
-    keyState[arg.key] = 1;
+    if (arg.key < NUM_KEYS)
+        keyState[arg.key] = true;
 }
 
 void InputEngine::ProcessKeyRelease(const OIS::KeyEvent& arg)
 {
-    keyState[arg.key] = 0;
+    if (arg.key < NUM_KEYS)
+        keyState[arg.key] = false;
 }
 
 /* --- Mouse Events ------------------------------------------ */
@@ -711,9 +723,18 @@ void InputEngine::ProcessMouseEvent(const OIS::MouseEvent& arg)
 /* --- Custom Methods ------------------------------------------ */
 void InputEngine::resetKeys()
 {
-    for (std::map<int, bool>::iterator iter = keyState.begin(); iter != keyState.end(); ++iter)
+    std::fill(keyState, keyState + NUM_KEYS, false);
+    this->resolveEvents();
+}
+
+void InputEngine::resolveEvents()
+{
+    events_dirty = false;
+    std::fill(event_values, event_values + EV_MODE_LAST, 0.f);
+    for (auto& entry: events)
     {
-        iter->second = false;
+        if (entry.first >= 0 && entry.first < EV_MODE_LAST)
+            event_values[entry.first] = this->resolveEventValue(entry.second, /*pure:*/false, ET_ANY);
     }
 }
 
@@ -724,6 +745,8 @@ bool InputEngine::getEventBoolValue(int eventID)
 
 bool InputEngine::getEventBoolValueBounce(int eventID, float time)
 {
+    if (eventID < 0 || eventID >= EV_MODE_LAST)
+        return false;
     if (event_times[eventID] > 0)
         return false;
     else
@@ -737,17 +760,22 @@ bool InputEngine::getEventBoolValueBounce(int eventID, float time)
 
 float InputEngine::getEventBounceTime(int eventID)
 {
+    if (eventID < 0 || eventID >= EV_MODE_LAST)
+        return 0.f;
     return event_times[eventID];
 }
 
 void InputEngine::updateKeyBounces(float dt)
 {
-    for (std::map<int, float>::iterator it = event_times.begin(); it != event_times.end(); it++)
+    for (int i = 0; i < EV_MODE_LAST; i++)
     {
-        if (it->second > 0)
-            it->second -= dt;
-        //else
-        // erase element?
+        if (event_times[i] > 0)
+            event_times[i] -= dt;
+    }
+    for (int i = 0; i < NUM_KEYS; i++)
+    {
+        if (key_times[i] > 0)
+            key_times[i] -= dt;
     }
 }
 
@@ -799,9 +827,9 @@ void InputEngine::smoothValue(float& ref, float value, float rate)
 
 String InputEngine::getEventCommand(int eventID)
 {
-    std::vector<event_trigger_t> t_vec = events[eventID];
-    if (t_vec.size() > 0)
-        return String(t_vec[0].configline);
+    auto found = events.find(eventID);
+    if (found != events.end() && found->second.size() > 0)
+        return String(found->second[0].configline);
     return "";
 }
 
@@ -814,7 +842,10 @@ event_trigger_t* InputEngine::getEventBySUID(int suid)
         for (b = a->second.begin(); b != a->second.end(); b++)
         {
             if (b->suid == suid)
+            {
+                events_dirty = true; // Caller may modify it
                 return &(*b);
+            }
         }
     }
     return 0;
@@ -831,6 +862,7 @@ bool InputEngine::deleteEventBySUID(int suid)
             if (b->suid == suid)
             {
                 a->second.erase(b);
+                events_dirty = true;
                 return true;
             }
         }
@@ -840,10 +872,10 @@ bool InputEngine::deleteEventBySUID(int suid)
 
 bool InputEngine::isEventDefined(int eventID)
 {
-    std::vector<event_trigger_t> t_vec = events[eventID];
-    if (t_vec.size() > 0)
+    auto found = events.find(eventID);
+    if (found != events.end() && found->second.size() > 0)
     {
-        if (t_vec[0].eventtype != ET_NONE)
+        if (found->second[0].eventtype != ET_NONE)
             return true;
     }
     return false;
@@ -851,10 +883,11 @@ bool InputEngine::isEventDefined(int eventID)
 
 int InputEngine::getKeboardKeyForCommand(int eventID)
 {
-    std::vector<event_trigger_t> t_vec = events[eventID];
-    for (std::vector<event_trigger_t>::iterator i = t_vec.begin(); i != t_vec.end(); i++)
+    auto found = events.find(eventID);
+    if (found == events.end())
+        return -1;
+    for (event_trigger_t const& t: found->second)
     {
-        event_trigger_t t = *i;
         if (t.eventtype == ET_Keyboard)
             return t.keyCode;
     }
@@ -863,7 +896,10 @@ int InputEngine::getKeboardKeyForCommand(int eventID)
 
 bool InputEngine::isEventAnalog(int eventID)
 {
-    std::vector<event_trigger_t> t_vec = events[eventID];
+    auto found = events.find(eventID);
+    if (found == events.end())
+        return false;
+    std::vector<event_trigger_t> const& t_vec = found->second;
     if (t_vec.size() > 0)
     {
         //loop through all eventtypes, because we want to find a analog device wether it is the first device or not
@@ -907,13 +943,26 @@ bool InputEngine::isEventAnalog(int eventID)
 }
 
 float InputEngine::getEventValue(int eventID, bool pure, int valueSource)
+{
+    if (!pure && valueSource == ET_ANY && eventID >= 0 && eventID < EV_MODE_LAST)
+    {
+        if (events_dirty)
+            this->resolveEvents();
+        return event_values[eventID]; // Resolved by `Capture()`
+    }
+
+    auto found = events.find(eventID);
+    if (found == events.end())
+        return 0.f;
+    return this->resolveEventValue(found->second, pure, valueSource);
+}
+
+float InputEngine::resolveEventValue(std::vector<event_trigger_t> const& triggers, bool pure, int valueSource)
 {
     float returnValue = 0;
-    std::vector<event_trigger_t> t_vec = events[eventID];
     float value = 0;
-    for (std::vector<event_trigger_t>::iterator i = t_vec.begin(); i != t_vec.end(); i++)
+    for (event_trigger_t const& t: triggers)
     {
-        event_trigger_t t = *i;
 
         if (valueSource == 0 || valueSource == 1)
         {
@@ -922,7 +971,7 @@ float InputEngine::getEventValue(int eventID, bool pure, int valueSource)
             case ET_NONE:
                 break;
             case ET_Keyboard:
-                if (!keyState[t.keyCode])
+                if (!isKeyStateDown(t.keyCode))
                     break;
 
                 // only use explicite mapping, if two keys with different modifiers exist, i.e. F1 and SHIFT+F1.
@@ -961,9 +1010,7 @@ float InputEngine::getEventValue(int eventID, bool pure, int valueSource)
                     }
                     if (t.joystickButtonNumber >= (int)mJoy[t.joystickNumber]->getNumberOfComponents(OIS_Button))
                     {
-#ifndef NOOGRE
-                        LOG("*** Joystick has not enough buttons for mapping: need button "+TOSTRING(t.joystickButtonNumber) + ", availabe buttons: "+TOSTRING(mJoy[t.joystickNumber]->getNumberOfComponents(OIS_Button)));
-#endif
+                        this->reportTriggerError(t, "*** Joystick has not enough buttons for mapping: need button "+TOSTRING(t.joystickButtonNumber) + ", availabe buttons: "+TOSTRING(mJoy[t.joystickNumber]->getNumberOfComponents(OIS_Button)));
                         value = 0;
                         continue;
                     }
@@ -979,9 +1026,7 @@ float InputEngine::getEventValue(int eventID, bool pure, int valueSource)
                     }
                     if (t.joystickPovNumber >= (int)mJoy[t.joystickNumber]->getNumberOfComponents(OIS_POV))
                     {
-#ifndef NOOGRE
-                        LOG("*** Joystick has not enough POVs for mapping: need POV "+TOSTRING(t.joystickPovNumber) + ", availabe POVs: "+TOSTRING(mJoy[t.joystickNumber]->getNumberOfComponents(OIS_POV)));
-#endif
+                        this->reportTriggerError(t, "*** Joystick has not enough POVs for mapping: need POV "+TOSTRING(t.joystickPovNumber) + ", availabe POVs: "+TOSTRING(mJoy[t.joystickNumber]->getNumberOfComponents(OIS_POV)));
                         value = 0;
                         continue;
                     }
@@ -1017,9 +1062,7 @@ float InputEngine::getEventValue(int eventID, bool pure, int valueSource)
                     }
                     if (t.joystickAxisNumber >= (int)joyState[t.joystickNumber].mAxes.size())
                     {
-#ifndef NOOGRE
-                        LOG("*** Joystick has not enough axis for mapping: need axe "+TOSTRING(t.joystickAxisNumber) + ", availabe axis: "+TOSTRING(joyState[t.joystickNumber].mAxes.size()));
-#endif
+                        this->reportTriggerError(t, "*** Joystick has not enough axis for mapping: need axe "+TOSTRING(t.joystickAxisNumber) + ", availabe axis: "+TOSTRING(joyState[t.joystickNumber].mAxes.size()));
                         value = 0;
                         continue;
                     }
@@ -1111,6 +1154,17 @@ float InputEngine::getEventValue(int eventID, bool pure, int valueSource)
     return returnValue;
 }
 
+void InputEngine::reportTriggerError(event_trigger_t const& t, std::string const& msg)
+{
+    // Triggers are evaluated every frame, see `resolveEvents()`
+    if (reported_triggers.insert(t.suid).second)
+    {
+#ifndef NOOGRE
+        LOG(msg);
+#endif
+    }
+}
+
 bool InputEngine::isKeyDown(OIS::KeyCode key)
 {
     if (!mKeyboard)
@@ -1120,18 +1174,20 @@ bool InputEngine::isKeyDown(OIS::KeyCode key)
 
 bool InputEngine::isKeyDownEffective(OIS::KeyCode mod)
 {
-    return this->keyState[mod];
+    return this->isKeyStateDown(mod);
 }
 
 bool InputEngine::isKeyDownValueBounce(OIS::KeyCode mod, float time)
 {
-    if (event_times[-mod] > 0)
+    if (mod >= NUM_KEYS)
+        return false;
+    if (key_times[mod] > 0)
         return false;
     else
     {
         bool res = isKeyDown(mod);
         if (res)
-            event_times[-mod] = time;
+            key_times[mod] = time;
         return res;
     }
 }
@@ -1194,6 +1250,7 @@ void InputEngine::addEvent(int eventID, event_trigger_t& t)
         events[eventID].clear();
     }
     events[eventID].push_back(t);
+    events_dirty = true;
 }
 
 void InputEngine::updateEvent(int eventID, const event_trigger_t& t)
@@ -1207,6 +1264,7 @@ void InputEngine::updateEvent(int eventID, const event_trigger_t& t)
         events[eventID].clear();
     }
     events[eventID].push_back(t);
+    events_dirty = true;
 }
 
 bool InputEngine::processLine(char* line, int deviceID)
@@ -1617,19 +1675,18 @@ JoyStickState* InputEngine::getCurrentJoyState(int joystickNumber)
 
 int InputEngine::getCurrentKeyCombo(String* combo)
 {
-    std::map<int, bool>::iterator i;
     int keyCounter = 0;
     int modCounter = 0;
 
     // list all modificators first
-    for (i = keyState.begin(); i != keyState.end(); i++)
+    for (int i = 0; i < NUM_KEYS; i++)
     {
-        if (i->second)
+        if (keyState[i])
         {
-            if (i->first != KC_LSHIFT && i->first != KC_RSHIFT && i->first != KC_LCONTROL && i->first != KC_RCONTROL && i->first != KC_LMENU && i->first != KC_RMENU)
+            if (i != KC_LSHIFT && i != KC_RSHIFT && i != KC_LCONTROL && i != KC_RCONTROL && i != KC_LMENU && i != KC_RMENU)
                 continue;
             modCounter++;
-            String keyName = getKeyNameForKeyCode((OIS::KeyCode)i->first);
+            String keyName = getKeyNameForKeyCode((OIS::KeyCode)i);
             if (*combo == "")
                 *combo = keyName;
             else
@@ -1638,13 +1695,13 @@ int InputEngine::getCurrentKeyCombo(String* combo)
     }
 
     // now list all keys
-    for (i = keyState.begin(); i != keyState.end(); i++)
+    for (int i = 0; i < NUM_KEYS; i++)
     {
-        if (i->second)
+        if (keyState[i])
         {
-            if (i->first == KC_LSHIFT || i->first == KC_RSHIFT || i->first == KC_LCONTROL || i->first == KC_RCONTROL || i->first == KC_LMENU || i->first == KC_RMENU)
+            if (i == KC_LSHIFT || i == KC_RSHIFT || i == KC_LCONTROL || i == KC_RCONTROL || i == KC_LMENU || i == KC_RMENU)
                 continue;
-            String keyName = getKeyNameForKeyCode((OIS::KeyCode)i->first);
+            String keyName = getKeyNameForKeyCode((OIS::KeyCode)i);
             if (*combo == "")
                 *combo = keyName;
             else
@@ -1683,6 +1740,7 @@ String InputEngine::getEventGroup(String eventName)
 bool InputEngine::reloadConfig(std::string outfile)
 {
     events.clear();
+    events_dirty = true;
     loadMapping(outfile);
     return true;
 }
@@ -1788,6 +1846,7 @@ bool InputEngine::loadMapping(String outfile, bool append, int deviceID)
         // clear everything
         resetKeys();
         events.clear();
+        events_dirty = true;
     }
 
     LOG(" * Loading input mapping " + outfile);
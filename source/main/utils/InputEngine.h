@@ -37,6 +37,8 @@
 #include "OISKeyboard.h"
 #include "OISMouse.h"
 
+#include <set>
+
 // config filename
 #define CONFIGFILENAME "input.map"
 #define MAX_JOYSTICKS 10
@@ -472,7 +474,7 @@ public:
     bool isKeyDownEffective(OIS::KeyCode mod); //!< Reads RoR internal buffer
     bool isKeyDownValueBounce(OIS::KeyCode mod, float time = 0.2f);
 
-    std::map<int, std::vector<event_trigger_t>>& getEvents() { return events; };
+    std::map<int, std::vector<event_trigger_t>>& getEvents() { events_dirty = true; return events; }; //!< Caller may modify the bindings
 
     Ogre::String getDeviceName(event_trigger_t evt);
     std::string getEventTypeName(int type);
@@ -510,6 +512,7 @@ public:
     int getKeboardKeyForCommand(int eventID);
 
     void updateKeyBounces(float dt);
+    void resolveEvents(); //!< Evaluates all bound events into `event_values`; done by `Capture()` and after bindings change
     void completeMissingEvents();
     OIS::ForceFeedback* getForceFeedbackDevice() { return mForceFeedback; };
 
@@ -526,14 +529,24 @@ protected:
     OIS::ForceFeedback* mForceFeedback;
     int uniqueCounter;
 
+    static const int NUM_KEYS = 256; //!< Covers all `OIS::KeyCode`s
+
     // this stores the key/button/axis values
-    std::map<int, bool> keyState;
+    bool keyState[NUM_KEYS];
     OIS::JoyStickState joyState[MAX_JOYSTICKS];
     OIS::MouseState mouseState;
 
     // define event aliases
     std::map<int, std::vector<event_trigger_t>> events;
-    std::map<int, float> event_times;
+    float event_times[EV_MODE_LAST];    //!< Bounce timers, indexed by event ID
+    float key_times[NUM_KEYS];          //!< Bounce timers, indexed by key code
+    float event_values[EV_MODE_LAST];   //!< Per-frame snapshot of `getEventValue()` with default args
+    bool events_dirty;                  //!< Bindings changed since `event_values` were resolved
+    std::set<int> reported_triggers;    //!< SUIDs of misconfigured triggers which were already logged
+
+    float resolveEventValue(std::vector<event_trigger_t> const& triggers, bool pure, int valueSource);
+    void reportTriggerError(event_trigger_t const& t, std::string const& msg); //!< Logs once per trigger
+    bool isKeyStateDown(int keyCode) const { return keyCode >= 0 && keyCode < NUM_KEYS && keyState[keyCode]; }
 
     bool processLine(char* line, int deviceID = -1);
 
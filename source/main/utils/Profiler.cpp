@@ -0,0 +1,171 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "Profiler.h"
+
+#include "Application.h"
+#include "PlatformUtils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+using namespace RoR;
+
+std::atomic<bool>            Profiler::s_enabled(false);
+std::mutex                   Profiler::s_threads_mutex;
+std::vector<ProfilerThread*> Profiler::s_threads;
+
+static thread_local ProfilerThread* t_profiler_thread = nullptr;
+
+Profiler::Profiler()
+{
+    Profiler::GetTimestampUs(); // Set the time origin
+}
+
+int64_t Profiler::GetTimestampUs()
+{
+    static const auto origin = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+ProfilerThread* Profiler::GetCurrentThread()
+{
+    if (t_profiler_thread == nullptr)
+    {
+        // Threads live until shutdown (main + thread pools), buffers are intentionally never freed.
+        ProfilerThread* thread = new ProfilerThread();
+        std::lock_guard<std::mutex> lock(s_threads_mutex);
+        thread->pt_index = static_cast<int>(s_threads.size());
+        s_threads.push_back(thread);
+        t_profiler_thread = thread;
+    }
+    return t_profiler_thread;
+}
+
+void Profiler::EndFrame()
+{
+    s_enabled.store(App::diag_profiler->GetBool(), std::memory_order_relaxed);
+    if (!this->IsEnabled())
+    {
+        if (m_capturing)
+            this->StopCapture();
+        m_frame_events.clear();
+        return;
+    }
+
+    m_main_thread = Profiler::GetCurrentThread()->pt_index;
+
+    m_frame_events.clear();
+    {
+        std::lock_guard<std::mutex> lock(s_threads_mutex);
+        for (ProfilerThread* thread: s_threads)
+        {
+            std::lock_guard<std::mutex> thread_lock(thread->pt_mutex);
+            m_frame_events.insert(m_frame_events.end(), thread->pt_events.begin(), thread->pt_events.end());
+            thread->pt_events.clear();
+        }
+    }
+
+    // Zones are recorded when they end, so parents come after children - restore start order.
+    std::sort(m_frame_events.begin(), m_frame_events.end(),
+        [](ProfilerEvent const& a, ProfilerEvent const& b)
+        {
+            return (a.pe_thread != b.pe_thread) ? (a.pe_thread < b.pe_thread) : (a.pe_start_us < b.pe_start_us);
+        });
+
+    if (m_capturing)
+    {
+        m_capture.insert(m_capture.end(), m_frame_events.begin(), m_frame_events.end());
+        if (m_capture.size() >= MAX_CAPTURE_EVENTS)
+        {
+            this->StopCapture();
+        }
+    }
+}
+
+void Profiler::StartCapture()
+{
+    m_capture.clear();
+    m_capturing = true;
+}
+
+void Profiler::StopCapture()
+{
+    if (!m_capturing)
+        return;
+
+    m_capturing = false;
+
+    const std::time_t time = std::time(nullptr);
+    std::stringstream filename;
+    filename << "profile_" << std::put_time(std::localtime(&time), "%Y-%m-%d_%H-%M-%S") << ".json";
+
+    CreateFolder(App::sys_profiler_dir->GetStr());
+    this->WriteCapture(PathCombine(App::sys_profiler_dir->GetStr(), filename.str()));
+    m_capture.clear();
+}
+
+void Profiler::WriteCapture(std::string const& path)
+{
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr)
+    {
+        LogFormat("[RoR|Profiler] Failed to open '%s' for writing", path.c_str());
+        return;
+    }
+
+    fprintf(file, "{\"traceEvents\":[");
+    const char* separator = "\n";
+
+    int num_threads = 0;
+    {
+        std::lock_guard<std::mutex> lock(s_threads_mutex);
+        num_threads = static_cast<int>(s_threads.size());
+    }
+    for (int i = 0; i < num_threads; i++)
+    {
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s %d\"}}",
+            separator, i, (i == m_main_thread) ? "Main" : "Worker", i);
+        separator = ",\n";
+    }
+
+    for (ProfilerEvent const& ev: m_capture)
+    {
+        fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%lld,\"dur\":%lld",
+            separator, ev.pe_name, ev.pe_thread, static_cast<long long>(ev.pe_start_us), static_cast<long long>(ev.pe_duration_us));
+        if (ev.pe_id != -1)
+        {
+            fprintf(file, ",\"args\":{\"id\":%d}", ev.pe_id);
+        }
+        fprintf(file, "}");
+        separator = ",\n";
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+
+    LogFormat("[RoR|Profiler] Saved %d events to '%s'", static_cast<int>(m_capture.size()), path.c_str());
+    m_last_capture_path = path;
+}
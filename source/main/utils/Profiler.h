@@ -0,0 +1,137 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Lightweight scoped-zone profiler; see `ROR_PROFILE_ZONE()`.
+///         Enable with cvar 'diag_profiler', view in 'Tools/Profiler', captures are saved to 'sys_profiler_dir'.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+struct ProfilerEvent
+{
+    const char* pe_name;      //!< Must be a string literal - only the pointer is stored.
+    int         pe_id;        //!< Optional numeric argument (i.e. actor instance ID), -1 if none.
+    int         pe_thread;    //!< Profiler thread index.
+    int         pe_depth;     //!< Nesting level within the thread.
+    int64_t     pe_start_us;  //!< Microseconds since profiler creation.
+    int64_t     pe_duration_us;
+};
+
+/// Per-thread event buffer, created on first zone recorded by the thread.
+struct ProfilerThread
+{
+    std::mutex                 pt_mutex; //!< Only contended when the main thread collects events.
+    std::vector<ProfilerEvent> pt_events;
+    int                        pt_index = 0;
+    int                        pt_depth = 0;
+};
+
+class Profiler
+{
+public:
+    static const size_t MAX_THREAD_EVENTS = 100000;   //!< Events kept per thread between `EndFrame()` calls.
+    static const size_t MAX_CAPTURE_EVENTS = 2000000; //!< Capture stops and saves automatically.
+
+    Profiler();
+
+    static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+    static int64_t GetTimestampUs();
+    static ProfilerThread* GetCurrentThread(); //!< Registers the calling thread on first use.
+
+    /// Call once per frame from the main thread; collects the events of all threads.
+    void EndFrame();
+
+    void StartCapture();
+    void StopCapture(); //!< Writes the capture as Chrome trace JSON (chrome://tracing) to 'sys_profiler_dir'.
+    bool IsCapturing() const { return m_capturing; }
+    size_t GetNumCapturedEvents() const { return m_capture.size(); }
+    std::string const& GetLastCapturePath() const { return m_last_capture_path; }
+
+    std::vector<ProfilerEvent> const& GetFrameEvents() const { return m_frame_events; }
+    int GetMainThreadIndex() const { return m_main_thread; }
+
+private:
+    void WriteCapture(std::string const& path);
+
+    static std::atomic<bool>       s_enabled;
+    static std::mutex              s_threads_mutex;
+    static std::vector<ProfilerThread*> s_threads;
+
+    std::vector<ProfilerEvent>     m_frame_events; //!< Collected by last `EndFrame()`, sorted by thread and start.
+    std::vector<ProfilerEvent>     m_capture;
+    bool                           m_capturing = false;
+    int                            m_main_thread = 0;
+    std::string                    m_last_capture_path;
+};
+
+/// Records the lifetime of itself as one profiler event, if the profiler is enabled.
+class ProfilerZone
+{
+public:
+    ProfilerZone(const char* name, int id = -1)
+    {
+        if (Profiler::IsEnabled())
+        {
+            m_thread = Profiler::GetCurrentThread();
+            m_event.pe_name = name;
+            m_event.pe_id = id;
+            m_event.pe_thread = m_thread->pt_index;
+            m_event.pe_depth = m_thread->pt_depth++;
+            m_event.pe_start_us = Profiler::GetTimestampUs();
+        }
+    }
+
+    ~ProfilerZone()
+    {
+        if (m_thread)
+        {
+            m_event.pe_duration_us = Profiler::GetTimestampUs() - m_event.pe_start_us;
+            m_thread->pt_depth--;
+            std::lock_guard<std::mutex> lock(m_thread->pt_mutex);
+            if (m_thread->pt_events.size() < Profiler::MAX_THREAD_EVENTS)
+            {
+                m_thread->pt_events.push_back(m_event);
+            }
+        }
+    }
+
+private:
+    ProfilerThread* m_thread = nullptr;
+    ProfilerEvent   m_event;
+};
+
+} // namespace RoR
+
+#define ROR_PROFILE_CONCAT_(_A_, _B_)      _A_##_B_
+#define ROR_PROFILE_CONCAT(_A_, _B_)       ROR_PROFILE_CONCAT_(_A_, _B_)
+
+/// Times the enclosing scope. Name must be a string literal.
+#define ROR_PROFILE_ZONE(_NAME_)           RoR::ProfilerZone ROR_PROFILE_CONCAT(ror_profiler_zone_, __LINE__)(_NAME_)
+/// Times the enclosing scope, with a numeric argument (i.e. actor instance ID) to tell instances apart.
+#define ROR_PROFILE_ZONE_ID(_NAME_, _ID_)  RoR::ProfilerZone ROR_PROFILE_CONCAT(ror_profiler_zone_, __LINE__)(_NAME_, _ID_)
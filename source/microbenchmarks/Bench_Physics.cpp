@@ -0,0 +1,478 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief  Physics micro-benchmarks, built with the game sources as 'RoR_Microbenchmarks' (cmake -DBUILD_MICROBENCHMARKS=ON).
+///         All fixtures are synthetic and generated from a fixed seed, so results are comparable between commits.
+///         Usage: RoR_Microbenchmarks [benchmark flags] [truckfile...] - extra arguments are benchmarked with the parser.
+
+#include "Actor.h"
+#include "ActorManager.h"
+#include "Application.h"
+#include "Collisions.h"
+#include "Console.h"
+#include "FlexBody.h"
+#include "GfxActor.h"
+#include "Locator_t.h"
+#include "PointColDetector.h"
+#include "RigDef_File.h"
+#include "RigDef_Parser.h"
+#include "SimConstants.h"
+#include "SimData.h"
+#include "TerrainManager.h"
+#include "ThreadPool.h"
+
+#include <benchmark/benchmark.h>
+#include <Ogre.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+
+using namespace RoR;
+
+static const unsigned int BENCH_SEED = 12345;
+static const float LATTICE_SPACING = 0.5f;
+
+/// Lattice sides for the softbody benchmarks; node indices are 16-bit unsigned (see `node_t::INVALID_IDX`),
+/// so 40 is the maximum (40^3 = 64000 nodes).
+static void LatticeSizes(benchmark::internal::Benchmark* b)
+{
+    b->Arg(4)->Arg(8)->Arg(16)->Arg(24)->Arg(32)->Arg(40);
+}
+
+// --------------------------------------------------------------------------------------------------
+// Fixtures
+// --------------------------------------------------------------------------------------------------
+
+namespace RoR {
+
+/// Synthetic softbody: a cubic lattice of `side^3` nodes with beams to the neighbours along axes and face diagonals (~6 beams per node).
+/// Nodes are slightly displaced from rest and moving, so the beams carry realistic, mostly elastic stress.
+class ActorBenchmark
+{
+public:
+    explicit ActorBenchmark(int side)
+    {
+        std::mt19937 rng(BENCH_SEED);
+        std::uniform_real_distribution<float> jitter(-0.02f, 0.02f);
+        std::uniform_real_distribution<float> velocity(-0.5f, 0.5f);
+
+        const int num_nodes = side * side * side;
+        m_nodes.resize(num_nodes);
+        for (int i = 0; i < num_nodes; i++)
+        {
+            node_t& n = m_nodes[i];
+            n = node_t(i);
+            n.RelPosition = this->GetRestPosition(side, i) + Ogre::Vector3(jitter(rng), jitter(rng), jitter(rng));
+            n.AbsPosition = n.RelPosition;
+            n.Velocity = Ogre::Vector3(velocity(rng), velocity(rng), velocity(rng));
+            n.mass = 10.f;
+            n.nd_contacter = true;
+            n.nd_no_ground_contact = true; // No terrain geometry in the benchmarks
+        }
+
+        const int offsets[6][3] = { {1,0,0}, {0,1,0}, {0,0,1}, {1,1,0}, {0,1,1}, {1,0,1} };
+        for (int x = 0; x < side; x++)
+        {
+            for (int y = 0; y < side; y++)
+            {
+                for (int z = 0; z < side; z++)
+                {
+                    for (auto& off: offsets)
+                    {
+                        if (x + off[0] < side && y + off[1] < side && z + off[2] < side)
+                        {
+                            this->AddBeam(side, this->GetIndex(side, x, y, z), this->GetIndex(side, x + off[0], y + off[1], z + off[2]));
+                        }
+                    }
+                }
+            }
+        }
+
+        // Cab-like triangles over the top face, for collision queries
+        for (int x = 0; x + 1 < side; x++)
+        {
+            for (int z = 0; z + 1 < side; z++)
+            {
+                const int y = side - 1;
+                m_triangles.push_back({ this->GetIndex(side, x, y, z), this->GetIndex(side, x+1, y, z), this->GetIndex(side, x, y, z+1) });
+                m_triangles.push_back({ this->GetIndex(side, x+1, y, z), this->GetIndex(side, x+1, y, z+1), this->GetIndex(side, x, y, z+1) });
+            }
+        }
+
+        // The actor is intentionally leaked - `~Actor()` expects the full game runtime.
+        m_actor = new Actor(0, 0, std::make_shared<RigDef::File>(), ActorSpawnRequest());
+        m_actor->ar_nodes = m_nodes.data();
+        m_actor->ar_num_nodes = num_nodes;
+        m_actor->ar_beams = m_beams.data();
+        m_actor->ar_num_beams = static_cast<int>(m_beams.size());
+        m_actor->ar_num_contacters = num_nodes;
+        m_actor->ar_main_camera_node_pos = -1; // Skip the camera node's script-enabled collision test
+    }
+
+    void CalcBeams() { m_actor->CalcBeams(/*trigger_hooks:*/false); }
+    void CalcNodes() { m_actor->CalcNodes(); }
+
+    Actor* GetActor() { return m_actor; }
+    std::vector<node_t>& GetNodes() { return m_nodes; }
+    std::vector<std::array<int, 3>> const& GetTriangles() const { return m_triangles; }
+
+    static Ogre::Vector3 GetRestPosition(int side, int index)
+    {
+        return Ogre::Vector3(static_cast<float>(index % side),
+                             static_cast<float>((index / side) % side),
+                             static_cast<float>(index / (side * side))) * LATTICE_SPACING;
+    }
+
+private:
+    static int GetIndex(int side, int x, int y, int z) { return x + (y * side) + (z * side * side); }
+
+    void AddBeam(int side, int n1, int n2)
+    {
+        beam_t beam;
+        beam.p1 = &m_nodes[n1];
+        beam.p2 = &m_nodes[n2];
+        beam.k = DEFAULT_SPRING;
+        beam.d = DEFAULT_DAMP;
+        beam.L = GetRestPosition(side, n1).distance(GetRestPosition(side, n2));
+        beam.refL = beam.L;
+        beam.bounded = NOSHOCK;
+        beam.bm_type = BEAM_NORMAL;
+        beam.strength = BEAM_BREAK * 1000.f; // Never break - that would involve sounds and script callbacks
+        beam.maxposstress = BEAM_DEFORM;
+        beam.maxnegstress = -BEAM_DEFORM;
+        beam.minmaxposnegstress = BEAM_DEFORM;
+        beam.initial_beam_strength = beam.strength;
+        beam.default_beam_deform = BEAM_DEFORM;
+        m_beams.push_back(beam);
+    }
+
+    std::vector<node_t>              m_nodes;
+    std::vector<beam_t>              m_beams;
+    std::vector<std::array<int, 3>>  m_triangles;
+    Actor*                           m_actor = nullptr;
+};
+
+} // namespace RoR
+
+/// Hilly terrain mesh of `size*size` quads (2 tris each) with a cloud of nodes hovering just above/below it.
+struct CollisionMeshFixture
+{
+    static const int NUM_NODES = 2000;
+    static const float QUAD_SIZE;
+
+    explicit CollisionMeshFixture(int size)
+    {
+        // Created once - ground models are parsed from the config file.
+        static Collisions* collisions = new Collisions(Ogre::Vector3(4000.f, 500.f, 4000.f));
+
+        // Collisions have no API to remove triangles - keep one instance per size, offset apart.
+        static std::map<int, Ogre::Vector3> origins;
+        auto found = origins.find(size);
+        if (found == origins.end())
+        {
+            const Ogre::Vector3 origin(10.f + 600.f * origins.size(), 0.f, 10.f);
+            found = origins.insert(std::make_pair(size, origin)).first;
+
+            ground_model_t* gm = collisions->getGroundModelByString("concrete");
+            std::mt19937 rng(BENCH_SEED);
+            std::uniform_real_distribution<float> height(0.f, 1.f);
+            std::vector<float> heights((size + 1) * (size + 1));
+            for (float& h: heights)
+                h = height(rng);
+
+            auto vert = [&](int x, int z) { return origin + Ogre::Vector3(x * QUAD_SIZE, heights[x + z * (size + 1)], z * QUAD_SIZE); };
+            for (int x = 0; x < size; x++)
+            {
+                for (int z = 0; z < size; z++)
+                {
+                    collisions->addCollisionTri(vert(x, z), vert(x+1, z), vert(x, z+1), gm);
+                    collisions->addCollisionTri(vert(x+1, z), vert(x+1, z+1), vert(x, z+1), gm);
+                }
+            }
+        }
+
+        m_collisions = collisions;
+        std::mt19937 rng(BENCH_SEED);
+        std::uniform_real_distribution<float> horizontal(0.f, size * QUAD_SIZE);
+        std::uniform_real_distribution<float> vertical(0.f, 1.5f);
+        m_nodes.resize(NUM_NODES);
+        for (int i = 0; i < NUM_NODES; i++)
+        {
+            m_nodes[i] = node_t(i);
+            m_nodes[i].AbsPosition = found->second + Ogre::Vector3(horizontal(rng), vertical(rng), horizontal(rng));
+            m_nodes[i].RelPosition = m_nodes[i].AbsPosition;
+            m_nodes[i].Velocity = Ogre::Vector3(0.f, -1.f, 0.f);
+            m_nodes[i].mass = 10.f;
+        }
+    }
+
+    Collisions*          m_collisions = nullptr;
+    std::vector<node_t>  m_nodes;
+};
+
+const float CollisionMeshFixture::QUAD_SIZE = 2.f;
+
+/// Flexbody deformation kernel input: `num_vertices` locators spread over the cells of a node lattice,
+/// ~16 vertices per ref/nx/ny node triple, like a mesh wrapped around a softbody.
+struct FlexBodyKernelFixture
+{
+    static const int LATTICE_SIDE = 8;
+
+    explicit FlexBodyKernelFixture(int num_vertices)
+    {
+        std::mt19937 rng(BENCH_SEED);
+        std::uniform_real_distribution<float> jitter(-0.02f, 0.02f);
+        std::uniform_real_distribution<float> coord(-1.f, 1.f);
+        std::uniform_int_distribution<int> cell(0, LATTICE_SIDE - 2);
+
+        const int num_nodes = LATTICE_SIDE * LATTICE_SIDE * LATTICE_SIDE;
+        m_nodes.resize(num_nodes);
+        for (int i = 0; i < num_nodes; i++)
+        {
+            m_nodes[i].AbsPosition = ActorBenchmark::GetRestPosition(LATTICE_SIDE, i) + Ogre::Vector3(jitter(rng), jitter(rng), jitter(rng));
+            m_nodes[i].nd_has_contact = false;
+            m_nodes[i].nd_is_wet = false;
+        }
+
+        const int num_triples = std::max(1, num_vertices / 16);
+        std::vector<Locator_t> triples(num_triples);
+        for (Locator_t& t: triples)
+        {
+            const int x = cell(rng), y = cell(rng), z = cell(rng);
+            t.ref = x + (y * LATTICE_SIDE) + (z * LATTICE_SIDE * LATTICE_SIDE);
+            t.nx = t.ref + 1;
+            t.ny = t.ref + LATTICE_SIDE;
+            t.nz = -1;
+        }
+
+        std::uniform_int_distribution<int> pick_triple(0, num_triples - 1);
+        std::vector<Locator_t> locators(num_vertices);
+        std::vector<Ogre::Vector3> normals(num_vertices);
+        for (int i = 0; i < num_vertices; i++)
+        {
+            locators[i] = triples[pick_triple(rng)];
+            locators[i].coords = Ogre::Vector3(coord(rng), coord(rng), coord(rng));
+            normals[i] = Ogre::Vector3(coord(rng), coord(rng), coord(rng)).normalisedCopy();
+        }
+
+        m_kernel.Build(locators.data(), normals.data(), locators.size());
+        m_center = m_nodes[0].AbsPosition;
+    }
+
+    std::vector<GfxActor::SimBuffer::NodeSB>  m_nodes;
+    FlexBody::DeformKernel                     m_kernel;
+    Ogre::Vector3                              m_center;
+};
+
+/// Truckfile with `size*size*size` nodes and lattice beams, in the regular text format.
+static std::string GenerateTruckfile(int side)
+{
+    std::stringstream out;
+    out << "Synthetic benchmark truck\n\nglobals\n10000, 1000, tracks/semi\n\nnodes\n";
+    const int num_nodes = side * side * side;
+    for (int i = 0; i < num_nodes; i++)
+    {
+        const Ogre::Vector3 pos = ActorBenchmark::GetRestPosition(side, i);
+        out << i << ", " << pos.x << ", " << pos.y << ", " << pos.z << "\n";
+    }
+    out << "\nbeams\n";
+    for (int i = 0; i < num_nodes; i++)
+    {
+        if ((i % side) + 1 < side)
+            out << i << ", " << i + 1 << "\n";
+        if (((i / side) % side) + 1 < side)
+            out << i << ", " << i + side << "\n";
+        if (i + side * side < num_nodes)
+            out << i << ", " << i + side * side << ", i\n";
+    }
+    out << "\nend\n";
+    return out.str();
+}
+
+// --------------------------------------------------------------------------------------------------
+// Benchmarks
+// --------------------------------------------------------------------------------------------------
+
+static void BM_Actor_CalcBeams(benchmark::State& state)
+{
+    ActorBenchmark fixture(static_cast<int>(state.range(0)));
+    for (auto _: state)
+    {
+        fixture.CalcBeams();
+    }
+    state.SetItemsProcessed(state.iterations() * fixture.GetActor()->ar_num_beams);
+}
+BENCHMARK(BM_Actor_CalcBeams)->Apply(LatticeSizes);
+
+static void BM_Actor_CalcNodes(benchmark::State& state)
+{
+    const float gravity = App::GetSimTerrain()->getGravity();
+    App::GetSimTerrain()->setGravity(0.f); // Keep the nodes in place, drag keeps velocities bounded
+    ActorBenchmark fixture(static_cast<int>(state.range(0)));
+    for (auto _: state)
+    {
+        fixture.CalcNodes();
+    }
+    state.SetItemsProcessed(state.iterations() * fixture.GetActor()->ar_num_nodes);
+    App::GetSimTerrain()->setGravity(gravity);
+}
+BENCHMARK(BM_Actor_CalcNodes)->Apply(LatticeSizes);
+
+static void BM_PointColDetector_Update(benchmark::State& state)
+{
+    ActorBenchmark fixture(static_cast<int>(state.range(0)));
+    PointColDetector detector(fixture.GetActor());
+    node_t const& probe = fixture.GetNodes()[0];
+    for (auto _: state)
+    {
+        // The BVH is refit (or rebuilt, if it got too loose) by the first query after an update.
+        detector.UpdateIntraPoint();
+        detector.query(probe.AbsPosition, probe.AbsPosition, probe.AbsPosition, DEFAULT_COLLISION_RANGE);
+        benchmark::DoNotOptimize(detector.hit_list.size());
+    }
+    state.SetItemsProcessed(state.iterations() * fixture.GetActor()->ar_num_contacters);
+}
+BENCHMARK(BM_PointColDetector_Update)->Apply(LatticeSizes);
+
+static void BM_PointColDetector_Query(benchmark::State& state)
+{
+    ActorBenchmark fixture(static_cast<int>(state.range(0)));
+    PointColDetector detector(fixture.GetActor());
+    std::vector<node_t>& nodes = fixture.GetNodes();
+    for (auto _: state)
+    {
+        detector.UpdateIntraPoint();
+        for (auto& tri: fixture.GetTriangles())
+        {
+            detector.query(nodes[tri[0]].AbsPosition, nodes[tri[1]].AbsPosition, nodes[tri[2]].AbsPosition, DEFAULT_COLLISION_RANGE);
+            benchmark::DoNotOptimize(detector.hit_list.size());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * fixture.GetTriangles().size());
+}
+BENCHMARK(BM_PointColDetector_Query)->Apply(LatticeSizes);
+
+static void BM_Collisions_NodeCollision(benchmark::State& state)
+{
+    CollisionMeshFixture fixture(static_cast<int>(state.range(0)));
+    std::vector<node_t> nodes = fixture.m_nodes;
+    for (auto _: state)
+    {
+        // Collisions push the nodes out of the mesh - restore them so every iteration does the same work.
+        std::copy(fixture.m_nodes.begin(), fixture.m_nodes.end(), nodes.begin());
+        for (node_t& node: nodes)
+        {
+            benchmark::DoNotOptimize(fixture.m_collisions->nodeCollision(&node, PHYSICS_DT, /*envokeScriptCallbacks:*/false));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * nodes.size());
+}
+BENCHMARK(BM_Collisions_NodeCollision)->RangeMultiplier(4)->Range(4, 256);
+
+static void BM_FlexBody_ComputeKernel(benchmark::State& state)
+{
+    FlexBodyKernelFixture fixture(static_cast<int>(state.range(0)));
+    for (auto _: state)
+    {
+        fixture.m_kernel.Compute(fixture.m_nodes.data(), fixture.m_center);
+        benchmark::DoNotOptimize(fixture.m_kernel.out_pos[0].data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlexBody_ComputeKernel)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
+
+static void ParseTruckfile(benchmark::State& state, std::string const& name, std::string const& text)
+{
+    for (auto _: state)
+    {
+        Ogre::DataStreamPtr stream(OGRE_NEW Ogre::MemoryDataStream(name, (void*)text.data(), text.size(), /*freeOnClose:*/false, /*readOnly:*/true));
+        RigDef::Parser parser;
+        parser.Prepare();
+        parser.ProcessOgreStream(stream.get(), Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+        parser.Finalize();
+        benchmark::DoNotOptimize(parser.GetFile().get());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+static void BM_RigDef_Parser(benchmark::State& state)
+{
+    const std::string text = GenerateTruckfile(static_cast<int>(state.range(0)));
+    ParseTruckfile(state, "synthetic.truck", text);
+}
+BENCHMARK(BM_RigDef_Parser)->Apply(LatticeSizes);
+
+static void BM_ThreadPool_Parallelize(benchmark::State& state)
+{
+    std::atomic<int> counter(0);
+    std::vector<std::function<void()>> tasks(state.range(0), [&counter]() { counter++; });
+    for (auto _: state)
+    {
+        App::GetThreadPool()->Parallelize(tasks);
+    }
+    state.SetItemsProcessed(state.iterations() * tasks.size());
+}
+BENCHMARK(BM_ThreadPool_Parallelize)->RangeMultiplier(4)->Range(1, 256);
+
+// --------------------------------------------------------------------------------------------------
+// Runtime setup
+// --------------------------------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+
+    // Minimal game runtime: logging + resources (OGRE), cvars, worker threads and an empty terrain.
+    new Ogre::Root("", "", "RoR_Microbenchmarks.log");
+    App::GetConsole()->CVarSetupBuiltins();
+    App::sys_config_dir->SetStr(ROR_MICROBENCH_CONFIG_DIR); // Skeleton config, has 'ground_models.cfg'
+    App::CreateThreadPool();
+    App::SetSimTerrain(new TerrainManager());
+
+    // Remaining arguments are truckfiles
+    for (int i = 1; i < argc; i++)
+    {
+        std::ifstream file(argv[i], std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "Cannot open truckfile '" << argv[i] << "'" << std::endl;
+            return 1;
+        }
+        std::stringstream buf;
+        buf << file.rdbuf();
+        const std::string name = argv[i];
+        const std::string text = buf.str();
+        benchmark::RegisterBenchmark(("BM_RigDef_Parser/" + name).c_str(),
+            [name, text](benchmark::State& state) { ParseTruckfile(state, name, text); });
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}